@@ -12,6 +12,9 @@
 #include <vector>
 #include "types.hpp"
 #include "constants.hpp"
+#include "pubkey_map.hpp"
+#include "layout.hpp"
+#include "trace.hpp"
 
 namespace aex402 {
 
@@ -26,36 +29,31 @@ inline uint8_t read_u8(const uint8_t* data, size_t& offset) {
 }
 
 inline uint16_t read_u16(const uint8_t* data, size_t& offset) {
-    uint16_t v;
-    std::memcpy(&v, data + offset, sizeof(v));
+    uint16_t v = load_le<uint16_t>(data + offset);
     offset += 2;
     return v;
 }
 
 inline int16_t read_i16(const uint8_t* data, size_t& offset) {
-    int16_t v;
-    std::memcpy(&v, data + offset, sizeof(v));
+    int16_t v = load_le<int16_t>(data + offset);
     offset += 2;
     return v;
 }
 
 inline uint32_t read_u32(const uint8_t* data, size_t& offset) {
-    uint32_t v;
-    std::memcpy(&v, data + offset, sizeof(v));
+    uint32_t v = load_le<uint32_t>(data + offset);
     offset += 4;
     return v;
 }
 
 inline uint64_t read_u64(const uint8_t* data, size_t& offset) {
-    uint64_t v;
-    std::memcpy(&v, data + offset, sizeof(v));
+    uint64_t v = load_le<uint64_t>(data + offset);
     offset += 8;
     return v;
 }
 
 inline int64_t read_i64(const uint8_t* data, size_t& offset) {
-    int64_t v;
-    std::memcpy(&v, data + offset, sizeof(v));
+    int64_t v = load_le<int64_t>(data + offset);
     offset += 8;
     return v;
 }
@@ -88,6 +86,7 @@ inline Candle read_candle(const uint8_t* data, size_t& offset) {
  * Returns std::nullopt if data is invalid or discriminator doesn't match.
  */
 inline std::optional<Pool> parse_pool(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.pool");
     // Direct memory copy approach for packed struct
     if (len < sizeof(Pool)) return std::nullopt;
 
@@ -104,87 +103,78 @@ inline std::optional<Pool> parse_pool(const uint8_t* data, size_t len) {
  * More portable but slower than direct memory mapping.
  */
 inline std::optional<Pool> parse_pool_safe(const uint8_t* data, size_t len) {
-    if (len < 900) return std::nullopt;
-
-    size_t offset = 0;
+    AEX402_TRACE_SCOPE("parse.pool_safe");
+    namespace L = layout::pool;
+    if (len < L::SIZE) return std::nullopt;
 
     // Check discriminator
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::POOL) return std::nullopt;
 
     Pool pool;
     std::memcpy(pool.disc, &disc, 8);
 
     // Pubkeys
-    pool.authority = detail::read_pubkey(data, offset);
-    pool.mint0 = detail::read_pubkey(data, offset);
-    pool.mint1 = detail::read_pubkey(data, offset);
-    pool.vault0 = detail::read_pubkey(data, offset);
-    pool.vault1 = detail::read_pubkey(data, offset);
-    pool.lp_mint = detail::read_pubkey(data, offset);
+    pool.authority = L::authority::read(data);
+    pool.mint0 = L::mint0::read(data);
+    pool.mint1 = L::mint1::read(data);
+    pool.vault0 = L::vault0::read(data);
+    pool.vault1 = L::vault1::read(data);
+    pool.lp_mint = L::lp_mint::read(data);
 
     // Amp fields
-    pool.amp = detail::read_u64(data, offset);
-    pool.init_amp = detail::read_u64(data, offset);
-    pool.target_amp = detail::read_u64(data, offset);
-    pool.ramp_start = detail::read_i64(data, offset);
-    pool.ramp_stop = detail::read_i64(data, offset);
+    pool.amp = L::amp::read(data);
+    pool.init_amp = L::init_amp::read(data);
+    pool.target_amp = L::target_amp::read(data);
+    pool.ramp_start = L::ramp_start::read(data);
+    pool.ramp_stop = L::ramp_stop::read(data);
 
     // Fee fields
-    pool.fee_bps = detail::read_u64(data, offset);
-    pool.admin_fee_pct = detail::read_u64(data, offset);
+    pool.fee_bps = L::fee_bps::read(data);
+    pool.admin_fee_pct = L::admin_fee_pct::read(data);
 
     // Balance fields
-    pool.bal0 = detail::read_u64(data, offset);
-    pool.bal1 = detail::read_u64(data, offset);
-    pool.lp_supply = detail::read_u64(data, offset);
-    pool.admin_fee0 = detail::read_u64(data, offset);
-    pool.admin_fee1 = detail::read_u64(data, offset);
+    pool.bal0 = L::bal0::read(data);
+    pool.bal1 = L::bal1::read(data);
+    pool.lp_supply = L::lp_supply::read(data);
+    pool.admin_fee0 = L::admin_fee0::read(data);
+    pool.admin_fee1 = L::admin_fee1::read(data);
 
     // Volume fields
-    pool.vol0 = detail::read_u64(data, offset);
-    pool.vol1 = detail::read_u64(data, offset);
+    pool.vol0 = L::vol0::read(data);
+    pool.vol1 = L::vol1::read(data);
 
     // Flags
-    pool.paused = detail::read_u8(data, offset);
-    pool.bump = detail::read_u8(data, offset);
-    pool.v0_bump = detail::read_u8(data, offset);
-    pool.v1_bump = detail::read_u8(data, offset);
-    pool.lp_bump = detail::read_u8(data, offset);
-    offset += 3;  // _pad
+    pool.paused = L::paused::read(data);
+    pool.bump = L::bump::read(data);
+    pool.v0_bump = L::v0_bump::read(data);
+    pool.v1_bump = L::v1_bump::read(data);
+    pool.lp_bump = L::lp_bump::read(data);
+    L::_pad::read_into(pool._pad, data);
 
     // Pending authority
-    pool.pending_auth = detail::read_pubkey(data, offset);
-    pool.auth_time = detail::read_i64(data, offset);
+    pool.pending_auth = L::pending_auth::read(data);
+    pool.auth_time = L::auth_time::read(data);
 
     // Pending amp
-    pool.pending_amp = detail::read_u64(data, offset);
-    pool.amp_time = detail::read_i64(data, offset);
+    pool.pending_amp = L::pending_amp::read(data);
+    pool.amp_time = L::amp_time::read(data);
 
     // Analytics
-    pool.trade_count = detail::read_u64(data, offset);
-    pool.trade_sum = detail::read_u64(data, offset);
-    pool.max_price = detail::read_u32(data, offset);
-    pool.min_price = detail::read_u32(data, offset);
-    pool.hour_slot = detail::read_u32(data, offset);
-    pool.day_slot = detail::read_u32(data, offset);
-    pool.hour_idx = detail::read_u8(data, offset);
-    pool.day_idx = detail::read_u8(data, offset);
-    offset += 6;  // _pad2
-
-    // Bloom filter
-    std::memcpy(pool.bloom, data + offset, BLOOM_SIZE);
-    offset += BLOOM_SIZE;
-
-    // Hourly candles
-    for (int i = 0; i < OHLCV_24H; i++) {
-        pool.hours[i] = detail::read_candle(data, offset);
-    }
-
-    // Daily candles
-    for (int i = 0; i < OHLCV_7D; i++) {
-        pool.days[i] = detail::read_candle(data, offset);
-    }
+    pool.trade_count = L::trade_count::read(data);
+    pool.trade_sum = L::trade_sum::read(data);
+    pool.max_price = L::max_price::read(data);
+    pool.min_price = L::min_price::read(data);
+    pool.hour_slot = L::hour_slot::read(data);
+    pool.day_slot = L::day_slot::read(data);
+    pool.hour_idx = L::hour_idx::read(data);
+    pool.day_idx = L::day_idx::read(data);
+    L::_pad2::read_into(pool._pad2, data);
+
+    // Bloom filter and candles
+    L::bloom::read_into(pool.bloom, data);
+    L::hours::read_into(pool.hours, data);
+    L::days::read_into(pool.days, data);
 
     return pool;
 }
@@ -197,6 +187,7 @@ inline std::optional<Pool> parse_pool_safe(const uint8_t* data, size_t len) {
  * Parse an N-token Pool from raw account data.
  */
 inline std::optional<NPool> parse_npool(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.npool");
     if (len < sizeof(NPool)) return std::nullopt;
 
     NPool pool;
@@ -211,50 +202,179 @@ inline std::optional<NPool> parse_npool(const uint8_t* data, size_t len) {
  * Parse an N-token Pool with field-by-field reading.
  */
 inline std::optional<NPool> parse_npool_safe(const uint8_t* data, size_t len) {
-    if (len < 800) return std::nullopt;
-
-    size_t offset = 0;
+    AEX402_TRACE_SCOPE("parse.npool_safe");
+    namespace L = layout::npool;
+    if (len < L::SIZE) return std::nullopt;
 
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::NPOOL) return std::nullopt;
 
     NPool pool;
     std::memcpy(pool.disc, &disc, 8);
 
-    pool.authority = detail::read_pubkey(data, offset);
-    pool.n_tokens = detail::read_u8(data, offset);
-    pool.paused = detail::read_u8(data, offset);
-    pool.bump = detail::read_u8(data, offset);
-    offset += 5;  // _pad
+    pool.authority = L::authority::read(data);
+    pool.n_tokens = L::n_tokens::read(data);
+    pool.paused = L::paused::read(data);
+    pool.bump = L::bump::read(data);
+    L::_pad::read_into(pool._pad, data);
 
-    pool.amp = detail::read_u64(data, offset);
-    pool.fee_bps = detail::read_u64(data, offset);
-    pool.admin_fee_pct = detail::read_u64(data, offset);
-    pool.lp_supply = detail::read_u64(data, offset);
+    pool.amp = L::amp::read(data);
+    pool.fee_bps = L::fee_bps::read(data);
+    pool.admin_fee_pct = L::admin_fee_pct::read(data);
+    pool.lp_supply = L::lp_supply::read(data);
 
-    for (int i = 0; i < MAX_TOKENS; i++) {
-        pool.mints[i] = detail::read_pubkey(data, offset);
-    }
+    L::mints::read_into(pool.mints, data);
+    L::vaults::read_into(pool.vaults, data);
+    pool.lp_mint = L::lp_mint::read(data);
+    L::balances::read_into(pool.balances, data);
+    L::admin_fees::read_into(pool.admin_fees, data);
 
-    for (int i = 0; i < MAX_TOKENS; i++) {
-        pool.vaults[i] = detail::read_pubkey(data, offset);
-    }
+    pool.total_volume = L::total_volume::read(data);
+    pool.trade_count = L::trade_count::read(data);
+    pool.last_trade_slot = L::last_trade_slot::read(data);
 
-    pool.lp_mint = detail::read_pubkey(data, offset);
+    return pool;
+}
 
-    for (int i = 0; i < MAX_TOKENS; i++) {
-        pool.balances[i] = detail::read_u64(data, offset);
+// ============================================================================
+// Zero-Copy Views
+// ============================================================================
+
+/**
+ * Read-only view of a Pool account in place.
+ * Fields are loaded on access with alignment-safe little-endian reads, so
+ * `data` may point anywhere in a network buffer. The view does not own
+ * the buffer and is only valid while it lives.
+ */
+struct PoolView {
+    const uint8_t* data;
+
+    Pubkey   authority() const { return layout::pool::authority::read(data); }
+    Pubkey   mint0() const { return layout::pool::mint0::read(data); }
+    Pubkey   mint1() const { return layout::pool::mint1::read(data); }
+    Pubkey   vault0() const { return layout::pool::vault0::read(data); }
+    Pubkey   vault1() const { return layout::pool::vault1::read(data); }
+    Pubkey   lp_mint() const { return layout::pool::lp_mint::read(data); }
+    uint64_t amp() const { return layout::pool::amp::read(data); }
+    uint64_t init_amp() const { return layout::pool::init_amp::read(data); }
+    uint64_t target_amp() const { return layout::pool::target_amp::read(data); }
+    int64_t  ramp_start() const { return layout::pool::ramp_start::read(data); }
+    int64_t  ramp_stop() const { return layout::pool::ramp_stop::read(data); }
+    uint64_t fee_bps() const { return layout::pool::fee_bps::read(data); }
+    uint64_t admin_fee_pct() const { return layout::pool::admin_fee_pct::read(data); }
+    uint64_t bal0() const { return layout::pool::bal0::read(data); }
+    uint64_t bal1() const { return layout::pool::bal1::read(data); }
+    uint64_t lp_supply() const { return layout::pool::lp_supply::read(data); }
+    uint64_t admin_fee0() const { return layout::pool::admin_fee0::read(data); }
+    uint64_t admin_fee1() const { return layout::pool::admin_fee1::read(data); }
+    uint64_t vol0() const { return layout::pool::vol0::read(data); }
+    uint64_t vol1() const { return layout::pool::vol1::read(data); }
+    uint8_t  paused() const { return layout::pool::paused::read(data); }
+    uint8_t  bump() const { return layout::pool::bump::read(data); }
+    Pubkey   pending_auth() const { return layout::pool::pending_auth::read(data); }
+    int64_t  auth_time() const { return layout::pool::auth_time::read(data); }
+    uint64_t pending_amp() const { return layout::pool::pending_amp::read(data); }
+    int64_t  amp_time() const { return layout::pool::amp_time::read(data); }
+    uint64_t trade_count() const { return layout::pool::trade_count::read(data); }
+    uint64_t trade_sum() const { return layout::pool::trade_sum::read(data); }
+    uint32_t max_price() const { return layout::pool::max_price::read(data); }
+    uint32_t min_price() const { return layout::pool::min_price::read(data); }
+    uint32_t hour_slot() const { return layout::pool::hour_slot::read(data); }
+    uint32_t day_slot() const { return layout::pool::day_slot::read(data); }
+    uint8_t  hour_idx() const { return layout::pool::hour_idx::read(data); }
+    uint8_t  day_idx() const { return layout::pool::day_idx::read(data); }
+
+    bool is_valid() const { return layout::pool::disc::read(data) == account_disc::POOL; }
+    bool is_paused() const { return paused() != 0; }
+
+    Candle hour(size_t i) const { return layout::pool::hours::read_at(data, i); }
+    Candle day(size_t i) const { return layout::pool::days::read_at(data, i); }
+
+    // Get current effective amp (handles ramping)
+    uint64_t get_amp(int64_t now) const {
+        uint64_t a = amp();
+        uint64_t t = target_amp();
+        int64_t start = ramp_start();
+        int64_t stop = ramp_stop();
+
+        if (now >= stop || stop == start) return t;
+        if (now <= start) return a;
+
+        uint64_t elapsed = static_cast<uint64_t>(now - start);
+        uint64_t duration = static_cast<uint64_t>(stop - start);
+
+        if (t > a) {
+            return a + (t - a) * elapsed / duration;
+        } else {
+            return a - (a - t) * elapsed / duration;
+        }
     }
 
-    for (int i = 0; i < MAX_TOKENS; i++) {
-        pool.admin_fees[i] = detail::read_u64(data, offset);
+    // Copy out the full struct
+    Pool to_pool() const {
+        Pool pool;
+        std::memcpy(&pool, data, sizeof(Pool));
+        return pool;
+    }
+};
+
+/**
+ * Read-only view of an NPool account in place.
+ */
+struct NPoolView {
+    const uint8_t* data;
+
+    Pubkey   authority() const { return layout::npool::authority::read(data); }
+    uint8_t  n_tokens() const { return layout::npool::n_tokens::read(data); }
+    uint8_t  paused() const { return layout::npool::paused::read(data); }
+    uint8_t  bump() const { return layout::npool::bump::read(data); }
+    uint64_t amp() const { return layout::npool::amp::read(data); }
+    uint64_t fee_bps() const { return layout::npool::fee_bps::read(data); }
+    uint64_t admin_fee_pct() const { return layout::npool::admin_fee_pct::read(data); }
+    uint64_t lp_supply() const { return layout::npool::lp_supply::read(data); }
+    Pubkey   lp_mint() const { return layout::npool::lp_mint::read(data); }
+    uint64_t total_volume() const { return layout::npool::total_volume::read(data); }
+    uint64_t trade_count() const { return layout::npool::trade_count::read(data); }
+    uint64_t last_trade_slot() const { return layout::npool::last_trade_slot::read(data); }
+
+    Pubkey   mint(size_t i) const { return layout::npool::mints::read_at(data, i); }
+    Pubkey   vault(size_t i) const { return layout::npool::vaults::read_at(data, i); }
+    uint64_t balance(size_t i) const { return layout::npool::balances::read_at(data, i); }
+    uint64_t admin_fee(size_t i) const { return layout::npool::admin_fees::read_at(data, i); }
+
+    bool is_valid() const { return layout::npool::disc::read(data) == account_disc::NPOOL; }
+    bool is_paused() const { return paused() != 0; }
+
+    // Copy out the full struct
+    NPool to_npool() const {
+        NPool pool;
+        std::memcpy(&pool, data, sizeof(NPool));
+        return pool;
     }
+};
 
-    pool.total_volume = detail::read_u64(data, offset);
-    pool.trade_count = detail::read_u64(data, offset);
-    pool.last_trade_slot = detail::read_u64(data, offset);
+/**
+ * Create a zero-copy Pool view after validating length and discriminator.
+ */
+inline std::optional<PoolView> view_pool(const uint8_t* data, size_t len) {
+    if (len < layout::pool::SIZE) return std::nullopt;
 
-    return pool;
+    PoolView view{data};
+    if (!view.is_valid()) return std::nullopt;
+
+    return view;
+}
+
+/**
+ * Create a zero-copy NPool view after validating length and discriminator.
+ */
+inline std::optional<NPoolView> view_npool(const uint8_t* data, size_t len) {
+    if (len < layout::npool::SIZE) return std::nullopt;
+
+    NPoolView view{data};
+    if (!view.is_valid()) return std::nullopt;
+
+    return view;
 }
 
 // ============================================================================
@@ -265,6 +385,7 @@ inline std::optional<NPool> parse_npool_safe(const uint8_t* data, size_t len) {
  * Parse a Farm from raw account data.
  */
 inline std::optional<Farm> parse_farm(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.farm");
     if (len < sizeof(Farm)) return std::nullopt;
 
     Farm farm;
@@ -279,24 +400,24 @@ inline std::optional<Farm> parse_farm(const uint8_t* data, size_t len) {
  * Parse a Farm with field-by-field reading.
  */
 inline std::optional<Farm> parse_farm_safe(const uint8_t* data, size_t len) {
-    if (len < 120) return std::nullopt;
-
-    size_t offset = 0;
+    AEX402_TRACE_SCOPE("parse.farm_safe");
+    namespace L = layout::farm;
+    if (len < L::SIZE) return std::nullopt;
 
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::FARM) return std::nullopt;
 
     Farm farm;
     std::memcpy(farm.disc, &disc, 8);
 
-    farm.pool = detail::read_pubkey(data, offset);
-    farm.reward_mint = detail::read_pubkey(data, offset);
-    farm.reward_rate = detail::read_u64(data, offset);
-    farm.start_time = detail::read_i64(data, offset);
-    farm.end_time = detail::read_i64(data, offset);
-    farm.total_staked = detail::read_u64(data, offset);
-    farm.acc_reward = detail::read_u64(data, offset);
-    farm.last_update = detail::read_i64(data, offset);
+    farm.pool = L::pool::read(data);
+    farm.reward_mint = L::reward_mint::read(data);
+    farm.reward_rate = L::reward_rate::read(data);
+    farm.start_time = L::start_time::read(data);
+    farm.end_time = L::end_time::read(data);
+    farm.total_staked = L::total_staked::read(data);
+    farm.acc_reward = L::acc_reward::read(data);
+    farm.last_update = L::last_update::read(data);
 
     return farm;
 }
@@ -309,6 +430,7 @@ inline std::optional<Farm> parse_farm_safe(const uint8_t* data, size_t len) {
  * Parse a UserFarm from raw account data.
  */
 inline std::optional<UserFarm> parse_user_farm(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.user_farm");
     if (len < sizeof(UserFarm)) return std::nullopt;
 
     UserFarm uf;
@@ -323,21 +445,21 @@ inline std::optional<UserFarm> parse_user_farm(const uint8_t* data, size_t len)
  * Parse a UserFarm with field-by-field reading.
  */
 inline std::optional<UserFarm> parse_user_farm_safe(const uint8_t* data, size_t len) {
-    if (len < 96) return std::nullopt;
-
-    size_t offset = 0;
+    AEX402_TRACE_SCOPE("parse.user_farm_safe");
+    namespace L = layout::user_farm;
+    if (len < L::SIZE) return std::nullopt;
 
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::UFARM) return std::nullopt;
 
     UserFarm uf;
     std::memcpy(uf.disc, &disc, 8);
 
-    uf.owner = detail::read_pubkey(data, offset);
-    uf.farm = detail::read_pubkey(data, offset);
-    uf.staked = detail::read_u64(data, offset);
-    uf.reward_debt = detail::read_u64(data, offset);
-    uf.lock_end = detail::read_i64(data, offset);
+    uf.owner = L::owner::read(data);
+    uf.farm = L::farm::read(data);
+    uf.staked = L::staked::read(data);
+    uf.reward_debt = L::reward_debt::read(data);
+    uf.lock_end = L::lock_end::read(data);
 
     return uf;
 }
@@ -350,6 +472,7 @@ inline std::optional<UserFarm> parse_user_farm_safe(const uint8_t* data, size_t
  * Parse a Lottery from raw account data.
  */
 inline std::optional<Lottery> parse_lottery(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.lottery");
     if (len < sizeof(Lottery)) return std::nullopt;
 
     Lottery lot;
@@ -364,26 +487,27 @@ inline std::optional<Lottery> parse_lottery(const uint8_t* data, size_t len) {
  * Parse a Lottery with field-by-field reading.
  */
 inline std::optional<Lottery> parse_lottery_safe(const uint8_t* data, size_t len) {
-    if (len < 152) return std::nullopt;
+    AEX402_TRACE_SCOPE("parse.lottery_safe");
+    namespace L = layout::lottery;
+    if (len < L::SIZE) return std::nullopt;
 
-    size_t offset = 0;
-
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::LOTTERY) return std::nullopt;
 
     Lottery lot;
     std::memcpy(lot.disc, &disc, 8);
 
-    lot.pool = detail::read_pubkey(data, offset);
-    lot.authority = detail::read_pubkey(data, offset);
-    lot.lottery_vault = detail::read_pubkey(data, offset);
-    lot.ticket_price = detail::read_u64(data, offset);
-    lot.total_tickets = detail::read_u64(data, offset);
-    lot.prize_pool = detail::read_u64(data, offset);
-    lot.end_time = detail::read_i64(data, offset);
-    lot.winning_ticket = detail::read_u64(data, offset);
-    lot.drawn = detail::read_u8(data, offset);
-    lot.claimed = detail::read_u8(data, offset);
+    lot.pool = L::pool::read(data);
+    lot.authority = L::authority::read(data);
+    lot.lottery_vault = L::lottery_vault::read(data);
+    lot.ticket_price = L::ticket_price::read(data);
+    lot.total_tickets = L::total_tickets::read(data);
+    lot.prize_pool = L::prize_pool::read(data);
+    lot.end_time = L::end_time::read(data);
+    lot.winning_ticket = L::winning_ticket::read(data);
+    lot.drawn = L::drawn::read(data);
+    lot.claimed = L::claimed::read(data);
+    L::_pad::read_into(lot._pad, data);
 
     return lot;
 }
@@ -396,6 +520,7 @@ inline std::optional<Lottery> parse_lottery_safe(const uint8_t* data, size_t len
  * Parse a LotteryEntry from raw account data.
  */
 inline std::optional<LotteryEntry> parse_lottery_entry(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.lottery_entry");
     if (len < sizeof(LotteryEntry)) return std::nullopt;
 
     LotteryEntry entry;
@@ -410,20 +535,20 @@ inline std::optional<LotteryEntry> parse_lottery_entry(const uint8_t* data, size
  * Parse a LotteryEntry with field-by-field reading.
  */
 inline std::optional<LotteryEntry> parse_lottery_entry_safe(const uint8_t* data, size_t len) {
-    if (len < 88) return std::nullopt;
-
-    size_t offset = 0;
+    AEX402_TRACE_SCOPE("parse.lottery_entry_safe");
+    namespace L = layout::lottery_entry;
+    if (len < L::SIZE) return std::nullopt;
 
-    uint64_t disc = detail::read_u64(data, offset);
+    uint64_t disc = L::disc::read(data);
     if (disc != account_disc::LOTENTRY) return std::nullopt;
 
     LotteryEntry entry;
     std::memcpy(entry.disc, &disc, 8);
 
-    entry.owner = detail::read_pubkey(data, offset);
-    entry.lottery = detail::read_pubkey(data, offset);
-    entry.ticket_start = detail::read_u64(data, offset);
-    entry.ticket_count = detail::read_u64(data, offset);
+    entry.owner = L::owner::read(data);
+    entry.lottery = L::lottery::read(data);
+    entry.ticket_start = L::ticket_start::read(data);
+    entry.ticket_count = L::ticket_count::read(data);
 
     return entry;
 }
@@ -437,6 +562,7 @@ inline std::optional<LotteryEntry> parse_lottery_entry_safe(const uint8_t* data,
  * Note: Pools array must be parsed separately due to variable length.
  */
 inline std::optional<Registry> parse_registry(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.registry");
     if (len < sizeof(Registry)) return std::nullopt;
 
     Registry reg;
@@ -452,7 +578,12 @@ inline std::optional<Registry> parse_registry(const uint8_t* data, size_t len) {
  * Returns vector of registered pool pubkeys.
  */
 inline std::vector<Pubkey> parse_registry_pools(const uint8_t* data, size_t len, uint32_t count) {
+    AEX402_TRACE_SCOPE("parse.registry_pools");
     std::vector<Pubkey> pools;
+    if (len > sizeof(Registry)) {
+        size_t avail = (len - sizeof(Registry)) / 32;
+        pools.reserve(count < avail ? count : avail);
+    }
 
     size_t offset = sizeof(Registry);
     for (uint32_t i = 0; i < count && offset + 32 <= len; i++) {
@@ -462,6 +593,95 @@ inline std::vector<Pubkey> parse_registry_pools(const uint8_t* data, size_t len,
     return pools;
 }
 
+/**
+ * Zero-copy view over a registry's pool array.
+ * Points into the caller's account buffer and is only valid while it lives.
+ */
+struct RegistryPoolsView {
+    const uint8_t* pools = nullptr;  // First 32-byte pool key
+    uint32_t count = 0;              // Number of keys
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Raw bytes of the i-th pool key
+    const uint8_t* key_bytes(size_t i) const { return pools + i * 32; }
+
+    Pubkey operator[](size_t i) const {
+        Pubkey pk;
+        std::memcpy(pk.data(), key_bytes(i), 32);
+        return pk;
+    }
+};
+
+/**
+ * Parse the registry pool array without copying.
+ * Returns std::nullopt if the discriminator doesn't match or the buffer
+ * is too short to hold `count` keys.
+ */
+inline std::optional<RegistryPoolsView> parse_registry_pools_view(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.registry_pools_view");
+    auto reg = parse_registry(data, len);
+    if (!reg) return std::nullopt;
+
+    size_t avail = (len - sizeof(Registry)) / 32;
+    if (reg->count > avail) return std::nullopt;
+
+    return RegistryPoolsView{data + sizeof(Registry), reg->count};
+}
+
+/**
+ * Pools added and removed between two registry snapshots.
+ */
+struct RegistryDiff {
+    std::vector<Pubkey> added;
+    std::vector<Pubkey> removed;
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
+
+/**
+ * Compute the pools added/removed between two registry snapshots.
+ *
+ * Unchanged and append-only registries are detected by a prefix compare
+ * without hashing; otherwise both sides are indexed in a PubkeySet.
+ * Output order follows the order of keys in the respective snapshot.
+ */
+inline RegistryDiff diff_registry_pools(const RegistryPoolsView& before, const RegistryPoolsView& after) {
+    RegistryDiff diff;
+
+    size_t common = before.count < after.count ? before.count : after.count;
+    size_t prefix = 0;
+    while (prefix < common &&
+           std::memcmp(before.key_bytes(prefix), after.key_bytes(prefix), 32) == 0) {
+        prefix++;
+    }
+
+    // Fast path: one snapshot is a prefix of the other
+    if (prefix == common) {
+        for (size_t i = prefix; i < after.count; i++) diff.added.push_back(after[i]);
+        for (size_t i = prefix; i < before.count; i++) diff.removed.push_back(before[i]);
+        return diff;
+    }
+
+    PubkeySet old_set(before.count - prefix);
+    for (size_t i = prefix; i < before.count; i++) old_set.insert(before[i]);
+
+    PubkeySet new_set(after.count - prefix);
+    for (size_t i = prefix; i < after.count; i++) {
+        Pubkey pk = after[i];
+        new_set.insert(pk);
+        if (!old_set.contains(pk)) diff.added.push_back(pk);
+    }
+
+    for (size_t i = prefix; i < before.count; i++) {
+        Pubkey pk = before[i];
+        if (!new_set.contains(pk)) diff.removed.push_back(pk);
+    }
+
+    return diff;
+}
+
 // ============================================================================
 // Governance Parsing
 // ============================================================================
@@ -470,6 +690,7 @@ inline std::vector<Pubkey> parse_registry_pools(const uint8_t* data, size_t len,
  * Parse a GovProposal from raw account data.
  */
 inline std::optional<GovProposal> parse_gov_proposal(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.gov_proposal");
     if (len < sizeof(GovProposal)) return std::nullopt;
 
     GovProposal prop;
@@ -484,6 +705,7 @@ inline std::optional<GovProposal> parse_gov_proposal(const uint8_t* data, size_t
  * Parse a GovVote from raw account data.
  */
 inline std::optional<GovVote> parse_gov_vote(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.gov_vote");
     if (len < sizeof(GovVote)) return std::nullopt;
 
     GovVote vote;
@@ -502,6 +724,7 @@ inline std::optional<GovVote> parse_gov_vote(const uint8_t* data, size_t len) {
  * Parse a CLPool from raw account data.
  */
 inline std::optional<CLPool> parse_cl_pool(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.cl_pool");
     if (len < sizeof(CLPool)) return std::nullopt;
 
     CLPool pool;
@@ -516,6 +739,7 @@ inline std::optional<CLPool> parse_cl_pool(const uint8_t* data, size_t len) {
  * Parse a CLPosition from raw account data.
  */
 inline std::optional<CLPosition> parse_cl_position(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.cl_position");
     if (len < sizeof(CLPosition)) return std::nullopt;
 
     CLPosition pos;
@@ -535,6 +759,7 @@ inline std::optional<CLPosition> parse_cl_position(const uint8_t* data, size_t l
  * Note: Observation buffer must be parsed separately.
  */
 inline std::optional<MLBrain> parse_ml_brain(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.ml_brain");
     if (len < sizeof(MLBrain)) return std::nullopt;
 
     MLBrain brain;
@@ -553,6 +778,7 @@ inline std::optional<MLBrain> parse_ml_brain(const uint8_t* data, size_t len) {
  * Parse an Orderbook from raw account data.
  */
 inline std::optional<Orderbook> parse_orderbook(const uint8_t* data, size_t len) {
+    AEX402_TRACE_SCOPE("parse.orderbook");
     if (len < sizeof(Orderbook)) return std::nullopt;
 
     Orderbook book;
@@ -563,6 +789,18 @@ inline std::optional<Orderbook> parse_orderbook(const uint8_t* data, size_t len)
     return book;
 }
 
+// ============================================================================
+// Raw Accounts
+// ============================================================================
+
+/**
+ * Raw account buffer (not owned).
+ */
+struct AccountData {
+    const uint8_t* data;
+    size_t len;
+};
+
 // ============================================================================
 // Generic Account Type Detection
 // ============================================================================
@@ -585,6 +823,13 @@ enum class AccountType {
     Orderbook,
     GovProposal,
     GovVote,
+    // Detected by discriminator only; no layout is defined for these yet
+    GlobalVPools,
+    VPoolClaim,
+    FarmState,
+    ProgramConfig,
+    AIFee,
+    TransferHookMeta,
 };
 
 /**
@@ -593,8 +838,7 @@ enum class AccountType {
 inline AccountType detect_account_type(const uint8_t* data, size_t len) {
     if (len < 8) return AccountType::Unknown;
 
-    uint64_t disc;
-    std::memcpy(&disc, data, 8);
+    uint64_t disc = detail::load_le<uint64_t>(data);
 
     switch (disc) {
         case account_disc::POOL:     return AccountType::Pool;
@@ -610,6 +854,12 @@ inline AccountType detect_account_type(const uint8_t* data, size_t len) {
         case account_disc::BOOK:     return AccountType::Orderbook;
         case account_disc::GOVPROP:  return AccountType::GovProposal;
         case account_disc::GOVVOTE:  return AccountType::GovVote;
+        case account_disc::GPOOLS:   return AccountType::GlobalVPools;
+        case account_disc::VPCLAIM:  return AccountType::VPoolClaim;
+        case account_disc::FARMSTATE: return AccountType::FarmState;
+        case account_disc::PCONFIG:  return AccountType::ProgramConfig;
+        case account_disc::AIFEE:    return AccountType::AIFee;
+        case account_disc::THMETA:   return AccountType::TransferHookMeta;
         default:                     return AccountType::Unknown;
     }
 }
@@ -632,6 +882,12 @@ inline const char* account_type_name(AccountType type) {
         case AccountType::Orderbook:    return "Orderbook";
         case AccountType::GovProposal:  return "GovProposal";
         case AccountType::GovVote:      return "GovVote";
+        case AccountType::GlobalVPools: return "GlobalVPools";
+        case AccountType::VPoolClaim:   return "VPoolClaim";
+        case AccountType::FarmState:    return "FarmState";
+        case AccountType::ProgramConfig: return "ProgramConfig";
+        case AccountType::AIFee:        return "AIFee";
+        case AccountType::TransferHookMeta: return "TransferHookMeta";
         default:                        return "Unknown";
     }
 }
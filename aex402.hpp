@@ -12,8 +12,27 @@
  * - types.hpp:     Account structures (Pool, NPool, Farm, etc.)
  * - accounts.hpp:  Account parsing functions
  * - instructions.hpp: Instruction builders
+ * - compute_budget.hpp: ComputeBudget builders and CU estimator
+ * - transaction.hpp: Transaction sizing and instruction packing
  * - math.hpp:      StableSwap math (Newton's method)
  * - pda.hpp:       PDA derivation utilities
+ * - layout.hpp:   Compile-time account layout tables
+ * - pubkey_map.hpp: Flat hash map/set keyed by Pubkey
+ * - validate.hpp: Parallel snapshot integrity checks
+ * - ed25519.hpp:  Ed25519 transaction signing
+ * - inference.hpp: Swap/liquidity inference from snapshots
+ * - ohlcv.hpp:    Streaming OHLCV aggregation
+ * - shm.hpp:      Shared-memory pool state (POSIX; include directly)
+ * - arrow_ipc.hpp: Arrow IPC file export of account snapshots
+ * - trace.hpp:    Latency histograms and tracing hooks
+ * - quote_cache.hpp: Versioned quote cache with size bucketing
+ * - mev.hpp:      Sandwich exposure and safe min_out for outgoing swaps
+ * - monitor.hpp:  Column-wise pool health rules with hysteresis
+ * - volatility.hpp: Candle volatility estimators and fee recommendation
+ * - route.hpp:    Exact multihop quotes and shared-prefix route batches
+ * - oracle.hpp:   Multi-pool reference prices with outlier rejection
+ * - perf_counters.hpp: Hardware performance counters (include directly)
+ * - synthetic.hpp: Seeded test universe and swap streams (include directly)
  *
  * Example usage:
  *
@@ -46,10 +65,26 @@
 
 #include "constants.hpp"
 #include "types.hpp"
+#include "layout.hpp"
 #include "accounts.hpp"
 #include "instructions.hpp"
+#include "compute_budget.hpp"
+#include "transaction.hpp"
 #include "math.hpp"
 #include "pda.hpp"
+#include "pubkey_map.hpp"
+#include "validate.hpp"
+#include "ed25519.hpp"
+#include "inference.hpp"
+#include "ohlcv.hpp"
+#include "arrow_ipc.hpp"
+#include "trace.hpp"
+#include "quote_cache.hpp"
+#include "mev.hpp"
+#include "monitor.hpp"
+#include "volatility.hpp"
+#include "route.hpp"
+#include "oracle.hpp"
 
 namespace aex402 {
 
@@ -0,0 +1,104 @@
+/**
+ * AeX402 AMM SDK - C ABI implementation
+ *
+ * Thin batch loops over the header-only SDK; see aex402_c.h.
+ */
+
+#define AEX402_C_BUILDING
+#include "aex402_c.h"
+#include "aex402.hpp"
+#include <cstddef>
+#include <cstring>
+
+using namespace aex402;
+
+static_assert(sizeof(aex402_pool_info) == 168, "aex402_pool_info layout is part of the ABI");
+static_assert(offsetof(aex402_pool_info, mint0) == 96, "aex402_pool_info layout is part of the ABI");
+
+namespace {
+
+inline void set_ok(uint8_t* ok, size_t i, bool v) {
+    if (ok) ok[i] = v ? 1 : 0;
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t aex402_abi_version(void) {
+    return AEX402_C_ABI_VERSION;
+}
+
+size_t aex402_simulate_swap_batch(size_t n,
+                                  const uint64_t* bal_in,
+                                  const uint64_t* bal_out,
+                                  const uint64_t* amount_in,
+                                  const uint64_t* amp,
+                                  const uint64_t* fee_bps,
+                                  uint64_t* amount_out,
+                                  uint8_t* ok) {
+    if (!bal_in || !bal_out || !amount_in || !amp || !fee_bps || !amount_out) return 0;
+    size_t good = 0;
+    for (size_t i = 0; i < n; i++) {
+        auto out = math::simulate_swap(bal_in[i], bal_out[i], amount_in[i], amp[i], fee_bps[i]);
+        amount_out[i] = out ? *out : 0;
+        set_ok(ok, i, out.has_value());
+        if (out) good++;
+    }
+    return good;
+}
+
+size_t aex402_calc_d_batch(size_t n,
+                           const uint64_t* x,
+                           const uint64_t* y,
+                           const uint64_t* amp,
+                           uint64_t* d,
+                           uint8_t* ok) {
+    if (!x || !y || !amp || !d) return 0;
+    size_t good = 0;
+    for (size_t i = 0; i < n; i++) {
+        auto v = math::calc_d(x[i], y[i], amp[i]);
+        d[i] = v ? *v : 0;
+        set_ok(ok, i, v.has_value());
+        if (v) good++;
+    }
+    return good;
+}
+
+size_t aex402_parse_pools_batch(const uint8_t* data,
+                                size_t stride,
+                                size_t count,
+                                int64_t now,
+                                aex402_pool_info* out) {
+    if (!data || !out) return 0;
+    size_t good = 0;
+    for (size_t i = 0; i < count; i++) {
+        aex402_pool_info& info = out[i];
+        std::memset(&info, 0, sizeof(info));
+
+        auto v = view_pool(data + i * stride, stride);
+        if (!v) continue;
+        info.amp = v->get_amp(now);
+        info.target_amp = v->target_amp();
+        info.ramp_stop = v->ramp_stop();
+        info.fee_bps = v->fee_bps();
+        info.admin_fee_pct = v->admin_fee_pct();
+        info.bal0 = v->bal0();
+        info.bal1 = v->bal1();
+        info.lp_supply = v->lp_supply();
+        info.vol0 = v->vol0();
+        info.vol1 = v->vol1();
+        info.trade_count = v->trade_count();
+        info.trade_sum = v->trade_sum();
+        Pubkey m0 = v->mint0();
+        Pubkey m1 = v->mint1();
+        std::memcpy(info.mint0, m0.data(), 32);
+        std::memcpy(info.mint1, m1.data(), 32);
+        info.paused = v->paused();
+        info.valid = 1;
+        good++;
+    }
+    return good;
+}
+
+}  // extern "C"
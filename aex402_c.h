@@ -0,0 +1,134 @@
+#ifndef AEX402_C_H
+#define AEX402_C_H
+/**
+ * AeX402 AMM SDK - C ABI
+ *
+ * Stable C interface to the header-only C++ SDK, built as the optional
+ * shared library libaex402_c (cmake -DAEX402_BUILD_C_API=ON).
+ *
+ * Every entry point works on a batch of caller-owned contiguous arrays,
+ * so one foreign call covers many quotes and NumPy / Rust slice buffers
+ * are read and written in place without copying. Inputs are never
+ * retained; functions are stateless and safe to call from any thread.
+ *
+ * Per-element failures (invalid parameters, non-convergence, overflow)
+ * set the output to 0 and, if an `ok` array is given, ok[i] to 0.
+ * Functions return the number of elements that succeeded; a NULL
+ * required pointer makes the whole call return 0 without writing.
+ *
+ * Python (ctypes + NumPy). Declare argtypes and restype before calling:
+ * without them ctypes passes each pointer as a 32-bit int and the call
+ * crashes.
+ *   lib = ctypes.CDLL("libaex402_c.so")
+ *   lib.aex402_simulate_swap_batch.argtypes = [ctypes.c_size_t] + [ctypes.c_void_p] * 7
+ *   lib.aex402_simulate_swap_batch.restype = ctypes.c_size_t
+ *   out = np.empty(n, dtype=np.uint64)
+ *   lib.aex402_simulate_swap_batch(n, bal_in.ctypes.data, bal_out.ctypes.data,
+ *       amount.ctypes.data, amp.ctypes.data, fee.ctypes.data, out.ctypes.data, None)
+ *
+ *   pool_info = np.dtype([
+ *       ("amp", "<u8"), ("target_amp", "<u8"), ("ramp_stop", "<i8"),
+ *       ("fee_bps", "<u8"), ("admin_fee_pct", "<u8"), ("bal0", "<u8"),
+ *       ("bal1", "<u8"), ("lp_supply", "<u8"), ("vol0", "<u8"), ("vol1", "<u8"),
+ *       ("trade_count", "<u8"), ("trade_sum", "<u8"),
+ *       ("mint0", "u1", 32), ("mint1", "u1", 32),
+ *       ("valid", "u1"), ("paused", "u1"), ("_pad", "u1", 6)])  # 168 bytes
+ *   lib.aex402_parse_pools_batch.argtypes = [ctypes.c_void_p, ctypes.c_size_t,
+ *       ctypes.c_size_t, ctypes.c_int64, ctypes.c_void_p]
+ *   lib.aex402_parse_pools_batch.restype = ctypes.c_size_t
+ *   info = np.empty(count, dtype=pool_info)
+ *   lib.aex402_parse_pools_batch(raw.ctypes.data, raw.shape[1], count, now, info.ctypes.data)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(AEX402_C_BUILDING)
+#    define AEX402_C_API __declspec(dllexport)
+#  else
+#    define AEX402_C_API __declspec(dllimport)
+#  endif
+#else
+#  define AEX402_C_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped on any incompatible change to a signature or struct layout */
+#define AEX402_C_ABI_VERSION 1
+
+/**
+ * Summary of one Pool account, as written by aex402_parse_pools_batch.
+ * All fields are naturally aligned; the struct is 168 bytes with no
+ * implicit padding, so it maps directly onto a NumPy structured dtype.
+ */
+typedef struct aex402_pool_info {
+    uint64_t amp;               /* Effective amp at `now` (ramp applied) */
+    uint64_t target_amp;
+    int64_t  ramp_stop;
+    uint64_t fee_bps;
+    uint64_t admin_fee_pct;
+    uint64_t bal0;
+    uint64_t bal1;
+    uint64_t lp_supply;
+    uint64_t vol0;
+    uint64_t vol1;
+    uint64_t trade_count;
+    uint64_t trade_sum;
+    uint8_t  mint0[32];
+    uint8_t  mint1[32];
+    uint8_t  valid;             /* 1 if the record parsed as a Pool */
+    uint8_t  paused;
+    uint8_t  _pad[6];
+} aex402_pool_info;
+
+/**
+ * ABI version the library was built with (AEX402_C_ABI_VERSION).
+ */
+AEX402_C_API uint32_t aex402_abi_version(void);
+
+/**
+ * Two-token StableSwap quotes, fees included:
+ *   amount_out[i] = simulate_swap(bal_in[i], bal_out[i], amount_in[i], amp[i], fee_bps[i])
+ * `ok` may be NULL.
+ */
+AEX402_C_API size_t aex402_simulate_swap_batch(size_t n,
+                                               const uint64_t* bal_in,
+                                               const uint64_t* bal_out,
+                                               const uint64_t* amount_in,
+                                               const uint64_t* amp,
+                                               const uint64_t* fee_bps,
+                                               uint64_t* amount_out,
+                                               uint8_t* ok);
+
+/**
+ * Two-token StableSwap invariant: d[i] = calc_d(x[i], y[i], amp[i]).
+ * `ok` may be NULL.
+ */
+AEX402_C_API size_t aex402_calc_d_batch(size_t n,
+                                        const uint64_t* x,
+                                        const uint64_t* y,
+                                        const uint64_t* amp,
+                                        uint64_t* d,
+                                        uint8_t* ok);
+
+/**
+ * Parse `count` Pool accounts laid out `stride` bytes apart starting at
+ * `data` (e.g. a count x 1024 uint8 array of raw account data). Records
+ * that are too short or carry another discriminator get valid = 0.
+ * `now` (Unix seconds) resolves amps that are mid-ramp.
+ */
+AEX402_C_API size_t aex402_parse_pools_batch(const uint8_t* data,
+                                             size_t stride,
+                                             size_t count,
+                                             int64_t now,
+                                             aex402_pool_info* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AEX402_C_H */
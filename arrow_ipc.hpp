@@ -0,0 +1,731 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Arrow IPC Export
+ *
+ * Dependency-free writer for the Apache Arrow IPC file format (the format
+ * read by pyarrow.ipc.open_file, pandas.read_feather, polars, DuckDB),
+ * fed directly from the packed account structs.
+ *
+ * Columns are declared against the layout tables in layout.hpp:
+ * - Integer fields become Int columns of the same width and signedness
+ * - Pubkey fields are dictionary-encoded: int32 indices into one base58
+ *   utf8 dictionary shared by every pubkey column of the file
+ * - Other arrays (bloom, candles, tick bitmap) become FixedSizeBinary
+ * - Array fields such as NPool::balances can be flattened to one column
+ *   per element with add_each()
+ *
+ * Rows are buffered per column and written as a RecordBatch every
+ * batch_rows rows. The dictionary is written once by finish(); readers
+ * locate it through the footer, so it may follow the record batches.
+ *
+ * Usage:
+ *   auto w = arrow::ArrowWriter::create("pools.arrow", arrow::pool_schema());
+ *   for (size_t i = 0; i < n; i++) w->append(keys[i], pools[i]);
+ *   w->finish();
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+#include "layout.hpp"
+#include "pda.hpp"
+#include "pubkey_map.hpp"
+
+namespace aex402 {
+namespace arrow {
+
+// ============================================================================
+// Flatbuffer Encoding
+// ============================================================================
+
+namespace detail {
+
+// Arrow metadata enums (Schema.fbs / Message.fbs)
+constexpr int16_t METADATA_V5 = 4;
+constexpr uint8_t HEADER_SCHEMA = 1;
+constexpr uint8_t HEADER_DICTIONARY_BATCH = 2;
+constexpr uint8_t HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_INT = 2;
+constexpr uint8_t TYPE_UTF8 = 5;
+constexpr uint8_t TYPE_FIXED_SIZE_BINARY = 15;
+
+constexpr uint8_t FILE_MAGIC[6] = {'A', 'R', 'R', 'O', 'W', '1'};
+constexpr uint32_t CONTINUATION = 0xFFFFFFFF;
+
+inline size_t pad8(size_t n) { return (n + 7) & ~size_t(7); }
+
+/**
+ * Minimal back-to-front flatbuffer builder.
+ *
+ * Objects are prepended, so children must be created before the tables
+ * that reference them. Offsets are distances from the end of the buffer.
+ * Only what Arrow metadata needs: scalars, strings, vectors of offsets,
+ * vectors of structs and one open table at a time.
+ */
+class FlatBuilder {
+public:
+    uint32_t size() const { return static_cast<uint32_t>(buf_.size() - head_); }
+
+    // Pad so that `len` more bytes end on an `alignment` boundary
+    void align(size_t len, size_t alignment) {
+        if (alignment > min_align_) min_align_ = alignment;
+        size_t pad = (alignment - (size() + len) % alignment) % alignment;
+        if (pad == 0) return;
+        reserve(pad);
+        head_ -= pad;
+        std::memset(&buf_[head_], 0, pad);
+    }
+
+    void push_bytes(const void* p, size_t n) {
+        if (n == 0) return;
+        reserve(n);
+        head_ -= n;
+        std::memcpy(&buf_[head_], p, n);
+    }
+
+    template <typename T>
+    void push(T v) {
+        reserve(sizeof(T));
+        head_ -= sizeof(T);
+        aex402::detail::store_le<T>(&buf_[head_], v);
+    }
+
+    uint32_t create_string(const std::string& s) {
+        align(s.size() + 1, 4);
+        push<uint8_t>(0);
+        push_bytes(s.data(), s.size());
+        push<uint32_t>(static_cast<uint32_t>(s.size()));
+        return size();
+    }
+
+    uint32_t create_offset_vector(const std::vector<uint32_t>& offsets) {
+        align(offsets.size() * 4, 4);
+        for (size_t i = offsets.size(); i-- > 0;) push<uint32_t>(size() + 4 - offsets[i]);
+        push<uint32_t>(static_cast<uint32_t>(offsets.size()));
+        return size();
+    }
+
+    // Vector of fixed-size structs given as raw little-endian bytes
+    uint32_t create_struct_vector(const std::vector<uint8_t>& bytes, size_t count, size_t struct_align) {
+        align(bytes.size(), struct_align < 4 ? 4 : struct_align);
+        push_bytes(bytes.data(), bytes.size());
+        push<uint32_t>(static_cast<uint32_t>(count));
+        return size();
+    }
+
+    void start_table() {
+        fields_.clear();
+        table_start_ = size();
+    }
+
+    template <typename T>
+    void add_scalar(uint16_t id, T v) {
+        align(sizeof(T), sizeof(T));
+        push<T>(v);
+        fields_.push_back({id, size()});
+    }
+
+    void add_offset(uint16_t id, uint32_t target) {
+        align(4, 4);
+        push<uint32_t>(size() + 4 - target);
+        fields_.push_back({id, size()});
+    }
+
+    uint32_t end_table() {
+        align(4, 4);
+        push<int32_t>(0);  // soffset to vtable, patched below
+        uint32_t table = size();
+
+        size_t n = 0;
+        for (const auto& f : fields_) n = std::max<size_t>(n, f.id + 1u);
+        std::vector<uint16_t> slots(n, 0);
+        for (const auto& f : fields_) slots[f.id] = static_cast<uint16_t>(table - f.off);
+
+        for (size_t i = n; i-- > 0;) push<uint16_t>(slots[i]);
+        push<uint16_t>(static_cast<uint16_t>(table - table_start_));
+        push<uint16_t>(static_cast<uint16_t>(4 + 2 * n));
+        uint32_t vtable = size();
+
+        aex402::detail::store_le<int32_t>(&buf_[buf_.size() - table],
+                                          static_cast<int32_t>(vtable - table));
+        fields_.clear();
+        return table;
+    }
+
+    std::vector<uint8_t> finish(uint32_t root) {
+        align(4, min_align_);
+        push<uint32_t>(size() + 4 - root);
+        return std::vector<uint8_t>(buf_.begin() + static_cast<std::ptrdiff_t>(head_), buf_.end());
+    }
+
+private:
+    struct FieldLoc {
+        uint16_t id;
+        uint32_t off;
+    };
+
+    std::vector<uint8_t> buf_;
+    size_t head_ = 0;
+    size_t min_align_ = 4;
+    uint32_t table_start_ = 0;
+    std::vector<FieldLoc> fields_;
+
+    void reserve(size_t n) {
+        if (head_ >= n) return;
+        size_t used = size();
+        size_t cap = std::max(std::max<size_t>(buf_.size() * 2, 256), used + n);
+        std::vector<uint8_t> grown(cap);
+        if (used > 0) std::memcpy(&grown[cap - used], &buf_[head_], used);
+        buf_.swap(grown);
+        head_ = cap - used;
+    }
+};
+
+/**
+ * Location of one message in the file (Footer Block struct).
+ */
+struct Block {
+    int64_t offset;
+    int32_t meta_len;   // Prefix + padded flatbuffer
+    int64_t body_len;
+};
+
+inline uint32_t create_blocks(FlatBuilder& b, const std::vector<Block>& blocks) {
+    std::vector<uint8_t> raw(blocks.size() * 24, 0);
+    for (size_t i = 0; i < blocks.size(); i++) {
+        uint8_t* p = &raw[i * 24];
+        aex402::detail::store_le<int64_t>(p, blocks[i].offset);
+        aex402::detail::store_le<int32_t>(p + 8, blocks[i].meta_len);
+        aex402::detail::store_le<int64_t>(p + 16, blocks[i].body_len);
+    }
+    return b.create_struct_vector(raw, blocks.size(), 8);
+}
+
+// FieldNode and Buffer are both a pair of int64s
+inline uint32_t create_pairs(FlatBuilder& b, const std::vector<std::pair<int64_t, int64_t>>& v) {
+    std::vector<uint8_t> raw(v.size() * 16);
+    for (size_t i = 0; i < v.size(); i++) {
+        aex402::detail::store_le<int64_t>(&raw[i * 16], v[i].first);
+        aex402::detail::store_le<int64_t>(&raw[i * 16 + 8], v[i].second);
+    }
+    return b.create_struct_vector(raw, v.size(), 8);
+}
+
+inline uint32_t create_int_type(FlatBuilder& b, int32_t bits, bool is_signed) {
+    b.start_table();
+    b.add_scalar<int32_t>(0, bits);
+    b.add_scalar<uint8_t>(1, is_signed ? 1 : 0);
+    return b.end_table();
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Schema
+// ============================================================================
+
+enum class ColumnKind : uint8_t {
+    Int,            // Signed integer
+    UInt,           // Unsigned integer
+    Pubkey,         // Dictionary-encoded base58 string
+    FixedBinary,    // Raw bytes
+};
+
+/**
+ * One exported column: `width` bytes at `offset` in the record.
+ */
+struct Column {
+    static constexpr uint32_t ADDRESS = UINT32_MAX;  // Offset of the account address
+
+    std::string name;
+    ColumnKind kind;
+    uint32_t offset;
+    uint32_t width;
+
+    // Bytes per row in the column buffer
+    uint32_t stored_width() const { return kind == ColumnKind::Pubkey ? 4 : width; }
+};
+
+/**
+ * Column list for one record type, built from layout.hpp field descriptors.
+ */
+class TableSchema {
+public:
+    /**
+     * @param record_size  sizeof the packed struct appended to the table
+     * @param with_address Prepend an "address" column holding the account key
+     */
+    explicit TableSchema(size_t record_size, bool with_address = true)
+        : record_size_(record_size) {
+        if (with_address) {
+            columns_.push_back({"address", ColumnKind::Pubkey, Column::ADDRESS, 32});
+        }
+    }
+
+    /**
+     * Add layout field F as one column. A 32-byte byte array is a Pubkey.
+     */
+    template <typename F>
+    TableSchema& add(std::string name) {
+        add_typed<typename F::type>(std::move(name), F::offset);
+        return *this;
+    }
+
+    /**
+     * Add each element of array field F as its own column (prefix_0, prefix_1, ...).
+     */
+    template <typename F>
+    TableSchema& add_each(const std::string& prefix) {
+        using E = typename F::type::value_type;
+        for (size_t i = 0; i < std::tuple_size<typename F::type>::value; i++) {
+            add_typed<E>(prefix + "_" + std::to_string(i), F::offset + i * sizeof(E));
+        }
+        return *this;
+    }
+
+    const std::vector<Column>& columns() const { return columns_; }
+    size_t record_size() const { return record_size_; }
+
+    bool has_pubkeys() const {
+        for (const auto& c : columns_) {
+            if (c.kind == ColumnKind::Pubkey) return true;
+        }
+        return false;
+    }
+
+private:
+    size_t record_size_;
+    std::vector<Column> columns_;
+
+    template <typename T>
+    void add_typed(std::string name, size_t offset) {
+        ColumnKind kind;
+        if constexpr (std::is_integral_v<T>) {
+            kind = std::is_signed_v<T> ? ColumnKind::Int : ColumnKind::UInt;
+        } else if constexpr (std::is_same_v<T, Pubkey>) {
+            kind = ColumnKind::Pubkey;
+        } else {
+            kind = ColumnKind::FixedBinary;
+        }
+        columns_.push_back({std::move(name), kind, static_cast<uint32_t>(offset),
+                            static_cast<uint32_t>(sizeof(T))});
+    }
+};
+
+/**
+ * Pool: every field except the discriminator and padding.
+ */
+inline TableSchema pool_schema() {
+    namespace L = layout::pool;
+    TableSchema s(sizeof(Pool));
+    s.add<L::authority>("authority").add<L::mint0>("mint0").add<L::mint1>("mint1")
+     .add<L::vault0>("vault0").add<L::vault1>("vault1").add<L::lp_mint>("lp_mint")
+     .add<L::amp>("amp").add<L::init_amp>("init_amp").add<L::target_amp>("target_amp")
+     .add<L::ramp_start>("ramp_start").add<L::ramp_stop>("ramp_stop")
+     .add<L::fee_bps>("fee_bps").add<L::admin_fee_pct>("admin_fee_pct")
+     .add<L::bal0>("bal0").add<L::bal1>("bal1").add<L::lp_supply>("lp_supply")
+     .add<L::admin_fee0>("admin_fee0").add<L::admin_fee1>("admin_fee1")
+     .add<L::vol0>("vol0").add<L::vol1>("vol1")
+     .add<L::paused>("paused").add<L::bump>("bump").add<L::v0_bump>("v0_bump")
+     .add<L::v1_bump>("v1_bump").add<L::lp_bump>("lp_bump")
+     .add<L::pending_auth>("pending_auth").add<L::auth_time>("auth_time")
+     .add<L::pending_amp>("pending_amp").add<L::amp_time>("amp_time")
+     .add<L::trade_count>("trade_count").add<L::trade_sum>("trade_sum")
+     .add<L::max_price>("max_price").add<L::min_price>("min_price")
+     .add<L::hour_slot>("hour_slot").add<L::day_slot>("day_slot")
+     .add<L::hour_idx>("hour_idx").add<L::day_idx>("day_idx")
+     .add<L::bloom>("bloom").add<L::hours>("hours").add<L::days>("days");
+    return s;
+}
+
+/**
+ * NPool: per-token arrays flattened to mint_0..mint_7, balance_0..balance_7, etc.
+ */
+inline TableSchema npool_schema() {
+    namespace L = layout::npool;
+    TableSchema s(sizeof(NPool));
+    s.add<L::authority>("authority").add<L::n_tokens>("n_tokens")
+     .add<L::paused>("paused").add<L::bump>("bump")
+     .add<L::amp>("amp").add<L::fee_bps>("fee_bps").add<L::admin_fee_pct>("admin_fee_pct")
+     .add<L::lp_supply>("lp_supply")
+     .add_each<L::mints>("mint").add_each<L::vaults>("vault").add<L::lp_mint>("lp_mint")
+     .add_each<L::balances>("balance").add_each<L::admin_fees>("admin_fee")
+     .add<L::total_volume>("total_volume").add<L::trade_count>("trade_count")
+     .add<L::last_trade_slot>("last_trade_slot");
+    return s;
+}
+
+inline TableSchema farm_schema() {
+    namespace L = layout::farm;
+    TableSchema s(sizeof(Farm));
+    s.add<L::pool>("pool").add<L::reward_mint>("reward_mint")
+     .add<L::reward_rate>("reward_rate").add<L::start_time>("start_time")
+     .add<L::end_time>("end_time").add<L::total_staked>("total_staked")
+     .add<L::acc_reward>("acc_reward").add<L::last_update>("last_update");
+    return s;
+}
+
+/**
+ * CLPool: every field except the discriminator, padding and reserved space.
+ */
+inline TableSchema clpool_schema() {
+    namespace L = layout::clpool;
+    TableSchema s(sizeof(CLPool));
+    s.add<L::pool>("pool").add<L::authority>("authority")
+     .add<L::tick_lower>("tick_lower").add<L::tick_upper>("tick_upper")
+     .add<L::current_tick>("current_tick").add<L::initialized>("initialized")
+     .add<L::sqrt_price>("sqrt_price").add<L::liquidity>("liquidity")
+     .add<L::fee_growth_0>("fee_growth_0").add<L::fee_growth_1>("fee_growth_1")
+     .add<L::tick_bitmap>("tick_bitmap");
+    return s;
+}
+
+// ============================================================================
+// ArrowWriter
+// ============================================================================
+
+/**
+ * Streams records into an Arrow IPC file (or an in-memory buffer).
+ * I/O errors are sticky: append() and finish() return false once one occurs.
+ */
+class ArrowWriter {
+public:
+    static constexpr size_t DEFAULT_BATCH_ROWS = 65536;
+
+    /**
+     * Open path for writing. Returns nullopt if the file cannot be created.
+     */
+    static std::optional<ArrowWriter> create(const std::string& path, TableSchema schema,
+                                             size_t batch_rows = DEFAULT_BATCH_ROWS) {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return std::nullopt;
+        ArrowWriter w(std::move(schema), batch_rows);
+        w.file_ = f;
+        w.start();
+        return w;
+    }
+
+    /**
+     * Write into memory; the file bytes are available from buffer().
+     */
+    static ArrowWriter in_memory(TableSchema schema, size_t batch_rows = DEFAULT_BATCH_ROWS) {
+        ArrowWriter w(std::move(schema), batch_rows);
+        w.start();
+        return w;
+    }
+
+    ArrowWriter(ArrowWriter&& o) noexcept { *this = std::move(o); }
+
+    ArrowWriter& operator=(ArrowWriter&& o) noexcept {
+        if (this != &o) {
+            close();
+            schema_ = std::move(o.schema_);
+            batch_rows_ = o.batch_rows_;
+            file_ = std::exchange(o.file_, nullptr);
+            mem_ = std::move(o.mem_);
+            pos_ = o.pos_;
+            ok_ = o.ok_;
+            finished_ = o.finished_;
+            columns_ = std::move(o.columns_);
+            batch_len_ = o.batch_len_;
+            rows_ = o.rows_;
+            dict_index_ = std::move(o.dict_index_);
+            dict_keys_ = std::move(o.dict_keys_);
+            dict_blocks_ = std::move(o.dict_blocks_);
+            batch_blocks_ = std::move(o.batch_blocks_);
+        }
+        return *this;
+    }
+
+    ArrowWriter(const ArrowWriter&) = delete;
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+    // Closes without a footer if finish() was not called
+    ~ArrowWriter() { close(); }
+
+    const TableSchema& schema() const { return schema_; }
+    bool ok() const { return ok_; }
+    uint64_t rows() const { return rows_; }
+    size_t batches() const { return batch_blocks_.size(); }
+    size_t dictionary_size() const { return dict_keys_.size(); }
+    uint64_t bytes_written() const { return pos_; }
+    const std::vector<uint8_t>& buffer() const { return mem_; }
+
+    /**
+     * Append one record. Returns false if sizeof(T) does not match the schema.
+     */
+    template <typename T>
+    bool append(const Pubkey& address, const T& record) {
+        static_assert(std::is_trivially_copyable_v<T>, "records must be packed account structs");
+        if (sizeof(T) != schema_.record_size()) return false;
+        return append_raw(address, reinterpret_cast<const uint8_t*>(&record));
+    }
+
+    /**
+     * Append one record from raw bytes (at least schema().record_size() bytes).
+     */
+    bool append_raw(const Pubkey& address, const uint8_t* record) {
+        if (!ok_ || finished_) return false;
+        const auto& cols = schema_.columns();
+        for (size_t c = 0; c < cols.size(); c++) {
+            const Column& col = cols[c];
+            uint8_t* dst = &columns_[c][batch_len_ * col.stored_width()];
+            if (col.kind == ColumnKind::Pubkey) {
+                Pubkey key = address;
+                if (col.offset != Column::ADDRESS) std::memcpy(key.data(), record + col.offset, 32);
+                aex402::detail::store_le<int32_t>(dst, dictionary_index(key));
+            } else {
+                std::memcpy(dst, record + col.offset, col.width);
+            }
+        }
+        rows_++;
+        if (++batch_len_ == batch_rows_) flush_batch();
+        return ok_;
+    }
+
+    /**
+     * Flush the open batch and write the dictionary, footer and trailer.
+     */
+    bool finish() {
+        if (finished_) return ok_;
+        if (batch_len_ > 0) flush_batch();
+        if (schema_.has_pubkeys()) write_dictionary();
+
+        write_u32(detail::CONTINUATION);  // End-of-stream marker
+        write_u32(0);
+
+        detail::FlatBuilder b;
+        uint32_t schema = encode_schema(b);
+        uint32_t dicts = detail::create_blocks(b, dict_blocks_);
+        uint32_t batches = detail::create_blocks(b, batch_blocks_);
+        b.start_table();
+        b.add_offset(1, schema);
+        b.add_offset(2, dicts);
+        b.add_offset(3, batches);
+        b.add_scalar<int16_t>(0, detail::METADATA_V5);
+        std::vector<uint8_t> footer = b.finish(b.end_table());
+
+        write(footer.data(), footer.size());
+        write_u32(static_cast<uint32_t>(footer.size()));
+        write(detail::FILE_MAGIC, sizeof(detail::FILE_MAGIC));
+
+        finished_ = true;
+        if (file_ && std::fflush(file_) != 0) ok_ = false;
+        return ok_;
+    }
+
+private:
+    TableSchema schema_{0, false};
+    size_t batch_rows_ = DEFAULT_BATCH_ROWS;
+    std::FILE* file_ = nullptr;
+    std::vector<uint8_t> mem_;
+    uint64_t pos_ = 0;
+    bool ok_ = true;
+    bool finished_ = false;
+
+    std::vector<std::vector<uint8_t>> columns_;     // One buffer per column
+    size_t batch_len_ = 0;
+    uint64_t rows_ = 0;
+
+    PubkeyMap<int32_t> dict_index_;
+    std::vector<Pubkey> dict_keys_;
+    std::vector<detail::Block> dict_blocks_;
+    std::vector<detail::Block> batch_blocks_;
+
+    ArrowWriter(TableSchema schema, size_t batch_rows)
+        : schema_(std::move(schema)), batch_rows_(batch_rows > 0 ? batch_rows : 1) {
+        for (const auto& c : schema_.columns()) {
+            columns_.emplace_back(batch_rows_ * c.stored_width());
+        }
+    }
+
+    void close() {
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    void write(const void* p, size_t n) {
+        if (!ok_ || n == 0) return;
+        if (file_) {
+            if (std::fwrite(p, 1, n, file_) != n) ok_ = false;
+        } else {
+            const auto* b = static_cast<const uint8_t*>(p);
+            mem_.insert(mem_.end(), b, b + n);
+        }
+        pos_ += n;
+    }
+
+    void write_u32(uint32_t v) {
+        uint8_t b[4];
+        aex402::detail::store_le<uint32_t>(b, v);
+        write(b, 4);
+    }
+
+    void write_zeros(size_t n) {
+        static const uint8_t zeros[8] = {};
+        write(zeros, n);
+    }
+
+    void start() {
+        write(detail::FILE_MAGIC, sizeof(detail::FILE_MAGIC));
+        write_zeros(2);
+        detail::FlatBuilder b;
+        uint32_t schema = encode_schema(b);
+        write_message(b, detail::HEADER_SCHEMA, schema, {});
+    }
+
+    int32_t dictionary_index(const Pubkey& key) {
+        auto [idx, inserted] = dict_index_.try_emplace(key, static_cast<int32_t>(dict_keys_.size()));
+        if (inserted) dict_keys_.push_back(key);
+        return *idx;
+    }
+
+    uint32_t encode_schema(detail::FlatBuilder& b) const {
+        std::vector<uint32_t> fields;
+        for (const auto& col : schema_.columns()) {
+            uint32_t name = b.create_string(col.name);
+            uint32_t children = b.create_offset_vector({});
+
+            uint8_t type_type;
+            uint32_t type;
+            uint32_t dict = 0;
+            switch (col.kind) {
+                case ColumnKind::Int:
+                case ColumnKind::UInt:
+                    type_type = detail::TYPE_INT;
+                    type = detail::create_int_type(b, static_cast<int32_t>(col.width * 8),
+                                                   col.kind == ColumnKind::Int);
+                    break;
+                case ColumnKind::Pubkey: {
+                    type_type = detail::TYPE_UTF8;
+                    b.start_table();
+                    type = b.end_table();
+                    uint32_t index_type = detail::create_int_type(b, 32, true);
+                    b.start_table();
+                    b.add_scalar<int64_t>(0, 0);  // Dictionary id
+                    b.add_offset(1, index_type);
+                    b.add_scalar<uint8_t>(2, 0);  // isOrdered
+                    dict = b.end_table();
+                    break;
+                }
+                case ColumnKind::FixedBinary:
+                default:
+                    type_type = detail::TYPE_FIXED_SIZE_BINARY;
+                    b.start_table();
+                    b.add_scalar<int32_t>(0, static_cast<int32_t>(col.width));
+                    type = b.end_table();
+                    break;
+            }
+
+            b.start_table();
+            b.add_offset(0, name);
+            b.add_offset(3, type);
+            if (dict) b.add_offset(4, dict);
+            b.add_offset(5, children);
+            b.add_scalar<uint8_t>(1, 0);  // nullable
+            b.add_scalar<uint8_t>(2, type_type);
+            fields.push_back(b.end_table());
+        }
+        uint32_t field_vec = b.create_offset_vector(fields);
+        b.start_table();
+        b.add_offset(1, field_vec);
+        b.add_scalar<int16_t>(0, 0);  // Little endian
+        return b.end_table();
+    }
+
+    using BufferRef = std::pair<const uint8_t*, size_t>;
+
+    // RecordBatch table for `length` rows; buffers are laid out back to back, 8-aligned
+    static uint32_t encode_record_batch(detail::FlatBuilder& b, int64_t length, size_t n_fields,
+                                        const std::vector<BufferRef>& buffers) {
+        std::vector<std::pair<int64_t, int64_t>> nodes(n_fields, {length, 0});
+        std::vector<std::pair<int64_t, int64_t>> spans;
+        int64_t off = 0;
+        for (const auto& buf : buffers) {
+            spans.push_back({off, static_cast<int64_t>(buf.second)});
+            off += static_cast<int64_t>(detail::pad8(buf.second));
+        }
+        uint32_t node_vec = detail::create_pairs(b, nodes);
+        uint32_t buffer_vec = detail::create_pairs(b, spans);
+        b.start_table();
+        b.add_scalar<int64_t>(0, length);
+        b.add_offset(1, node_vec);
+        b.add_offset(2, buffer_vec);
+        return b.end_table();
+    }
+
+    detail::Block write_message(detail::FlatBuilder& b, uint8_t header_type, uint32_t header,
+                                const std::vector<BufferRef>& buffers) {
+        int64_t body_len = 0;
+        for (const auto& buf : buffers) body_len += static_cast<int64_t>(detail::pad8(buf.second));
+
+        b.start_table();
+        b.add_scalar<int64_t>(3, body_len);
+        b.add_offset(2, header);
+        b.add_scalar<int16_t>(0, detail::METADATA_V5);
+        b.add_scalar<uint8_t>(1, header_type);
+        std::vector<uint8_t> meta = b.finish(b.end_table());
+
+        detail::Block block{static_cast<int64_t>(pos_), 0, body_len};
+        size_t meta_len = detail::pad8(meta.size());
+        block.meta_len = static_cast<int32_t>(8 + meta_len);
+        write_u32(detail::CONTINUATION);
+        write_u32(static_cast<uint32_t>(meta_len));
+        write(meta.data(), meta.size());
+        write_zeros(meta_len - meta.size());
+        for (const auto& buf : buffers) {
+            write(buf.first, buf.second);
+            write_zeros(detail::pad8(buf.second) - buf.second);
+        }
+        return block;
+    }
+
+    void flush_batch() {
+        const auto& cols = schema_.columns();
+        std::vector<BufferRef> buffers;
+        buffers.reserve(cols.size() * 2);
+        for (size_t c = 0; c < cols.size(); c++) {
+            buffers.push_back({nullptr, 0});  // No validity bitmap: no nulls
+            buffers.push_back({columns_[c].data(), batch_len_ * cols[c].stored_width()});
+        }
+        detail::FlatBuilder b;
+        uint32_t batch = encode_record_batch(b, static_cast<int64_t>(batch_len_), cols.size(), buffers);
+        batch_blocks_.push_back(write_message(b, detail::HEADER_RECORD_BATCH, batch, buffers));
+        batch_len_ = 0;
+    }
+
+    void write_dictionary() {
+        std::vector<uint8_t> offsets((dict_keys_.size() + 1) * 4);
+        std::string values;
+        values.reserve(dict_keys_.size() * 44);
+        for (size_t i = 0; i < dict_keys_.size(); i++) {
+            values += pda::base58_encode(dict_keys_[i]);
+            aex402::detail::store_le<int32_t>(&offsets[(i + 1) * 4], static_cast<int32_t>(values.size()));
+        }
+        std::vector<BufferRef> buffers = {
+            {nullptr, 0},
+            {offsets.data(), offsets.size()},
+            {reinterpret_cast<const uint8_t*>(values.data()), values.size()},
+        };
+
+        detail::FlatBuilder b;
+        uint32_t data = encode_record_batch(b, static_cast<int64_t>(dict_keys_.size()), 1, buffers);
+        b.start_table();
+        b.add_scalar<int64_t>(0, 0);  // Dictionary id
+        b.add_offset(1, data);
+        b.add_scalar<uint8_t>(2, 0);  // isDelta
+        uint32_t dict = b.end_table();
+        dict_blocks_.push_back(write_message(b, detail::HEADER_DICTIONARY_BATCH, dict, buffers));
+    }
+};
+
+}  // namespace arrow
+}  // namespace aex402
@@ -0,0 +1,231 @@
+/**
+ * AeX402 AMM C++ SDK Benchmarks
+ *
+ * Times the SDK's hot kernels and, where the host allows it, reads
+ * hardware counters around each one (see perf_counters.hpp) to report
+ * IPC, branch misses and cache misses per operation.
+ *
+ * Build:
+ *   cmake -DAEX402_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release ..
+ *   make aex402_benchmark
+ *   ./aex402_benchmark [filter] [--min-ms N]
+ *
+ * Counters need kernel.perf_event_paranoid <= 2 (user-space counting)
+ * and a PMU visible to the host; otherwise only wall time is shown.
+ */
+
+#include "aex402.hpp"
+#include "perf_counters.hpp"
+#include "synthetic.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace aex402;
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+template <typename T>
+inline void do_not_optimize(const T& v) {
+    asm volatile("" : : "r,m"(v) : "memory");
+}
+
+struct BenchConfig {
+    const char* filter = nullptr;
+    double min_ms = 100.0;  // Target duration of each measured run
+    int runs = 5;           // Best run is reported
+};
+
+class Bench {
+public:
+    explicit Bench(BenchConfig cfg) : cfg_(cfg) {
+        if (!pc_.available()) {
+            std::printf("Hardware counters unavailable (%s); reporting wall time only\n\n",
+                        pc_.error().c_str());
+        }
+        std::printf("%-26s %10s %10s %7s %10s %10s %10s\n",
+                    "kernel", "ns/op", "cyc/op", "IPC", "brmiss/op", "L1dmiss/op", "LLCmiss/op");
+    }
+
+    /**
+     * Measure fn(i) called for i in [0, n); each call is one operation.
+     */
+    template <typename Fn>
+    void run(const char* name, Fn&& fn) {
+        if (cfg_.filter && !std::strstr(name, cfg_.filter)) return;
+
+        // Grow the iteration count until one run takes ~min_ms
+        uint64_t n = 64;
+        for (;;) {
+            double ns = measure(fn, n).wall_ns;
+            if (ns >= cfg_.min_ms * 1e6 || n >= (uint64_t(1) << 34)) break;
+            double grow = ns > 0 ? cfg_.min_ms * 1e6 / ns * 1.2 : 16.0;
+            n = static_cast<uint64_t>(static_cast<double>(n) * (grow > 16.0 ? 16.0 : (grow < 2.0 ? 2.0 : grow)));
+        }
+
+        perf::CounterSample best;
+        best.wall_ns = -1.0;
+        for (int r = 0; r < cfg_.runs; r++) {
+            perf::CounterSample s = measure(fn, n);
+            if (best.wall_ns < 0 || s.wall_ns < best.wall_ns) best = s;
+        }
+        report(name, best, n);
+    }
+
+private:
+    BenchConfig cfg_;
+    perf::PerfCounters pc_;
+
+    template <typename Fn>
+    perf::CounterSample measure(Fn& fn, uint64_t n) {
+        pc_.start();
+        for (uint64_t i = 0; i < n; i++) fn(i);
+        return pc_.stop();
+    }
+
+    static void cell(const perf::CounterSample& s, perf::Counter c, uint64_t n, const char* fmt) {
+        if (s.has(c)) {
+            std::printf(fmt, s.per_op(c, n));
+        } else {
+            std::printf(" %10s", "-");
+        }
+    }
+
+    static void report(const char* name, const perf::CounterSample& s, uint64_t n) {
+        std::printf("%-26s %10.1f", name, s.wall_ns / static_cast<double>(n));
+        cell(s, perf::Counter::Cycles, n, " %10.1f");
+        if (s.has(perf::Counter::Cycles) && s.has(perf::Counter::Instructions)) {
+            std::printf(" %7.2f", s.ipc());
+        } else {
+            std::printf(" %7s", "-");
+        }
+        cell(s, perf::Counter::BranchMisses, n, " %10.3f");
+        cell(s, perf::Counter::L1dMisses, n, " %10.3f");
+        cell(s, perf::Counter::LlcMisses, n, " %10.3f");
+        std::printf("\n");
+    }
+};
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+constexpr size_t INPUTS = 1024;  // Power of two; inputs are cycled with i & (INPUTS - 1)
+
+/**
+ * Kernel inputs drawn from a synthetic universe (see synthetic.hpp), so
+ * balances, amps and trade sizes follow realistic distributions rather
+ * than a narrow uniform range.
+ */
+struct PoolInputs {
+    synthetic::Universe universe;
+    std::vector<std::vector<uint8_t>> accounts;
+    std::vector<std::array<uint64_t, MAX_TOKENS>> balances;
+    std::vector<uint64_t> amounts;
+    std::vector<uint64_t> amps;
+
+    explicit PoolInputs(uint64_t seed) {
+        synthetic::UniverseConfig cfg;
+        cfg.seed = seed;
+        cfg.pools = INPUTS;
+        cfg.npools = INPUTS;
+        universe = synthetic::generate_universe(cfg);
+
+        synthetic::Rng rng(seed);
+        for (size_t i = 0; i < INPUTS; i++) {
+            const auto& pool = universe.accounts[universe.pools[i]];
+            accounts.push_back(pool.data);
+            amps.push_back(layout::pool::amp::read(pool.data.data()));
+
+            // Two-token kernels use b[0], b[1]; N-token kernels cycle the
+            // NPool's balances out to MAX_TOKENS
+            const auto& npool = universe.accounts[universe.npools[i]];
+            auto nb = layout::npool::balances::read(npool.data.data());
+            uint8_t n = layout::npool::n_tokens::read(npool.data.data());
+            std::array<uint64_t, MAX_TOKENS> b{};
+            b[0] = layout::pool::bal0::read(pool.data.data());
+            b[1] = layout::pool::bal1::read(pool.data.data());
+            for (size_t t = 2; t < MAX_TOKENS; t++) b[t] = nb[t % n];
+            balances.push_back(b);
+            amounts.push_back(static_cast<uint64_t>(static_cast<double>(b[0]) * rng.log_uniform(1e-7, 1e-2)) + 1);
+        }
+    }
+};
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            cfg.min_ms = std::atof(argv[++i]);
+        } else {
+            cfg.filter = argv[i];
+        }
+    }
+
+    PoolInputs in(0x9E3779B97F4A7C15ULL);
+    Bench bench(cfg);
+    auto at = [](uint64_t i) { return static_cast<size_t>(i & (INPUTS - 1)); };
+
+    // Parsing
+    bench.run("parse_pool", [&](uint64_t i) {
+        const auto& a = in.accounts[at(i)];
+        do_not_optimize(parse_pool(a.data(), a.size()));
+    });
+    bench.run("parse_pool_safe", [&](uint64_t i) {
+        const auto& a = in.accounts[at(i)];
+        do_not_optimize(parse_pool_safe(a.data(), a.size()));
+    });
+    bench.run("view_pool + bal0", [&](uint64_t i) {
+        const auto& a = in.accounts[at(i)];
+        auto v = view_pool(a.data(), a.size());
+        do_not_optimize(v ? v->bal0() : 0);
+    });
+
+    // Invariant and swap math
+    bench.run("calc_d", [&](uint64_t i) {
+        const auto& b = in.balances[at(i)];
+        do_not_optimize(math::calc_d(b[0], b[1], in.amps[at(i)]));
+    });
+    bench.run("calc_d_n (n=4)", [&](uint64_t i) {
+        do_not_optimize(math::calc_d_n(in.balances[at(i)].data(), 4, in.amps[at(i)]));
+    });
+    bench.run("calc_d_n (n=8)", [&](uint64_t i) {
+        do_not_optimize(math::calc_d_n(in.balances[at(i)].data(), 8, in.amps[at(i)]));
+    });
+    bench.run("simulate_swap", [&](uint64_t i) {
+        const auto& b = in.balances[at(i)];
+        do_not_optimize(math::simulate_swap(b[0], b[1], in.amounts[at(i)], in.amps[at(i)], 4));
+    });
+    bench.run("simulate_swap_n (n=4)", [&](uint64_t i) {
+        do_not_optimize(math::simulate_swap_n(in.balances[at(i)].data(), 4, 0, 3,
+                                              in.amounts[at(i)], in.amps[at(i)], 4));
+    });
+
+    // Replaying a skewed swap stream over the whole universe
+    synthetic::SwapStream stream(in.universe, 1);
+    std::vector<synthetic::SwapEvent> events = stream.take(INPUTS * 16);
+    bench.run("apply_swap (stream)", [&](uint64_t i) {
+        const auto& ev = events[static_cast<size_t>(i % events.size())];
+        do_not_optimize(synthetic::apply_swap(in.universe.accounts[ev.account], ev));
+    });
+
+    // Encoding and signing
+    bench.run("encode swap", [&](uint64_t i) {
+        auto ix = InstructionBuilder::swap(0, 1, in.amounts[at(i)], 1, 0);
+        do_not_optimize(ix.raw());
+    });
+    ed25519::ExpandedKey key = ed25519::ExpandedKey::from_seed(in.accounts[0].data() + 8);
+    bench.run("ed25519 sign (64 B)", [&](uint64_t i) {
+        do_not_optimize(ed25519::sign(key, in.accounts[at(i)].data(), 64));
+    });
+
+    return 0;
+}
@@ -0,0 +1,340 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Compute Budget
+ *
+ * Instruction builders for the ComputeBudget program and a per-handler
+ * compute-unit estimator for sizing SetComputeUnitLimit.
+ *
+ * Priority fee = ceil(cu_limit * micro_lamports_per_cu / 1e6) lamports, so
+ * a tight limit buys more priority per lamport paid.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include "constants.hpp"
+#include "types.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// ComputeBudget Instruction Builder
+// ============================================================================
+
+/**
+ * Builder for ComputeBudget program instruction data.
+ * Instructions take no accounts; the program id is COMPUTE_BUDGET_PROGRAM_ID.
+ */
+class ComputeBudgetBuilder {
+public:
+    // Instruction tags (first byte of instruction data)
+    static constexpr uint8_t REQUEST_HEAP_FRAME = 1;
+    static constexpr uint8_t SET_COMPUTE_UNIT_LIMIT = 2;
+    static constexpr uint8_t SET_COMPUTE_UNIT_PRICE = 3;
+    static constexpr uint8_t SET_LOADED_ACCOUNTS_DATA_SIZE_LIMIT = 4;
+
+    ComputeBudgetBuilder() { data_.reserve(9); }
+
+    const std::vector<uint8_t>& data() const { return data_; }
+    std::vector<uint8_t> build() { return std::move(data_); }
+    const uint8_t* raw() const { return data_.data(); }
+    size_t size() const { return data_.size(); }
+
+    /**
+     * Request a larger heap frame (multiple of 1 KiB, at most 256 KiB).
+     */
+    static ComputeBudgetBuilder request_heap_frame(uint32_t bytes) {
+        ComputeBudgetBuilder b;
+        b.write_u8(REQUEST_HEAP_FRAME);
+        b.write_u32(bytes);
+        return b;
+    }
+
+    /**
+     * Set the transaction-wide compute unit limit.
+     */
+    static ComputeBudgetBuilder set_compute_unit_limit(uint32_t units) {
+        ComputeBudgetBuilder b;
+        b.write_u8(SET_COMPUTE_UNIT_LIMIT);
+        b.write_u32(units);
+        return b;
+    }
+
+    /**
+     * Set the compute unit price in micro-lamports (priority fee).
+     */
+    static ComputeBudgetBuilder set_compute_unit_price(uint64_t micro_lamports) {
+        ComputeBudgetBuilder b;
+        b.write_u8(SET_COMPUTE_UNIT_PRICE);
+        b.write_u64(micro_lamports);
+        return b;
+    }
+
+    /**
+     * Cap the total size of loaded account data.
+     */
+    static ComputeBudgetBuilder set_loaded_accounts_data_size_limit(uint32_t bytes) {
+        ComputeBudgetBuilder b;
+        b.write_u8(SET_LOADED_ACCOUNTS_DATA_SIZE_LIMIT);
+        b.write_u32(bytes);
+        return b;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+
+    void write_u8(uint8_t v) {
+        data_.push_back(v);
+    }
+
+    void write_u32(uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            data_.push_back(static_cast<uint8_t>(v & 0xFF));
+            v >>= 8;
+        }
+    }
+
+    void write_u64(uint64_t v) {
+        for (int i = 0; i < 8; i++) {
+            data_.push_back(static_cast<uint8_t>(v & 0xFF));
+            v >>= 8;
+        }
+    }
+};
+
+// ============================================================================
+// Priority Fee Helpers
+// ============================================================================
+
+/**
+ * Priority fee in lamports for a limit and price (rounded up, as charged).
+ */
+inline uint64_t priority_fee_lamports(uint32_t cu_limit, uint64_t micro_lamports_per_cu) {
+    __uint128_t total = static_cast<__uint128_t>(cu_limit) * micro_lamports_per_cu;
+    __uint128_t fee = (total + MICRO_LAMPORTS_PER_LAMPORT - 1) / MICRO_LAMPORTS_PER_LAMPORT;
+    return fee > UINT64_MAX ? UINT64_MAX : static_cast<uint64_t>(fee);
+}
+
+/**
+ * Highest micro-lamport price whose fee for cu_limit stays within budget.
+ */
+inline uint64_t cu_price_for_budget(uint64_t budget_lamports, uint32_t cu_limit) {
+    if (cu_limit == 0) return 0;
+    __uint128_t total = static_cast<__uint128_t>(budget_lamports) * MICRO_LAMPORTS_PER_LAMPORT;
+    __uint128_t price = total / cu_limit;
+    return price > UINT64_MAX ? UINT64_MAX : static_cast<uint64_t>(price);
+}
+
+// ============================================================================
+// Compute Unit Estimator
+// ============================================================================
+
+/**
+ * Linear CU model for one handler:
+ *   units = base + per_token * n_tokens + per_hop * hops + per_tick * ticks
+ */
+struct CuCost {
+    uint32_t base;
+    uint32_t per_token;
+    uint32_t per_hop;
+    uint32_t per_tick;
+};
+
+/**
+ * Inputs to the model that are not recoverable from instruction data.
+ */
+struct CuContext {
+    uint8_t n_tokens = 2;         // Pool token count (swapn, addliqn, remliqn)
+    uint8_t hops = 0;             // Route length (multihop)
+    uint32_t ticks_crossed = 0;   // Initialized ticks crossed (clswap)
+};
+
+namespace detail {
+
+struct CuTableEntry {
+    uint64_t disc;
+    CuCost cost;
+};
+
+// Default costs: conservative starting estimates, not measurements of
+// unitsConsumed. Calibrate with CuEstimator::set_cost from
+// simulateTransaction results before relying on them as limits.
+constexpr CuTableEntry DEFAULT_CU_TABLE[] = {
+    {disc::CREATEPOOL, {28000, 0, 0, 0}},
+    {disc::CREATEPN,   {30000, 3000, 0, 0}},
+    {disc::INITT0V,    {24000, 0, 0, 0}},
+    {disc::INITT1V,    {24000, 0, 0, 0}},
+    {disc::INITLPM,    {26000, 0, 0, 0}},
+
+    {disc::SWAP,       {42000, 0, 0, 0}},
+    {disc::SWAPT0T1,   {40000, 0, 0, 0}},
+    {disc::SWAPT1T0,   {40000, 0, 0, 0}},
+    {disc::SWAPN,      {30000, 9000, 0, 0}},
+    {disc::MIGT0T1,    {44000, 0, 0, 0}},
+    {disc::MIGT1T0,    {44000, 0, 0, 0}},
+
+    {disc::ADDLIQ,     {52000, 0, 0, 0}},
+    {disc::ADDLIQ1,    {56000, 0, 0, 0}},
+    {disc::ADDLIQN,    {34000, 14000, 0, 0}},
+    {disc::REMLIQ,     {46000, 0, 0, 0}},
+    {disc::REMLIQN,    {28000, 12000, 0, 0}},
+
+    {disc::SETPAUSE,   {6000, 0, 0, 0}},
+    {disc::UPDFEE,     {6000, 0, 0, 0}},
+    {disc::WDRAWFEE,   {30000, 0, 0, 0}},
+    {disc::COMMITAMP,  {6000, 0, 0, 0}},
+    {disc::RAMPAMP,    {7000, 0, 0, 0}},
+    {disc::STOPRAMP,   {6000, 0, 0, 0}},
+    {disc::INITAUTH,   {6000, 0, 0, 0}},
+    {disc::COMPLAUTH,  {6000, 0, 0, 0}},
+    {disc::CANCELAUTH, {6000, 0, 0, 0}},
+
+    {disc::CREATEFARM, {20000, 0, 0, 0}},
+    {disc::STAKELP,    {30000, 0, 0, 0}},
+    {disc::UNSTAKELP,  {30000, 0, 0, 0}},
+    {disc::CLAIMFARM,  {26000, 0, 0, 0}},
+    {disc::LOCKLP,     {28000, 0, 0, 0}},
+    {disc::CLAIMULP,   {26000, 0, 0, 0}},
+
+    {disc::CREATELOT,  {18000, 0, 0, 0}},
+    {disc::ENTERLOT,   {24000, 0, 0, 0}},
+    {disc::DRAWLOT,    {14000, 0, 0, 0}},
+    {disc::CLAIMLOT,   {24000, 0, 0, 0}},
+
+    {disc::INITREG,    {16000, 0, 0, 0}},
+    {disc::REGPOOL,    {9000, 0, 0, 0}},
+    {disc::UNREGPOOL,  {9000, 0, 0, 0}},
+    {disc::INITREGA,   {6000, 0, 0, 0}},
+    {disc::COMPLREGA,  {6000, 0, 0, 0}},
+    {disc::CANCELREGA, {6000, 0, 0, 0}},
+
+    {disc::GETTWAP,    {8000, 0, 0, 0}},
+    {disc::SETCB,      {6000, 0, 0, 0}},
+    {disc::RESETCB,    {6000, 0, 0, 0}},
+    {disc::SETRL,      {6000, 0, 0, 0}},
+    {disc::SETORACLE,  {6000, 0, 0, 0}},
+
+    {disc::GOVPROP,    {18000, 0, 0, 0}},
+    {disc::GOVVOTE,    {12000, 0, 0, 0}},
+    {disc::GOVEXEC,    {14000, 0, 0, 0}},
+    {disc::GOVCNCL,    {8000, 0, 0, 0}},
+
+    {disc::INITBOOK,   {20000, 0, 0, 0}},
+    {disc::PLACEORD,   {24000, 0, 0, 0}},
+    {disc::CANCELORD,  {18000, 0, 0, 0}},
+    {disc::FILLORD,    {34000, 0, 0, 0}},
+
+    {disc::INITCLPL,   {24000, 0, 0, 0}},
+    {disc::CLMINT,     {40000, 0, 0, 0}},
+    {disc::CLBURN,     {36000, 0, 0, 0}},
+    {disc::CLCOLLECT,  {28000, 0, 0, 0}},
+    {disc::CLSWAP,     {38000, 0, 0, 4500}},
+
+    {disc::FLASHLOAN,  {30000, 0, 0, 0}},
+    {disc::FLASHREPY,  {30000, 0, 0, 0}},
+
+    {disc::MULTIHOP,   {12000, 0, 36000, 0}},
+
+    {disc::INITML,     {16000, 0, 0, 0}},
+    {disc::CFGML,      {6000, 0, 0, 0}},
+    {disc::TRAINML,    {120000, 0, 0, 0}},
+    {disc::APPLYML,    {9000, 0, 0, 0}},
+    {disc::LOGML,      {8000, 0, 0, 0}},
+
+    {disc::TH_EXEC,    {9000, 0, 0, 0}},
+    {disc::TH_INIT,    {16000, 0, 0, 0}},
+};
+
+// Cost of each ComputeBudget instruction itself
+constexpr uint32_t COMPUTE_BUDGET_IX_CU = 150;
+
+}  // namespace detail
+
+/**
+ * Per-discriminator compute unit estimator.
+ * Starts from the built-in table; entries can be overridden per handler.
+ */
+class CuEstimator {
+public:
+    CuEstimator() {
+        costs_.reserve(sizeof(detail::DEFAULT_CU_TABLE) / sizeof(detail::DEFAULT_CU_TABLE[0]));
+        for (const auto& e : detail::DEFAULT_CU_TABLE) costs_[e.disc] = e.cost;
+    }
+
+    /**
+     * Override the model for one handler.
+     */
+    void set_cost(uint64_t discriminator, const CuCost& cost) { costs_[discriminator] = cost; }
+
+    /**
+     * Model for a handler, if known.
+     */
+    const CuCost* cost(uint64_t discriminator) const {
+        auto it = costs_.find(discriminator);
+        return it == costs_.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * Cost used for unknown discriminators (default: runtime per-ix default).
+     */
+    void set_fallback(uint32_t units) { fallback_ = units; }
+
+    /**
+     * Estimate units for a handler with explicit scaling inputs.
+     */
+    uint32_t estimate(uint64_t discriminator, const CuContext& ctx = {}) const {
+        const CuCost* c = cost(discriminator);
+        if (!c) return fallback_;
+        uint64_t units = c->base
+            + static_cast<uint64_t>(c->per_token) * ctx.n_tokens
+            + static_cast<uint64_t>(c->per_hop) * ctx.hops
+            + static_cast<uint64_t>(c->per_tick) * ctx.ticks_crossed;
+        return units > MAX_COMPUTE_UNIT_LIMIT ? MAX_COMPUTE_UNIT_LIMIT
+                                              : static_cast<uint32_t>(units);
+    }
+
+    /**
+     * Estimate units from encoded instruction data.
+     * Token count (addliqn/remliqn) and hop count (multihop) are read from
+     * the data; other inputs come from ctx.
+     */
+    uint32_t estimate(const uint8_t* data, size_t len, CuContext ctx = {}) const {
+        if (len < 8) return fallback_;
+        uint64_t d = aex402::detail::load_le<uint64_t>(data);
+
+        if ((d == disc::ADDLIQN || d == disc::REMLIQN) && len >= 16) {
+            // [disc][amounts or mins...][min_lp] / [disc][lp_amount][mins...]
+            ctx.n_tokens = static_cast<uint8_t>(std::min<size_t>((len - 16) / 8, MAX_TOKENS));
+        } else if (d == disc::MULTIHOP && len >= 33) {
+            ctx.hops = data[32];
+        }
+        return estimate(d, ctx);
+    }
+
+    uint32_t estimate(const std::vector<uint8_t>& data, const CuContext& ctx = {}) const {
+        return estimate(data.data(), data.size(), ctx);
+    }
+
+    /**
+     * Transaction limit for a set of instruction estimates:
+     * sum plus margin_bps headroom plus the ComputeBudget instructions
+     * themselves, capped at the per-transaction maximum.
+     */
+    static uint32_t limit_for(const uint32_t* estimates, size_t n, uint32_t margin_bps = 1000,
+                              uint32_t budget_ixs = 2) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < n; i++) total += estimates[i];
+        total += total * margin_bps / 10000;
+        total += static_cast<uint64_t>(budget_ixs) * detail::COMPUTE_BUDGET_IX_CU;
+        return total > MAX_COMPUTE_UNIT_LIMIT ? MAX_COMPUTE_UNIT_LIMIT
+                                              : static_cast<uint32_t>(total);
+    }
+
+private:
+    std::unordered_map<uint64_t, CuCost> costs_;
+    uint32_t fallback_ = DEFAULT_COMPUTE_UNIT_LIMIT;
+};
+
+}  // namespace aex402
@@ -35,6 +35,25 @@ constexpr std::array<uint8_t, 32> PROGRAM_ID_BYTES = {
 constexpr std::string_view TOKEN_PROGRAM_ID = "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA";
 constexpr std::string_view TOKEN_2022_PROGRAM_ID = "TokenzQdBNbLqP5VEhdkAS6EPFLC1PHnBqCXEpPxuEb";
 
+// ============================================================================
+// Compute Budget Program
+// ============================================================================
+
+constexpr std::string_view COMPUTE_BUDGET_PROGRAM_ID = "ComputeBudget111111111111111111111111111111";
+
+constexpr std::array<uint8_t, 32> COMPUTE_BUDGET_PROGRAM_ID_BYTES = {
+    0x03, 0x06, 0x46, 0x6f, 0xe5, 0x21, 0x17, 0x32,
+    0xff, 0xec, 0xad, 0xba, 0x72, 0xc3, 0x9b, 0xe7,
+    0xbc, 0x8c, 0xe5, 0xbb, 0xc5, 0xf7, 0x12, 0x6b,
+    0x2c, 0x43, 0x9b, 0x3a, 0x40, 0x00, 0x00, 0x00
+};
+
+constexpr uint32_t MAX_COMPUTE_UNIT_LIMIT = 1400000;     // Per transaction
+constexpr uint32_t DEFAULT_COMPUTE_UNIT_LIMIT = 200000;  // Per instruction when unset
+constexpr uint32_t MAX_HEAP_FRAME_BYTES = 256 * 1024;
+constexpr uint32_t HEAP_FRAME_GRANULARITY = 1024;
+constexpr uint64_t MICRO_LAMPORTS_PER_LAMPORT = 1000000;
+
 // ============================================================================
 // Pool Constants
 // ============================================================================
@@ -43,6 +62,7 @@ constexpr uint64_t MIN_AMP = 1;
 constexpr uint64_t MAX_AMP = 100000;
 constexpr uint64_t DEFAULT_FEE_BPS = 30;
 constexpr uint64_t ADMIN_FEE_PCT = 50;
+constexpr uint64_t MAX_ADMIN_FEE_PCT = 100;     // admin_fee_pct is a percentage of the swap fee
 constexpr uint64_t MIN_SWAP = 100000;
 constexpr uint64_t MIN_DEPOSIT = 100000000;
 constexpr uint8_t  NEWTON_ITERATIONS = 255;
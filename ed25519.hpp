@@ -0,0 +1,955 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Ed25519 Signing
+ *
+ * Dependency-free Ed25519 (RFC 8032) for signing transaction messages.
+ *
+ * - SHA-512 for key expansion and nonce/challenge hashing
+ * - Field arithmetic mod 2^255-19 in radix 2^51
+ * - Fixed-base scalar multiplication from a precomputed table
+ *   (64 windows x 8 multiples of the base point, built once on first use)
+ *
+ * Secret key expansion (SHA-512 of the seed, clamping, public key
+ * derivation) is done once per ExpandedKey; signing then costs one
+ * fixed-base multiplication and two hashes per message. KeyRing caches
+ * expanded keys by public key for submitters rotating across many keys.
+ *
+ * Signing is constant-time with respect to secret data. Verification is
+ * variable-time (it only handles public data).
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+#include "types.hpp"
+#include "pubkey_map.hpp"
+#include "trace.hpp"
+
+namespace aex402 {
+namespace ed25519 {
+
+using Signature = std::array<uint8_t, 64>;
+
+// ============================================================================
+// SHA-512
+// ============================================================================
+
+namespace detail {
+
+constexpr uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+inline uint64_t rotr64(uint64_t x, unsigned n) { return (x >> n) | (x << (64 - n)); }
+
+inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+inline void store_be64(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = static_cast<uint8_t>(v);
+        v >>= 8;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Streaming SHA-512 (FIPS 180-4).
+ */
+class Sha512 {
+public:
+    Sha512() { reset(); }
+
+    void reset() {
+        state_[0] = 0x6a09e667f3bcc908ULL;
+        state_[1] = 0xbb67ae8584caa73bULL;
+        state_[2] = 0x3c6ef372fe94f82bULL;
+        state_[3] = 0xa54ff53a5f1d36f1ULL;
+        state_[4] = 0x510e527fade682d1ULL;
+        state_[5] = 0x9b05688c2b3e6c1fULL;
+        state_[6] = 0x1f83d9abfb41bd6bULL;
+        state_[7] = 0x5be0cd19137e2179ULL;
+        total_ = 0;
+        buffered_ = 0;
+    }
+
+    Sha512& update(const uint8_t* data, size_t len) {
+        if (len == 0) return *this;
+        total_ += len;
+        if (buffered_ > 0) {
+            size_t take = std::min(len, sizeof(buf_) - buffered_);
+            std::memcpy(buf_ + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            len -= take;
+            if (buffered_ < sizeof(buf_)) return *this;
+            compress(buf_);
+            buffered_ = 0;
+        }
+        while (len >= sizeof(buf_)) {
+            compress(data);
+            data += sizeof(buf_);
+            len -= sizeof(buf_);
+        }
+        if (len > 0) {
+            std::memcpy(buf_, data, len);
+            buffered_ = len;
+        }
+        return *this;
+    }
+
+    void finish(uint8_t out[64]) {
+        uint64_t bits = static_cast<uint64_t>(total_) * 8;
+        buf_[buffered_++] = 0x80;
+        if (buffered_ > 112) {
+            std::memset(buf_ + buffered_, 0, sizeof(buf_) - buffered_);
+            compress(buf_);
+            buffered_ = 0;
+        }
+        std::memset(buf_ + buffered_, 0, 120 - buffered_);
+        detail::store_be64(buf_ + 120, bits);
+        compress(buf_);
+        for (int i = 0; i < 8; i++) detail::store_be64(out + 8 * i, state_[i]);
+        reset();
+    }
+
+    static void hash(const uint8_t* data, size_t len, uint8_t out[64]) {
+        Sha512 h;
+        h.update(data, len);
+        h.finish(out);
+    }
+
+private:
+    uint64_t state_[8];
+    uint8_t buf_[128];
+    size_t total_;
+    size_t buffered_;
+
+    void compress(const uint8_t* block) {
+        using detail::rotr64;
+        uint64_t w[80];
+        for (int i = 0; i < 16; i++) w[i] = detail::load_be64(block + 8 * i);
+        for (int i = 16; i < 80; i++) {
+            uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+            uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint64_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint64_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+        for (int i = 0; i < 80; i++) {
+            uint64_t S1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+            uint64_t ch = (e & f) ^ (~e & g);
+            uint64_t t1 = h + S1 + ch + detail::SHA512_K[i] + w[i];
+            uint64_t S0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+            uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint64_t t2 = S0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+        state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+    }
+};
+
+// ============================================================================
+// Field Arithmetic (mod 2^255 - 19, radix 2^51)
+// ============================================================================
+
+namespace detail {
+
+constexpr uint64_t MASK51 = (1ULL << 51) - 1;
+
+struct Fe {
+    uint64_t v[5];
+};
+
+inline Fe fe_zero() { return Fe{{0, 0, 0, 0, 0}}; }
+inline Fe fe_one() { return Fe{{1, 0, 0, 0, 0}}; }
+
+inline void fe_carry(Fe& h) {
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= MASK51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= MASK51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= MASK51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= MASK51; h.v[4] += c;
+    c = h.v[4] >> 51; h.v[4] &= MASK51; h.v[0] += c * 19;
+}
+
+inline Fe fe_add(const Fe& a, const Fe& b) {
+    Fe h;
+    for (int i = 0; i < 5; i++) h.v[i] = a.v[i] + b.v[i];
+    fe_carry(h);
+    return h;
+}
+
+// a - b computed as a + 4p - b so limbs never underflow
+inline Fe fe_sub(const Fe& a, const Fe& b) {
+    Fe h;
+    h.v[0] = a.v[0] + 0x1FFFFFFFFFFFB4ULL - b.v[0];
+    for (int i = 1; i < 5; i++) h.v[i] = a.v[i] + 0x1FFFFFFFFFFFFCULL - b.v[i];
+    fe_carry(h);
+    return h;
+}
+
+inline Fe fe_neg(const Fe& a) { return fe_sub(fe_zero(), a); }
+
+inline Fe fe_mul(const Fe& a, const Fe& b) {
+    using u128 = __uint128_t;
+    const uint64_t a0 = a.v[0], a1 = a.v[1], a2 = a.v[2], a3 = a.v[3], a4 = a.v[4];
+    const uint64_t b0 = b.v[0], b1 = b.v[1], b2 = b.v[2], b3 = b.v[3], b4 = b.v[4];
+    const uint64_t b1_19 = b1 * 19, b2_19 = b2 * 19, b3_19 = b3 * 19, b4_19 = b4 * 19;
+
+    u128 r0 = (u128)a0 * b0 + (u128)a1 * b4_19 + (u128)a2 * b3_19 + (u128)a3 * b2_19 + (u128)a4 * b1_19;
+    u128 r1 = (u128)a0 * b1 + (u128)a1 * b0 + (u128)a2 * b4_19 + (u128)a3 * b3_19 + (u128)a4 * b2_19;
+    u128 r2 = (u128)a0 * b2 + (u128)a1 * b1 + (u128)a2 * b0 + (u128)a3 * b4_19 + (u128)a4 * b3_19;
+    u128 r3 = (u128)a0 * b3 + (u128)a1 * b2 + (u128)a2 * b1 + (u128)a3 * b0 + (u128)a4 * b4_19;
+    u128 r4 = (u128)a0 * b4 + (u128)a1 * b3 + (u128)a2 * b2 + (u128)a3 * b1 + (u128)a4 * b0;
+
+    Fe h;
+    uint64_t c;
+    c = static_cast<uint64_t>(r0 >> 51); h.v[0] = static_cast<uint64_t>(r0) & MASK51; r1 += c;
+    c = static_cast<uint64_t>(r1 >> 51); h.v[1] = static_cast<uint64_t>(r1) & MASK51; r2 += c;
+    c = static_cast<uint64_t>(r2 >> 51); h.v[2] = static_cast<uint64_t>(r2) & MASK51; r3 += c;
+    c = static_cast<uint64_t>(r3 >> 51); h.v[3] = static_cast<uint64_t>(r3) & MASK51; r4 += c;
+    c = static_cast<uint64_t>(r4 >> 51); h.v[4] = static_cast<uint64_t>(r4) & MASK51;
+    h.v[0] += c * 19;
+    c = h.v[0] >> 51; h.v[0] &= MASK51; h.v[1] += c;
+    return h;
+}
+
+inline Fe fe_sq(const Fe& a) { return fe_mul(a, a); }
+
+inline Fe fe_sq_n(Fe a, int n) {
+    for (int i = 0; i < n; i++) a = fe_sq(a);
+    return a;
+}
+
+/**
+ * Returns z^(2^250 - 1) and z^11, shared by inversion and square root.
+ */
+inline Fe fe_pow_2_250_1(const Fe& z, Fe& z11) {
+    Fe z2 = fe_sq(z);
+    Fe z9 = fe_mul(fe_sq_n(z2, 2), z);
+    z11 = fe_mul(z9, z2);
+    Fe z_5_0 = fe_mul(fe_sq(z11), z9);
+    Fe z_10_0 = fe_mul(fe_sq_n(z_5_0, 5), z_5_0);
+    Fe z_20_0 = fe_mul(fe_sq_n(z_10_0, 10), z_10_0);
+    Fe z_40_0 = fe_mul(fe_sq_n(z_20_0, 20), z_20_0);
+    Fe z_50_0 = fe_mul(fe_sq_n(z_40_0, 10), z_10_0);
+    Fe z_100_0 = fe_mul(fe_sq_n(z_50_0, 50), z_50_0);
+    Fe z_200_0 = fe_mul(fe_sq_n(z_100_0, 100), z_100_0);
+    return fe_mul(fe_sq_n(z_200_0, 50), z_50_0);
+}
+
+// z^(p-2)
+inline Fe fe_invert(const Fe& z) {
+    Fe z11;
+    Fe t = fe_pow_2_250_1(z, z11);
+    return fe_mul(fe_sq_n(t, 5), z11);
+}
+
+// z^((p-5)/8)
+inline Fe fe_pow22523(const Fe& z) {
+    Fe z11;
+    Fe t = fe_pow_2_250_1(z, z11);
+    return fe_mul(fe_sq_n(t, 2), z);
+}
+
+inline Fe fe_from_bytes(const uint8_t s[32]) {
+    uint64_t w[4];
+    for (int i = 0; i < 4; i++) w[i] = aex402::detail::load_le<uint64_t>(s + 8 * i);
+    Fe h;
+    h.v[0] = w[0] & MASK51;
+    h.v[1] = ((w[0] >> 51) | (w[1] << 13)) & MASK51;
+    h.v[2] = ((w[1] >> 38) | (w[2] << 26)) & MASK51;
+    h.v[3] = ((w[2] >> 25) | (w[3] << 39)) & MASK51;
+    h.v[4] = (w[3] >> 12) & MASK51;
+    return h;
+}
+
+// Canonical little-endian encoding (fully reduced mod p)
+inline void fe_to_bytes(uint8_t s[32], Fe h) {
+    fe_carry(h);
+    fe_carry(h);
+    // h < 2p here; subtract p if h >= p
+    uint64_t q = (h.v[0] + 19) >> 51;
+    q = (h.v[1] + q) >> 51;
+    q = (h.v[2] + q) >> 51;
+    q = (h.v[3] + q) >> 51;
+    q = (h.v[4] + q) >> 51;
+    h.v[0] += 19 * q;
+    uint64_t c;
+    c = h.v[0] >> 51; h.v[0] &= MASK51; h.v[1] += c;
+    c = h.v[1] >> 51; h.v[1] &= MASK51; h.v[2] += c;
+    c = h.v[2] >> 51; h.v[2] &= MASK51; h.v[3] += c;
+    c = h.v[3] >> 51; h.v[3] &= MASK51; h.v[4] += c;
+    h.v[4] &= MASK51;
+
+    uint64_t w[4];
+    w[0] = h.v[0] | (h.v[1] << 51);
+    w[1] = (h.v[1] >> 13) | (h.v[2] << 38);
+    w[2] = (h.v[2] >> 26) | (h.v[3] << 25);
+    w[3] = (h.v[3] >> 39) | (h.v[4] << 12);
+    for (int i = 0; i < 4; i++) aex402::detail::store_le<uint64_t>(s + 8 * i, w[i]);
+}
+
+inline bool fe_is_negative(const Fe& a) {
+    uint8_t s[32];
+    fe_to_bytes(s, a);
+    return (s[0] & 1) != 0;
+}
+
+inline bool fe_is_zero(const Fe& a) {
+    uint8_t s[32];
+    fe_to_bytes(s, a);
+    uint8_t acc = 0;
+    for (int i = 0; i < 32; i++) acc |= s[i];
+    return acc == 0;
+}
+
+inline bool fe_eq(const Fe& a, const Fe& b) { return fe_is_zero(fe_sub(a, b)); }
+
+// Constant-time conditional move: f = b ? g : f
+inline void fe_cmov(Fe& f, const Fe& g, uint64_t b) {
+    uint64_t mask = 0 - b;
+    for (int i = 0; i < 5; i++) f.v[i] ^= mask & (f.v[i] ^ g.v[i]);
+}
+
+// Curve constants (little-endian field elements)
+constexpr uint8_t D_BYTES[32] = {
+    0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+    0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52,
+};
+constexpr uint8_t D2_BYTES[32] = {
+    0x59, 0xf1, 0xb2, 0x26, 0x94, 0x9b, 0xd6, 0xeb, 0x56, 0xb1, 0x83, 0x82, 0x9a, 0x14, 0xe0, 0x00,
+    0x30, 0xd1, 0xf3, 0xee, 0xf2, 0x80, 0x8e, 0x19, 0xe7, 0xfc, 0xdf, 0x56, 0xdc, 0xd9, 0x06, 0x24,
+};
+constexpr uint8_t SQRTM1_BYTES[32] = {
+    0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b,
+};
+constexpr uint8_t BASE_X_BYTES[32] = {
+    0x1a, 0xd5, 0x25, 0x8f, 0x60, 0x2d, 0x56, 0xc9, 0xb2, 0xa7, 0x25, 0x95, 0x60, 0xc7, 0x2c, 0x69,
+    0x5c, 0xdc, 0xd6, 0xfd, 0x31, 0xe2, 0xa4, 0xc0, 0xfe, 0x53, 0x6e, 0xcd, 0xd3, 0x36, 0x69, 0x21,
+};
+constexpr uint8_t BASE_Y_BYTES[32] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+};
+
+// ============================================================================
+// Group Arithmetic (twisted Edwards, extended coordinates)
+// ============================================================================
+
+// Extended point: x = X/Z, y = Y/Z, xy = T/Z
+struct Point {
+    Fe X, Y, Z, T;
+};
+
+// Affine precomputed form: (y + x, y - x, 2d*x*y)
+struct Niels {
+    Fe ypx, ymx, xy2d;
+};
+
+// Projective cached form for variable-base additions
+struct Cached {
+    Fe ypx, ymx, Z, t2d;
+};
+
+struct Constants {
+    Fe d, d2, sqrtm1;
+    Point base;
+
+    Constants()
+        : d(fe_from_bytes(D_BYTES)),
+          d2(fe_from_bytes(D2_BYTES)),
+          sqrtm1(fe_from_bytes(SQRTM1_BYTES)) {
+        base.X = fe_from_bytes(BASE_X_BYTES);
+        base.Y = fe_from_bytes(BASE_Y_BYTES);
+        base.Z = fe_one();
+        base.T = fe_mul(base.X, base.Y);
+    }
+};
+
+inline const Constants& constants() {
+    static const Constants c;
+    return c;
+}
+
+inline Point point_identity() { return Point{fe_zero(), fe_one(), fe_one(), fe_zero()}; }
+
+inline Point point_double(const Point& p) {
+    Fe a = fe_sq(p.X);
+    Fe b = fe_sq(p.Y);
+    Fe c = fe_add(fe_sq(p.Z), fe_sq(p.Z));
+    Fe h = fe_add(a, b);
+    Fe e = fe_sub(h, fe_sq(fe_add(p.X, p.Y)));  // -(2xy)
+    Fe g = fe_sub(a, b);                        // -(b - a)
+    Fe f = fe_add(c, g);                        // -(g' - c)
+    // Signs of e, f, g, h all flipped relative to dbl-2008-hwcd (a = -1);
+    // each output is a product of two of them, so the result is unchanged.
+    return Point{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline Point point_add_niels(const Point& p, const Niels& q) {
+    Fe a = fe_mul(fe_sub(p.Y, p.X), q.ymx);
+    Fe b = fe_mul(fe_add(p.Y, p.X), q.ypx);
+    Fe c = fe_mul(p.T, q.xy2d);
+    Fe d = fe_add(p.Z, p.Z);
+    Fe e = fe_sub(b, a);
+    Fe f = fe_sub(d, c);
+    Fe g = fe_add(d, c);
+    Fe h = fe_add(b, a);
+    return Point{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline Cached to_cached(const Point& p) {
+    return Cached{fe_add(p.Y, p.X), fe_sub(p.Y, p.X), p.Z, fe_mul(p.T, constants().d2)};
+}
+
+inline Point point_add_cached(const Point& p, const Cached& q) {
+    Fe a = fe_mul(fe_sub(p.Y, p.X), q.ymx);
+    Fe b = fe_mul(fe_add(p.Y, p.X), q.ypx);
+    Fe c = fe_mul(p.T, q.t2d);
+    Fe zz = fe_mul(p.Z, q.Z);
+    Fe d = fe_add(zz, zz);
+    Fe e = fe_sub(b, a);
+    Fe f = fe_sub(d, c);
+    Fe g = fe_add(d, c);
+    Fe h = fe_add(b, a);
+    return Point{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline void point_encode(uint8_t out[32], const Point& p) {
+    Fe recip = fe_invert(p.Z);
+    Fe x = fe_mul(p.X, recip);
+    Fe y = fe_mul(p.Y, recip);
+    fe_to_bytes(out, y);
+    out[31] = static_cast<uint8_t>(out[31] ^ (fe_is_negative(x) ? 0x80 : 0x00));
+}
+
+inline std::optional<Point> point_decode(const uint8_t s[32]) {
+    const Constants& k = constants();
+    Fe y = fe_from_bytes(s);
+    bool sign = (s[31] & 0x80) != 0;
+
+    Fe y2 = fe_sq(y);
+    Fe u = fe_sub(y2, fe_one());
+    Fe v = fe_add(fe_mul(k.d, y2), fe_one());
+
+    // x = u v^3 (u v^7)^((p-5)/8)
+    Fe v3 = fe_mul(fe_sq(v), v);
+    Fe v7 = fe_mul(fe_sq(v3), v);
+    Fe x = fe_mul(fe_mul(u, v3), fe_pow22523(fe_mul(u, v7)));
+
+    Fe vx2 = fe_mul(v, fe_sq(x));
+    if (!fe_eq(vx2, u)) {
+        if (!fe_eq(vx2, fe_neg(u))) return std::nullopt;
+        x = fe_mul(x, k.sqrtm1);
+    }
+    if (fe_is_zero(x) && sign) return std::nullopt;
+    if (fe_is_negative(x) != sign) x = fe_neg(x);
+
+    return Point{x, y, fe_one(), fe_mul(x, y)};
+}
+
+// ============================================================================
+// Fixed-Base Table
+// ============================================================================
+
+/**
+ * table[i][j] = (j + 1) * 16^i * B in affine Niels form.
+ * 64 x 8 entries x 120 bytes = 60 KiB, built once on first use.
+ */
+struct BaseTable {
+    Niels entries[64][8];
+
+    BaseTable() {
+        Point row = constants().base;  // 16^i * B
+        for (int i = 0; i < 64; i++) {
+            Point acc = row;
+            for (int j = 0; j < 8; j++) {
+                Fe recip = fe_invert(acc.Z);
+                Fe x = fe_mul(acc.X, recip);
+                Fe y = fe_mul(acc.Y, recip);
+                entries[i][j].ypx = fe_add(y, x);
+                entries[i][j].ymx = fe_sub(y, x);
+                entries[i][j].xy2d = fe_mul(fe_mul(x, y), constants().d2);
+                if (j < 7) acc = point_add_cached(acc, to_cached(row));
+            }
+            for (int k = 0; k < 4; k++) row = point_double(row);
+        }
+    }
+};
+
+inline const BaseTable& base_table() {
+    static const BaseTable table;
+    return table;
+}
+
+// Constant-time lookup of digit * 16^i * B for digit in [-8, 8]
+inline Niels base_select(int window, int8_t digit) {
+    const BaseTable& t = base_table();
+    uint32_t neg = static_cast<uint32_t>(static_cast<uint8_t>(digit) >> 7);
+    uint32_t sign_mask = 0U - neg;
+    uint32_t abs = ((static_cast<uint32_t>(digit) ^ sign_mask) - sign_mask) & 0xFF;
+
+    Niels r{fe_one(), fe_one(), fe_zero()};
+    for (uint32_t j = 0; j < 8; j++) {
+        uint64_t eq = ((abs ^ (j + 1)) - 1U) >> 31;
+        fe_cmov(r.ypx, t.entries[window][j].ypx, eq);
+        fe_cmov(r.ymx, t.entries[window][j].ymx, eq);
+        fe_cmov(r.xy2d, t.entries[window][j].xy2d, eq);
+    }
+
+    Niels minus{r.ymx, r.ypx, fe_neg(r.xy2d)};
+    fe_cmov(r.ypx, minus.ypx, neg);
+    fe_cmov(r.ymx, minus.ymx, neg);
+    fe_cmov(r.xy2d, minus.xy2d, neg);
+    return r;
+}
+
+// Scalar (little-endian, top bit clear) to 64 signed radix-16 digits in [-8, 8]
+inline void scalar_to_radix16(int8_t e[64], const uint8_t a[32]) {
+    for (int i = 0; i < 32; i++) {
+        e[2 * i] = static_cast<int8_t>(a[i] & 15);
+        e[2 * i + 1] = static_cast<int8_t>((a[i] >> 4) & 15);
+    }
+    int8_t carry = 0;
+    for (int i = 0; i < 63; i++) {
+        e[i] = static_cast<int8_t>(e[i] + carry);
+        carry = static_cast<int8_t>((e[i] + 8) >> 4);
+        e[i] = static_cast<int8_t>(e[i] - carry * 16);
+    }
+    e[63] = static_cast<int8_t>(e[63] + carry);
+}
+
+// a * B
+inline Point scalarmult_base(const uint8_t a[32]) {
+    int8_t e[64];
+    scalar_to_radix16(e, a);
+    Point p = point_identity();
+    for (int i = 0; i < 64; i++) p = point_add_niels(p, base_select(i, e[i]));
+    return p;
+}
+
+// a * P, variable-time (public inputs only)
+inline Point scalarmult_vartime(const uint8_t a[32], const Point& p) {
+    Cached multiples[16];
+    Point acc = point_identity();
+    for (int j = 0; j < 16; j++) {
+        multiples[j] = to_cached(acc);
+        acc = point_add_cached(acc, to_cached(p));
+    }
+
+    Point r = point_identity();
+    for (int i = 63; i >= 0; i--) {
+        r = point_double(point_double(point_double(point_double(r))));
+        int nibble = (a[i / 2] >> ((i & 1) * 4)) & 15;
+        if (nibble != 0) r = point_add_cached(r, multiples[nibble]);
+    }
+    return r;
+}
+
+// ============================================================================
+// Scalar Arithmetic (mod L = 2^252 + 27742317777372353535851937790883648493)
+// ============================================================================
+
+constexpr uint64_t L_LIMBS[4] = {
+    0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0x0000000000000000ULL, 0x1000000000000000ULL,
+};
+
+// floor(2^512 / L) for Barrett reduction
+constexpr uint64_t MU_LIMBS[5] = {
+    0xed9ce5a30a2c131bULL, 0x2106215d086329a7ULL, 0xffffffffffffffebULL, 0xffffffffffffffffULL,
+    0x000000000000000fULL,
+};
+
+/**
+ * Barrett reduction of a 512-bit value (8 little-endian limbs) mod L.
+ * q = ((x >> 252) * mu) >> 260 undershoots floor(x / L) by at most 3, so
+ * the remainder is finished with three constant-time conditional
+ * subtractions. Only the low 320 bits of x - q*L are needed.
+ */
+inline void sc_reduce_limbs(uint8_t out[32], const uint64_t x[8]) {
+    using u128 = __uint128_t;
+
+    uint64_t a[5];
+    for (int i = 0; i < 4; i++) a[i] = (x[i + 3] >> 60) | (x[i + 4] << 4);
+    a[4] = x[7] >> 60;
+
+    uint64_t prod[10] = {0};
+    for (int i = 0; i < 5; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 5; j++) {
+            u128 t = static_cast<u128>(a[i]) * MU_LIMBS[j] + prod[i + j] + carry;
+            prod[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+        prod[i + 5] = carry;
+    }
+
+    uint64_t q[5];
+    for (int i = 0; i < 5; i++) q[i] = (prod[i + 4] >> 4) | (prod[i + 5] << 60);
+
+    // r = x - q * L (mod 2^320)
+    uint64_t ql[5] = {0};
+    for (int i = 0; i < 5; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; i + j < 5 && j < 4; j++) {
+            u128 t = static_cast<u128>(q[i]) * L_LIMBS[j] + ql[i + j] + carry;
+            ql[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+        if (i + 4 < 5) ql[i + 4] += carry;
+    }
+    uint64_t r[5];
+    uint64_t borrow = 0;
+    for (int i = 0; i < 5; i++) {
+        u128 diff = static_cast<u128>(x[i]) - ql[i] - borrow;
+        r[i] = static_cast<uint64_t>(diff);
+        borrow = static_cast<uint64_t>(diff >> 64) & 1U;
+    }
+
+    for (int round = 0; round < 3; round++) {
+        uint64_t t[5];
+        borrow = 0;
+        for (int i = 0; i < 5; i++) {
+            uint64_t l = i < 4 ? L_LIMBS[i] : 0;
+            u128 diff = static_cast<u128>(r[i]) - l - borrow;
+            t[i] = static_cast<uint64_t>(diff);
+            borrow = static_cast<uint64_t>(diff >> 64) & 1U;
+        }
+        uint64_t keep = 0 - borrow;  // all ones if r < L
+        for (int i = 0; i < 5; i++) r[i] = (r[i] & keep) | (t[i] & ~keep);
+    }
+
+    for (int i = 0; i < 4; i++) aex402::detail::store_le<uint64_t>(out + 8 * i, r[i]);
+}
+
+// Reduce a 64-byte little-endian value (e.g. a SHA-512 digest) mod L
+inline void sc_reduce(uint8_t out[32], const uint8_t in[64]) {
+    uint64_t x[8];
+    for (int i = 0; i < 8; i++) x[i] = aex402::detail::load_le<uint64_t>(in + 8 * i);
+    sc_reduce_limbs(out, x);
+}
+
+// out = (a * b + c) mod L
+inline void sc_muladd(uint8_t out[32], const uint8_t a[32], const uint8_t b[32],
+                      const uint8_t c[32]) {
+    uint64_t x[4], y[4], prod[8] = {0};
+    for (int i = 0; i < 4; i++) {
+        x[i] = aex402::detail::load_le<uint64_t>(a + 8 * i);
+        y[i] = aex402::detail::load_le<uint64_t>(b + 8 * i);
+        prod[i] = aex402::detail::load_le<uint64_t>(c + 8 * i);
+    }
+    for (int i = 0; i < 4; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; j++) {
+            __uint128_t t = static_cast<__uint128_t>(x[i]) * y[j] + prod[i + j] + carry;
+            prod[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+        for (int k = i + 4; carry != 0 && k < 8; k++) {
+            __uint128_t t = static_cast<__uint128_t>(prod[k]) + carry;
+            prod[k] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+    }
+    sc_reduce_limbs(out, prod);
+}
+
+// True if s < L (canonical signature scalar)
+inline bool sc_is_canonical(const uint8_t s[32]) {
+    for (int i = 3; i >= 0; i--) {
+        uint64_t w = aex402::detail::load_le<uint64_t>(s + 8 * i);
+        if (w < L_LIMBS[i]) return true;
+        if (w > L_LIMBS[i]) return false;
+    }
+    return false;
+}
+
+inline void secure_zero(void* p, size_t len) {
+    volatile uint8_t* v = static_cast<volatile uint8_t*>(p);
+    while (len--) *v++ = 0;
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Keys
+// ============================================================================
+
+/**
+ * Secret key expanded once for repeated signing.
+ * Holds the clamped scalar, the nonce prefix, and the derived public key.
+ * Read-only after construction, so one instance may sign from many threads.
+ */
+struct ExpandedKey {
+    uint8_t scalar[32];
+    uint8_t prefix[32];
+    Pubkey public_key;
+
+    ExpandedKey() : scalar{}, prefix{}, public_key{} {}
+    ExpandedKey(const ExpandedKey&) = default;
+    ExpandedKey& operator=(const ExpandedKey&) = default;
+    ~ExpandedKey() {
+        detail::secure_zero(scalar, sizeof(scalar));
+        detail::secure_zero(prefix, sizeof(prefix));
+    }
+
+    /**
+     * Expand a 32-byte secret seed.
+     */
+    static ExpandedKey from_seed(const uint8_t seed[32]) {
+        uint8_t h[64];
+        Sha512::hash(seed, 32, h);
+
+        ExpandedKey k;
+        std::memcpy(k.scalar, h, 32);
+        std::memcpy(k.prefix, h + 32, 32);
+        detail::secure_zero(h, sizeof(h));
+
+        k.scalar[0] &= 248;
+        k.scalar[31] &= 127;
+        k.scalar[31] |= 64;
+
+        detail::point_encode(k.public_key.data(), detail::scalarmult_base(k.scalar));
+        return k;
+    }
+
+    /**
+     * Expand a 64-byte Solana keypair (seed || public key).
+     * Returns nullopt if the embedded public key does not match the seed.
+     */
+    static std::optional<ExpandedKey> from_keypair(const uint8_t keypair[64]) {
+        ExpandedKey k = from_seed(keypair);
+        if (std::memcmp(k.public_key.data(), keypair + 32, 32) != 0) return std::nullopt;
+        return k;
+    }
+};
+
+// ============================================================================
+// Signing
+// ============================================================================
+
+/**
+ * Sign a message with an expanded key.
+ */
+inline Signature sign(const ExpandedKey& key, const uint8_t* msg, size_t len) {
+    AEX402_TRACE_SCOPE("sign.ed25519");
+    Signature sig{};
+    uint8_t h[64];
+    uint8_t r[32];
+
+    // r = H(prefix || M) mod L
+    Sha512 hasher;
+    hasher.update(key.prefix, 32).update(msg, len).finish(h);
+    detail::sc_reduce(r, h);
+
+    // R = r * B
+    detail::point_encode(sig.data(), detail::scalarmult_base(r));
+
+    // k = H(R || A || M) mod L
+    uint8_t k[32];
+    hasher.update(sig.data(), 32).update(key.public_key.data(), 32).update(msg, len).finish(h);
+    detail::sc_reduce(k, h);
+
+    // S = (r + k * a) mod L
+    detail::sc_muladd(sig.data() + 32, k, key.scalar, r);
+
+    detail::secure_zero(r, sizeof(r));
+    detail::secure_zero(h, sizeof(h));
+    return sig;
+}
+
+inline Signature sign(const ExpandedKey& key, const std::vector<uint8_t>& msg) {
+    return sign(key, msg.data(), msg.size());
+}
+
+/**
+ * Sign n messages with the same key. out must hold n signatures.
+ *
+ * Nonce points are encoded in chunks with one shared field inversion
+ * (Montgomery's trick), which removes most of the per-message encoding
+ * cost of sign().
+ */
+inline void sign_batch(const ExpandedKey& key, const uint8_t* const* msgs, const size_t* lens,
+                       size_t n, Signature* out) {
+    AEX402_TRACE_SCOPE("sign.ed25519_batch");
+    constexpr size_t CHUNK = 32;
+    detail::Point points[CHUNK];
+    detail::Fe partial[CHUNK];
+    uint8_t nonces[CHUNK][32];
+    uint8_t h[64];
+    Sha512 hasher;
+
+    for (size_t base = 0; base < n; base += CHUNK) {
+        size_t m = std::min(CHUNK, n - base);
+
+        // r_i = H(prefix || M_i) mod L, R_i = r_i * B
+        for (size_t i = 0; i < m; i++) {
+            hasher.update(key.prefix, 32).update(msgs[base + i], lens[base + i]).finish(h);
+            detail::sc_reduce(nonces[i], h);
+            points[i] = detail::scalarmult_base(nonces[i]);
+        }
+
+        // Batch-invert the Z coordinates
+        detail::Fe acc = detail::fe_one();
+        for (size_t i = 0; i < m; i++) {
+            partial[i] = acc;
+            acc = detail::fe_mul(acc, points[i].Z);
+        }
+        acc = detail::fe_invert(acc);
+        for (size_t i = m; i-- > 0;) {
+            detail::Fe recip = detail::fe_mul(acc, partial[i]);
+            acc = detail::fe_mul(acc, points[i].Z);
+
+            uint8_t* sig = out[base + i].data();
+            detail::Fe x = detail::fe_mul(points[i].X, recip);
+            detail::fe_to_bytes(sig, detail::fe_mul(points[i].Y, recip));
+            sig[31] = static_cast<uint8_t>(sig[31] ^ (detail::fe_is_negative(x) ? 0x80 : 0x00));
+        }
+
+        // S_i = (r_i + H(R_i || A || M_i) * a) mod L
+        for (size_t i = 0; i < m; i++) {
+            uint8_t* sig = out[base + i].data();
+            uint8_t k[32];
+            hasher.update(sig, 32).update(key.public_key.data(), 32)
+                  .update(msgs[base + i], lens[base + i]).finish(h);
+            detail::sc_reduce(k, h);
+            detail::sc_muladd(sig + 32, k, key.scalar, nonces[i]);
+        }
+    }
+
+    detail::secure_zero(nonces, sizeof(nonces));
+    detail::secure_zero(h, sizeof(h));
+}
+
+inline std::vector<Signature> sign_batch(const ExpandedKey& key,
+                                         const std::vector<std::vector<uint8_t>>& msgs) {
+    std::vector<const uint8_t*> ptrs(msgs.size());
+    std::vector<size_t> lens(msgs.size());
+    for (size_t i = 0; i < msgs.size(); i++) {
+        ptrs[i] = msgs[i].data();
+        lens[i] = msgs[i].size();
+    }
+    std::vector<Signature> out(msgs.size());
+    sign_batch(key, ptrs.data(), lens.data(), msgs.size(), out.data());
+    return out;
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+/**
+ * Verify a signature. Rejects non-canonical S and undecodable public keys.
+ */
+inline bool verify(const Pubkey& public_key, const uint8_t* msg, size_t len,
+                   const Signature& sig) {
+    if (!detail::sc_is_canonical(sig.data() + 32)) return false;
+
+    auto a = detail::point_decode(public_key.data());
+    if (!a) return false;
+
+    uint8_t h[64];
+    uint8_t k[32];
+    Sha512 hasher;
+    hasher.update(sig.data(), 32).update(public_key.data(), 32).update(msg, len).finish(h);
+    detail::sc_reduce(k, h);
+
+    // R' = S * B - k * A
+    detail::Point neg_a = *a;
+    neg_a.X = detail::fe_neg(neg_a.X);
+    neg_a.T = detail::fe_neg(neg_a.T);
+    detail::Point sb = detail::scalarmult_base(sig.data() + 32);
+    detail::Point r = detail::point_add_cached(sb, detail::to_cached(
+        detail::scalarmult_vartime(k, neg_a)));
+
+    uint8_t encoded[32];
+    detail::point_encode(encoded, r);
+    return std::memcmp(encoded, sig.data(), 32) == 0;
+}
+
+inline bool verify(const Pubkey& public_key, const std::vector<uint8_t>& msg,
+                   const Signature& sig) {
+    return verify(public_key, msg.data(), msg.size(), sig);
+}
+
+// ============================================================================
+// KeyRing
+// ============================================================================
+
+/**
+ * Expanded keys indexed by public key, so each secret is expanded once.
+ */
+class KeyRing {
+public:
+    /**
+     * Add a 64-byte keypair. Returns the public key, or nullopt if the
+     * keypair is inconsistent.
+     */
+    std::optional<Pubkey> add_keypair(const uint8_t keypair[64]) {
+        auto key = ExpandedKey::from_keypair(keypair);
+        if (!key) return std::nullopt;
+        Pubkey pk = key->public_key;
+        keys_.insert_or_assign(pk, *key);
+        return pk;
+    }
+
+    Pubkey add_seed(const uint8_t seed[32]) {
+        ExpandedKey key = ExpandedKey::from_seed(seed);
+        Pubkey pk = key.public_key;
+        keys_.insert_or_assign(pk, key);
+        return pk;
+    }
+
+    const ExpandedKey* find(const Pubkey& signer) const { return keys_.find(signer); }
+    bool contains(const Pubkey& signer) const { return keys_.contains(signer); }
+    bool remove(const Pubkey& signer) { return keys_.erase(signer); }
+    size_t size() const { return keys_.size(); }
+
+    /**
+     * Sign with the key for `signer`. Returns nullopt if the key is unknown.
+     */
+    std::optional<Signature> sign(const Pubkey& signer, const uint8_t* msg, size_t len) const {
+        const ExpandedKey* key = keys_.find(signer);
+        if (!key) return std::nullopt;
+        return ed25519::sign(*key, msg, len);
+    }
+
+private:
+    PubkeyMap<ExpandedKey> keys_;
+};
+
+}  // namespace ed25519
+}  // namespace aex402
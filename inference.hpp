@@ -0,0 +1,405 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Event Inference from Snapshots
+ *
+ * Reconstructs swaps, deposits, withdrawals and admin fee claims from two
+ * consecutive Pool or NPool snapshots, for ingest paths that only see
+ * account updates.
+ *
+ * Signals used:
+ * - trade_count: number of swaps in the interval
+ * - vol0/vol1 (Pool) or total_volume (NPool): swap input amounts
+ * - trade_sum: cross-check of total swap input
+ * - lp_supply: deposit (up) or withdrawal (down)
+ * - admin fee counters: fee share kept out of the output balance, or a
+ *   claim when they drop
+ * - balances: swap outputs and liquidity amounts
+ *
+ * Accounting model: a swap adds amount_in to the input balance and removes
+ * amount_out plus the admin fee share from the output balance. Results carry
+ * confidence flags; a single swap is checked against simulate_swap on the
+ * earlier snapshot.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "types.hpp"
+#include "constants.hpp"
+#include "math.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Event Types
+// ============================================================================
+
+enum class EventKind : uint8_t {
+    Swap          = 0,
+    Deposit       = 1,
+    Withdraw      = 2,
+    AdminFeeClaim = 3,
+};
+
+/**
+ * Confidence flags (bit flags) on an inferred event or result.
+ */
+enum class InferFlag : uint32_t {
+    None            = 0,
+    Exact           = 1u << 0,  // Single event, all counters consistent
+    Aggregated      = 1u << 1,  // Several trades merged into one event
+    Ambiguous       = 1u << 2,  // Direction or split not uniquely determined
+    Verified        = 1u << 3,  // Output matches simulate_swap within tolerance
+    SimMismatch     = 1u << 4,  // Output differs from simulate_swap
+    Mixed           = 1u << 5,  // Swaps and liquidity changes in one interval
+    CounterMismatch = 1u << 6,  // Volume, trade_sum or balance deltas disagree
+    Unexplained     = 1u << 7,  // Balance change with no counter movement
+    Regression      = 1u << 8,  // Counters went backwards (out-of-order snapshots)
+};
+
+inline constexpr uint32_t operator|(InferFlag a, InferFlag b) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+}
+
+inline constexpr uint32_t operator|(uint32_t a, InferFlag b) {
+    return a | static_cast<uint32_t>(b);
+}
+
+/**
+ * One inferred event.
+ * Swaps use token_in/token_out/amount_in/amount_out; liquidity events and
+ * fee claims use amounts[] (per token) and lp_amount.
+ */
+struct InferredEvent {
+    EventKind kind;
+    uint8_t token_in;
+    uint8_t token_out;
+    uint64_t amount_in;
+    uint64_t amount_out;
+    uint64_t lp_amount;
+    uint64_t trade_count;           // Trades merged into this event
+    uint64_t slot;                  // Slot of the later snapshot
+    uint64_t amounts[MAX_TOKENS];
+    uint32_t flags;                 // Bitwise OR of InferFlag
+
+    bool has(InferFlag f) const { return (flags & static_cast<uint32_t>(f)) != 0; }
+};
+
+struct InferenceResult {
+    std::vector<InferredEvent> events;
+    uint32_t flags = 0;             // Interval-level flags (Regression, Unexplained)
+
+    bool has(InferFlag f) const { return (flags & static_cast<uint32_t>(f)) != 0; }
+};
+
+struct InferenceOptions {
+    int64_t now = 0;                    // Timestamp for ramped amp when verifying
+    uint64_t slot = 0;                  // Stamped onto every event
+    uint64_t verify_tolerance_bps = 10; // Allowed deviation from simulate_swap
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace detail {
+
+inline InferredEvent make_event(EventKind kind, uint64_t slot) {
+    InferredEvent e{};
+    e.kind = kind;
+    e.slot = slot;
+    return e;
+}
+
+// Positive and negative parts of after - before
+inline uint64_t gain(uint64_t before, uint64_t after) { return after > before ? after - before : 0; }
+inline uint64_t loss(uint64_t before, uint64_t after) { return before > after ? before - after : 0; }
+
+inline bool within_bps(uint64_t actual, uint64_t expected, uint64_t tol_bps) {
+    uint64_t diff = actual > expected ? actual - expected : expected - actual;
+    return math::mul128(diff, math::FEE_DENOMINATOR) <= math::mul128(expected, tol_bps) || diff <= 1;
+}
+
+inline void verify_swap(InferredEvent& e, std::optional<uint64_t> expected, uint64_t tol_bps) {
+    if (!expected) return;
+    e.flags = e.flags | (within_bps(e.amount_out, *expected, tol_bps) ? InferFlag::Verified
+                                                                      : InferFlag::SimMismatch);
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Pool (2-token)
+// ============================================================================
+
+/**
+ * Infer events between two snapshots of the same 2-token pool.
+ */
+inline InferenceResult infer_pool_events(const Pool& before, const Pool& after,
+                                         const InferenceOptions& opts = {}) {
+    using detail::gain;
+    using detail::loss;
+
+    InferenceResult result;
+    if (after.trade_count < before.trade_count || after.vol0 < before.vol0 ||
+        after.vol1 < before.vol1 || after.trade_sum < before.trade_sum) {
+        result.flags = result.flags | InferFlag::Regression;
+        return result;
+    }
+
+    const uint64_t trades = after.trade_count - before.trade_count;
+    const uint64_t dvol[2] = {after.vol0 - before.vol0, after.vol1 - before.vol1};
+    const uint64_t dsum = after.trade_sum - before.trade_sum;
+    const uint64_t bal_before[2] = {before.bal0, before.bal1};
+    const uint64_t bal_after[2] = {after.bal0, after.bal1};
+    const uint64_t fee_before[2] = {before.admin_fee0, before.admin_fee1};
+    const uint64_t fee_after[2] = {after.admin_fee0, after.admin_fee1};
+    const bool lp_changed = after.lp_supply != before.lp_supply;
+    const uint64_t amp = before.get_amp(opts.now);
+
+    // Net balance movement still to be explained after swaps
+    int64_t residual[2] = {
+        static_cast<int64_t>(bal_after[0] - bal_before[0]),
+        static_cast<int64_t>(bal_after[1] - bal_before[1]),
+    };
+
+    // Admin fee claims (counters drop back towards zero)
+    if (fee_after[0] < fee_before[0] || fee_after[1] < fee_before[1]) {
+        InferredEvent e = detail::make_event(EventKind::AdminFeeClaim, opts.slot);
+        e.amounts[0] = loss(fee_before[0], fee_after[0]);
+        e.amounts[1] = loss(fee_before[1], fee_after[1]);
+        e.flags = e.flags | InferFlag::Exact;
+        result.events.push_back(e);
+    }
+
+    // Swaps
+    if (trades > 0) {
+        int dirs = (dvol[0] > 0 ? 1 : 0) + (dvol[1] > 0 ? 1 : 0);
+        uint32_t base_flags = trades > 1 ? static_cast<uint32_t>(InferFlag::Aggregated) : 0;
+        if (dsum != dvol[0] + dvol[1]) base_flags = base_flags | InferFlag::CounterMismatch;
+
+        if (dirs == 1 && !lp_changed) {
+            uint8_t in = dvol[0] > 0 ? 0 : 1;
+            uint8_t out = static_cast<uint8_t>(1 - in);
+            InferredEvent e = detail::make_event(EventKind::Swap, opts.slot);
+            e.token_in = in;
+            e.token_out = out;
+            e.amount_in = dvol[in];
+            e.trade_count = trades;
+            uint64_t fee_out = gain(fee_before[out], fee_after[out]);
+            uint64_t drop = loss(bal_before[out], bal_after[out]);
+            e.amount_out = drop > fee_out ? drop - fee_out : 0;
+            e.flags = base_flags;
+            if (gain(bal_before[in], bal_after[in]) != e.amount_in || drop < fee_out) {
+                e.flags = e.flags | InferFlag::CounterMismatch;
+            }
+            if (trades == 1) {
+                if (!(e.flags & static_cast<uint32_t>(InferFlag::CounterMismatch))) {
+                    e.flags = e.flags | InferFlag::Exact;
+                }
+                detail::verify_swap(e, math::simulate_swap(bal_before[in], bal_before[out],
+                                                           e.amount_in, amp, before.fee_bps),
+                                    opts.verify_tolerance_bps);
+            }
+            residual[0] = 0;
+            residual[1] = 0;
+            result.events.push_back(e);
+        } else {
+            // Both directions, liquidity in the same interval, or volume
+            // counters not moving: estimate outputs from the earlier state.
+            uint32_t flags = base_flags | (dirs == 2 ? InferFlag::Ambiguous : InferFlag::None) |
+                             (lp_changed ? InferFlag::Mixed : InferFlag::None);
+            if (dirs == 0) {
+                // Fall back to balance signs
+                flags = flags | InferFlag::Ambiguous | InferFlag::CounterMismatch;
+                if (residual[0] > 0 && residual[1] < 0) {
+                    InferredEvent e = detail::make_event(EventKind::Swap, opts.slot);
+                    e.token_in = 0;
+                    e.token_out = 1;
+                    e.amount_in = static_cast<uint64_t>(residual[0]);
+                    e.amount_out = static_cast<uint64_t>(-residual[1]);
+                    e.trade_count = trades;
+                    e.flags = flags;
+                    result.events.push_back(e);
+                    residual[0] = residual[1] = 0;
+                } else if (residual[1] > 0 && residual[0] < 0) {
+                    InferredEvent e = detail::make_event(EventKind::Swap, opts.slot);
+                    e.token_in = 1;
+                    e.token_out = 0;
+                    e.amount_in = static_cast<uint64_t>(residual[1]);
+                    e.amount_out = static_cast<uint64_t>(-residual[0]);
+                    e.trade_count = trades;
+                    e.flags = flags;
+                    result.events.push_back(e);
+                    residual[0] = residual[1] = 0;
+                } else {
+                    result.flags = result.flags | InferFlag::Unexplained;
+                }
+            } else {
+                for (uint8_t in = 0; in < 2; in++) {
+                    if (dvol[in] == 0) continue;
+                    uint8_t out = static_cast<uint8_t>(1 - in);
+                    InferredEvent e = detail::make_event(EventKind::Swap, opts.slot);
+                    e.token_in = in;
+                    e.token_out = out;
+                    e.amount_in = dvol[in];
+                    e.amount_out = math::simulate_swap(bal_before[in], bal_before[out],
+                                                       dvol[in], amp, before.fee_bps).value_or(0);
+                    // Split trade count in proportion to volume when both directions traded
+                    e.trade_count = dirs == 2 ? 0 : trades;
+                    e.flags = flags;
+                    residual[in] -= static_cast<int64_t>(e.amount_in);
+                    residual[out] += static_cast<int64_t>(e.amount_out +
+                                                          gain(fee_before[out], fee_after[out]));
+                    result.events.push_back(e);
+                }
+                if (dirs == 2) {
+                    // Attribute trades by volume share (at least one each)
+                    size_t n = result.events.size();
+                    InferredEvent& a = result.events[n - 2];
+                    InferredEvent& b = result.events[n - 1];
+                    __uint128_t total = static_cast<__uint128_t>(a.amount_in) + b.amount_in;
+                    uint64_t ta = static_cast<uint64_t>(
+                        static_cast<__uint128_t>(trades) * a.amount_in / total);
+                    if (ta == 0) ta = 1;
+                    if (ta >= trades) ta = trades - 1;
+                    a.trade_count = ta;
+                    b.trade_count = trades - ta;
+                }
+            }
+        }
+    } else if (dvol[0] != 0 || dvol[1] != 0 || dsum != 0) {
+        result.flags = result.flags | InferFlag::CounterMismatch;
+    }
+
+    // Liquidity
+    if (lp_changed) {
+        bool deposit = after.lp_supply > before.lp_supply;
+        InferredEvent e = detail::make_event(deposit ? EventKind::Deposit : EventKind::Withdraw,
+                                             opts.slot);
+        e.lp_amount = deposit ? after.lp_supply - before.lp_supply
+                              : before.lp_supply - after.lp_supply;
+        for (int i = 0; i < 2; i++) {
+            int64_t r = deposit ? residual[i] : -residual[i];
+            e.amounts[i] = r > 0 ? static_cast<uint64_t>(r) : 0;
+        }
+        e.flags = trades > 0 ? static_cast<uint32_t>(InferFlag::Mixed)
+                             : static_cast<uint32_t>(InferFlag::Exact);
+        if ((deposit && (residual[0] < 0 || residual[1] < 0)) ||
+            (!deposit && (residual[0] > 0 || residual[1] > 0))) {
+            e.flags = e.flags | InferFlag::CounterMismatch;
+        }
+        result.events.push_back(e);
+    } else if (trades == 0 && (residual[0] != 0 || residual[1] != 0)) {
+        result.flags = result.flags | InferFlag::Unexplained;
+    }
+
+    return result;
+}
+
+// ============================================================================
+// NPool (N-token)
+// ============================================================================
+
+/**
+ * Infer events between two snapshots of the same N-token pool.
+ * total_volume is taken as the sum of swap inputs.
+ */
+inline InferenceResult infer_npool_events(const NPool& before, const NPool& after,
+                                          const InferenceOptions& opts = {}) {
+    using detail::gain;
+    using detail::loss;
+
+    InferenceResult result;
+    if (after.trade_count < before.trade_count || after.total_volume < before.total_volume ||
+        before.n_tokens != after.n_tokens) {
+        result.flags = result.flags | InferFlag::Regression;
+        return result;
+    }
+
+    const uint8_t n = before.n_tokens > MAX_TOKENS ? MAX_TOKENS : before.n_tokens;
+    const uint64_t trades = after.trade_count - before.trade_count;
+    const uint64_t dvol = after.total_volume - before.total_volume;
+    const bool lp_changed = after.lp_supply != before.lp_supply;
+
+    // Admin fee claims
+    {
+        InferredEvent e = detail::make_event(EventKind::AdminFeeClaim, opts.slot);
+        bool any = false;
+        for (uint8_t i = 0; i < n; i++) {
+            e.amounts[i] = loss(before.admin_fees[i], after.admin_fees[i]);
+            any = any || e.amounts[i] != 0;
+        }
+        if (any) {
+            e.flags = e.flags | InferFlag::Exact;
+            result.events.push_back(e);
+        }
+    }
+
+    // Balance movement net of admin fee growth (fee share leaves the balance)
+    int64_t net[MAX_TOKENS] = {};
+    uint8_t gainers = 0, losers = 0;
+    uint8_t top_in = 0, top_out = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        net[i] = static_cast<int64_t>(after.balances[i] - before.balances[i]) +
+                 static_cast<int64_t>(gain(before.admin_fees[i], after.admin_fees[i]));
+        if (net[i] > 0) {
+            gainers++;
+            if (net[i] > net[top_in] || net[top_in] <= 0) top_in = i;
+        } else if (net[i] < 0) {
+            losers++;
+            if (net[i] < net[top_out] || net[top_out] >= 0) top_out = i;
+        }
+    }
+
+    if (trades > 0 && !lp_changed) {
+        InferredEvent e = detail::make_event(EventKind::Swap, opts.slot);
+        e.trade_count = trades;
+        if (gainers >= 1 && losers >= 1) {
+            e.token_in = top_in;
+            e.token_out = top_out;
+            e.amount_in = static_cast<uint64_t>(net[top_in]);
+            e.amount_out = static_cast<uint64_t>(-net[top_out]);
+            e.flags = trades > 1 ? static_cast<uint32_t>(InferFlag::Aggregated) : 0;
+            if (gainers > 1 || losers > 1) e.flags = e.flags | InferFlag::Ambiguous;
+            if (dvol != 0 && dvol != e.amount_in) e.flags = e.flags | InferFlag::CounterMismatch;
+            if (trades == 1 && gainers == 1 && losers == 1) {
+                if (!(e.flags & static_cast<uint32_t>(InferFlag::CounterMismatch))) {
+                    e.flags = e.flags | InferFlag::Exact;
+                }
+                detail::verify_swap(e, math::simulate_swap_n(before.balances, n, e.token_in,
+                                                             e.token_out, e.amount_in,
+                                                             before.amp, before.fee_bps),
+                                    opts.verify_tolerance_bps);
+            }
+            result.events.push_back(e);
+        } else {
+            result.flags = result.flags | InferFlag::Unexplained | InferFlag::CounterMismatch;
+        }
+    } else if (lp_changed) {
+        // Swaps in the same interval cannot be separated from the N-way
+        // liquidity change; they are folded into this event's trade_count.
+        bool deposit = after.lp_supply > before.lp_supply;
+        InferredEvent e = detail::make_event(deposit ? EventKind::Deposit : EventKind::Withdraw,
+                                             opts.slot);
+        e.lp_amount = deposit ? after.lp_supply - before.lp_supply
+                              : before.lp_supply - after.lp_supply;
+        bool consistent = true;
+        for (uint8_t i = 0; i < n; i++) {
+            int64_t r = deposit ? net[i] : -net[i];
+            e.amounts[i] = r > 0 ? static_cast<uint64_t>(r) : 0;
+            consistent = consistent && r >= 0;
+        }
+        e.flags = trades > 0 ? (InferFlag::Mixed | InferFlag::Ambiguous)
+                             : static_cast<uint32_t>(InferFlag::Exact);
+        if (!consistent && trades == 0) e.flags = e.flags | InferFlag::CounterMismatch;
+        e.trade_count = trades;
+        result.events.push_back(e);
+    } else if (gainers > 0 || losers > 0 || dvol != 0) {
+        result.flags = result.flags | InferFlag::Unexplained;
+    }
+
+    return result;
+}
+
+}  // namespace aex402
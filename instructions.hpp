@@ -11,8 +11,11 @@
 #include <array>
 #include <string>
 #include <cstring>
+#include <optional>
 #include "constants.hpp"
 #include "types.hpp"
+#include "math.hpp"
+#include "trace.hpp"
 
 namespace aex402 {
 
@@ -48,6 +51,7 @@ public:
      * Accounts: [pool, mint0, mint1, authority(signer), system_program]
      */
     static InstructionBuilder createpool(uint64_t amp, uint8_t bump) {
+        AEX402_TRACE_SCOPE("encode.createpool");
         InstructionBuilder b;
         b.write_u64(disc::CREATEPOOL);
         b.write_u64(amp);
@@ -60,6 +64,7 @@ public:
      * Accounts: [pool, mint0, mint1, ..., mintN, authority(signer), system_program]
      */
     static InstructionBuilder createpn(uint64_t amp, uint8_t n_tokens, uint8_t bump) {
+        AEX402_TRACE_SCOPE("encode.createpn");
         InstructionBuilder b;
         b.write_u64(disc::CREATEPN);
         b.write_u64(amp);
@@ -73,6 +78,7 @@ public:
      * Accounts: [pool, vault, authority(signer), system_program]
      */
     static InstructionBuilder initt0v() {
+        AEX402_TRACE_SCOPE("encode.initt0v");
         InstructionBuilder b;
         b.write_u64(disc::INITT0V);
         return b;
@@ -83,6 +89,7 @@ public:
      * Accounts: [pool, vault, authority(signer), system_program]
      */
     static InstructionBuilder initt1v() {
+        AEX402_TRACE_SCOPE("encode.initt1v");
         InstructionBuilder b;
         b.write_u64(disc::INITT1V);
         return b;
@@ -93,6 +100,7 @@ public:
      * Accounts: [pool, lp_mint, authority(signer), system_program]
      */
     static InstructionBuilder initlpm() {
+        AEX402_TRACE_SCOPE("encode.initlpm");
         InstructionBuilder b;
         b.write_u64(disc::INITLPM);
         return b;
@@ -108,6 +116,7 @@ public:
      */
     static InstructionBuilder swap(uint8_t from, uint8_t to, uint64_t amount_in,
                                     uint64_t min_out, int64_t deadline) {
+        AEX402_TRACE_SCOPE("encode.swap");
         InstructionBuilder b;
         b.write_u64(disc::SWAP);
         b.write_u8(from);
@@ -123,6 +132,7 @@ public:
      * Accounts: [pool, vault0, vault1, user_t0, user_t1, user(signer), token_program]
      */
     static InstructionBuilder swapt0t1(uint64_t amount_in, uint64_t min_out) {
+        AEX402_TRACE_SCOPE("encode.swapt0t1");
         InstructionBuilder b;
         b.write_u64(disc::SWAPT0T1);
         b.write_u64(amount_in);
@@ -135,6 +145,7 @@ public:
      * Accounts: [pool, vault0, vault1, user_t0, user_t1, user(signer), token_program]
      */
     static InstructionBuilder swapt1t0(uint64_t amount_in, uint64_t min_out) {
+        AEX402_TRACE_SCOPE("encode.swapt1t0");
         InstructionBuilder b;
         b.write_u64(disc::SWAPT1T0);
         b.write_u64(amount_in);
@@ -148,6 +159,7 @@ public:
      */
     static InstructionBuilder swapn(uint8_t from_idx, uint8_t to_idx,
                                      uint64_t amount_in, uint64_t min_out) {
+        AEX402_TRACE_SCOPE("encode.swapn");
         InstructionBuilder b;
         b.write_u64(disc::SWAPN);
         b.write_u8(from_idx);
@@ -162,6 +174,7 @@ public:
      * Accounts: same as swapt0t1
      */
     static InstructionBuilder migt0t1(uint64_t amount_in, uint64_t min_out) {
+        AEX402_TRACE_SCOPE("encode.migt0t1");
         InstructionBuilder b;
         b.write_u64(disc::MIGT0T1);
         b.write_u64(amount_in);
@@ -174,6 +187,7 @@ public:
      * Accounts: same as swapt1t0
      */
     static InstructionBuilder migt1t0(uint64_t amount_in, uint64_t min_out) {
+        AEX402_TRACE_SCOPE("encode.migt1t0");
         InstructionBuilder b;
         b.write_u64(disc::MIGT1T0);
         b.write_u64(amount_in);
@@ -190,6 +204,7 @@ public:
      * Accounts: [pool, vault0, vault1, lp_mint, user_t0, user_t1, user_lp, user(signer), token_program]
      */
     static InstructionBuilder addliq(uint64_t amount0, uint64_t amount1, uint64_t min_lp) {
+        AEX402_TRACE_SCOPE("encode.addliq");
         InstructionBuilder b;
         b.write_u64(disc::ADDLIQ);
         b.write_u64(amount0);
@@ -203,6 +218,7 @@ public:
      * Accounts: [pool, vault_in, lp_mint, user_in, user_lp, user(signer), token_program]
      */
     static InstructionBuilder addliq1(uint64_t amount_in, uint64_t min_lp) {
+        AEX402_TRACE_SCOPE("encode.addliq1");
         InstructionBuilder b;
         b.write_u64(disc::ADDLIQ1);
         b.write_u64(amount_in);
@@ -215,6 +231,7 @@ public:
      * Accounts: [pool, vault0..vaultN, lp_mint, user_t0..user_tN, user_lp, user(signer), token_program]
      */
     static InstructionBuilder addliqn(const std::vector<uint64_t>& amounts, uint64_t min_lp) {
+        AEX402_TRACE_SCOPE("encode.addliqn");
         InstructionBuilder b;
         b.write_u64(disc::ADDLIQN);
         for (auto amt : amounts) {
@@ -229,6 +246,7 @@ public:
      * Accounts: [pool, vault0, vault1, lp_mint, user_t0, user_t1, user_lp, user(signer), token_program]
      */
     static InstructionBuilder remliq(uint64_t lp_amount, uint64_t min0, uint64_t min1) {
+        AEX402_TRACE_SCOPE("encode.remliq");
         InstructionBuilder b;
         b.write_u64(disc::REMLIQ);
         b.write_u64(lp_amount);
@@ -242,6 +260,7 @@ public:
      * Accounts: [pool, vault0..vaultN, lp_mint, user_t0..user_tN, user_lp, user(signer), token_program]
      */
     static InstructionBuilder remliqn(uint64_t lp_amount, const std::vector<uint64_t>& mins) {
+        AEX402_TRACE_SCOPE("encode.remliqn");
         InstructionBuilder b;
         b.write_u64(disc::REMLIQN);
         b.write_u64(lp_amount);
@@ -260,6 +279,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder setpause(bool paused) {
+        AEX402_TRACE_SCOPE("encode.setpause");
         InstructionBuilder b;
         b.write_u64(disc::SETPAUSE);
         b.write_u8(paused ? 1 : 0);
@@ -271,6 +291,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder updfee(uint64_t fee_bps) {
+        AEX402_TRACE_SCOPE("encode.updfee");
         InstructionBuilder b;
         b.write_u64(disc::UPDFEE);
         b.write_u64(fee_bps);
@@ -282,6 +303,7 @@ public:
      * Accounts: [pool, vault0, vault1, dest0, dest1, authority(signer), token_program]
      */
     static InstructionBuilder wdrawfee() {
+        AEX402_TRACE_SCOPE("encode.wdrawfee");
         InstructionBuilder b;
         b.write_u64(disc::WDRAWFEE);
         return b;
@@ -292,6 +314,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder commitamp(uint64_t target_amp) {
+        AEX402_TRACE_SCOPE("encode.commitamp");
         InstructionBuilder b;
         b.write_u64(disc::COMMITAMP);
         b.write_u64(target_amp);
@@ -303,6 +326,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder rampamp(uint64_t target_amp, int64_t duration) {
+        AEX402_TRACE_SCOPE("encode.rampamp");
         InstructionBuilder b;
         b.write_u64(disc::RAMPAMP);
         b.write_u64(target_amp);
@@ -315,6 +339,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder stopramp() {
+        AEX402_TRACE_SCOPE("encode.stopramp");
         InstructionBuilder b;
         b.write_u64(disc::STOPRAMP);
         return b;
@@ -325,6 +350,7 @@ public:
      * Accounts: [pool, authority(signer), new_authority]
      */
     static InstructionBuilder initauth() {
+        AEX402_TRACE_SCOPE("encode.initauth");
         InstructionBuilder b;
         b.write_u64(disc::INITAUTH);
         return b;
@@ -335,6 +361,7 @@ public:
      * Accounts: [pool, new_authority(signer)]
      */
     static InstructionBuilder complauth() {
+        AEX402_TRACE_SCOPE("encode.complauth");
         InstructionBuilder b;
         b.write_u64(disc::COMPLAUTH);
         return b;
@@ -345,6 +372,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder cancelauth() {
+        AEX402_TRACE_SCOPE("encode.cancelauth");
         InstructionBuilder b;
         b.write_u64(disc::CANCELAUTH);
         return b;
@@ -359,6 +387,7 @@ public:
      * Accounts: [farm, pool, reward_mint, authority(signer), system_program]
      */
     static InstructionBuilder createfarm(uint64_t reward_rate, int64_t start_time, int64_t end_time) {
+        AEX402_TRACE_SCOPE("encode.createfarm");
         InstructionBuilder b;
         b.write_u64(disc::CREATEFARM);
         b.write_u64(reward_rate);
@@ -372,6 +401,7 @@ public:
      * Accounts: [user_position, farm, user_lp, lp_vault, user(signer), token_program]
      */
     static InstructionBuilder stakelp(uint64_t amount) {
+        AEX402_TRACE_SCOPE("encode.stakelp");
         InstructionBuilder b;
         b.write_u64(disc::STAKELP);
         b.write_u64(amount);
@@ -383,6 +413,7 @@ public:
      * Accounts: [user_position, farm, user_lp, lp_vault, user(signer), token_program]
      */
     static InstructionBuilder unstakelp(uint64_t amount) {
+        AEX402_TRACE_SCOPE("encode.unstakelp");
         InstructionBuilder b;
         b.write_u64(disc::UNSTAKELP);
         b.write_u64(amount);
@@ -394,6 +425,7 @@ public:
      * Accounts: [user_position, farm, pool, reward_vault, user_reward, user(signer), token_program]
      */
     static InstructionBuilder claimfarm() {
+        AEX402_TRACE_SCOPE("encode.claimfarm");
         InstructionBuilder b;
         b.write_u64(disc::CLAIMFARM);
         return b;
@@ -404,6 +436,7 @@ public:
      * Accounts: [user_position, farm, user(signer), system_program]
      */
     static InstructionBuilder locklp(uint64_t amount, int64_t duration) {
+        AEX402_TRACE_SCOPE("encode.locklp");
         InstructionBuilder b;
         b.write_u64(disc::LOCKLP);
         b.write_u64(amount);
@@ -416,6 +449,7 @@ public:
      * Accounts: [user_position, farm, user(signer), system_program]
      */
     static InstructionBuilder claimulp() {
+        AEX402_TRACE_SCOPE("encode.claimulp");
         InstructionBuilder b;
         b.write_u64(disc::CLAIMULP);
         return b;
@@ -430,6 +464,7 @@ public:
      * Accounts: [lottery(writable), pool, lottery_vault, authority(signer), system_program]
      */
     static InstructionBuilder createlot(uint64_t ticket_price, int64_t end_time) {
+        AEX402_TRACE_SCOPE("encode.createlot");
         InstructionBuilder b;
         b.write_u64(disc::CREATELOT);
         b.write_u64(ticket_price);
@@ -442,6 +477,7 @@ public:
      * Accounts: [lottery, user_entry, user(signer), user_lp, lottery_vault, token_program]
      */
     static InstructionBuilder enterlot(uint64_t ticket_count) {
+        AEX402_TRACE_SCOPE("encode.enterlot");
         InstructionBuilder b;
         b.write_u64(disc::ENTERLOT);
         b.write_u64(ticket_count);
@@ -453,6 +489,7 @@ public:
      * Accounts: [lottery, authority(signer), recent_slothashes]
      */
     static InstructionBuilder drawlot(uint64_t random_seed) {
+        AEX402_TRACE_SCOPE("encode.drawlot");
         InstructionBuilder b;
         b.write_u64(disc::DRAWLOT);
         b.write_u64(random_seed);
@@ -464,6 +501,7 @@ public:
      * Accounts: [lottery, user_entry, user(signer), user_lp, lottery_vault, pool, token_program]
      */
     static InstructionBuilder claimlot() {
+        AEX402_TRACE_SCOPE("encode.claimlot");
         InstructionBuilder b;
         b.write_u64(disc::CLAIMLOT);
         return b;
@@ -477,6 +515,7 @@ public:
      * Initialize pool registry.
      */
     static InstructionBuilder initreg() {
+        AEX402_TRACE_SCOPE("encode.initreg");
         InstructionBuilder b;
         b.write_u64(disc::INITREG);
         return b;
@@ -486,6 +525,7 @@ public:
      * Register pool in registry.
      */
     static InstructionBuilder regpool() {
+        AEX402_TRACE_SCOPE("encode.regpool");
         InstructionBuilder b;
         b.write_u64(disc::REGPOOL);
         return b;
@@ -495,6 +535,7 @@ public:
      * Unregister pool from registry.
      */
     static InstructionBuilder unregpool() {
+        AEX402_TRACE_SCOPE("encode.unregpool");
         InstructionBuilder b;
         b.write_u64(disc::UNREGPOOL);
         return b;
@@ -504,6 +545,7 @@ public:
      * Initiate registry authority transfer.
      */
     static InstructionBuilder initrega() {
+        AEX402_TRACE_SCOPE("encode.initrega");
         InstructionBuilder b;
         b.write_u64(disc::INITREGA);
         return b;
@@ -513,6 +555,7 @@ public:
      * Complete registry authority transfer.
      */
     static InstructionBuilder complrega() {
+        AEX402_TRACE_SCOPE("encode.complrega");
         InstructionBuilder b;
         b.write_u64(disc::COMPLREGA);
         return b;
@@ -522,6 +565,7 @@ public:
      * Cancel registry authority transfer.
      */
     static InstructionBuilder cancelrega() {
+        AEX402_TRACE_SCOPE("encode.cancelrega");
         InstructionBuilder b;
         b.write_u64(disc::CANCELREGA);
         return b;
@@ -536,6 +580,7 @@ public:
      * Accounts: [pool]
      */
     static InstructionBuilder gettwap(TwapWindow window) {
+        AEX402_TRACE_SCOPE("encode.gettwap");
         InstructionBuilder b;
         b.write_u64(disc::GETTWAP);
         b.write_u8(static_cast<uint8_t>(window));
@@ -552,6 +597,7 @@ public:
      */
     static InstructionBuilder setcb(uint64_t price_dev_bps, uint64_t volume_mult,
                                      uint64_t cooldown_slots, uint64_t auto_resume_slots) {
+        AEX402_TRACE_SCOPE("encode.setcb");
         InstructionBuilder b;
         b.write_u64(disc::SETCB);
         b.write_u64(price_dev_bps);
@@ -566,6 +612,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder resetcb() {
+        AEX402_TRACE_SCOPE("encode.resetcb");
         InstructionBuilder b;
         b.write_u64(disc::RESETCB);
         return b;
@@ -580,6 +627,7 @@ public:
      * Accounts: [pool, authority(signer)]
      */
     static InstructionBuilder setrl(uint64_t max_vol, uint32_t max_swaps) {
+        AEX402_TRACE_SCOPE("encode.setrl");
         InstructionBuilder b;
         b.write_u64(disc::SETRL);
         b.write_u64(max_vol);
@@ -596,6 +644,7 @@ public:
      */
     static InstructionBuilder govprop(ProposalType prop_type, uint64_t value,
                                        const std::string& description) {
+        AEX402_TRACE_SCOPE("encode.govprop");
         InstructionBuilder b;
         b.write_u64(disc::GOVPROP);
         b.write_u8(static_cast<uint8_t>(prop_type));
@@ -615,6 +664,7 @@ public:
      * Vote on proposal.
      */
     static InstructionBuilder govvote(bool vote_for) {
+        AEX402_TRACE_SCOPE("encode.govvote");
         InstructionBuilder b;
         b.write_u64(disc::GOVVOTE);
         b.write_u8(vote_for ? 1 : 0);
@@ -625,6 +675,7 @@ public:
      * Execute passed proposal.
      */
     static InstructionBuilder govexec() {
+        AEX402_TRACE_SCOPE("encode.govexec");
         InstructionBuilder b;
         b.write_u64(disc::GOVEXEC);
         return b;
@@ -634,6 +685,7 @@ public:
      * Cancel proposal.
      */
     static InstructionBuilder govcncl() {
+        AEX402_TRACE_SCOPE("encode.govcncl");
         InstructionBuilder b;
         b.write_u64(disc::GOVCNCL);
         return b;
@@ -647,6 +699,7 @@ public:
      * Initialize orderbook for pool.
      */
     static InstructionBuilder initbook() {
+        AEX402_TRACE_SCOPE("encode.initbook");
         InstructionBuilder b;
         b.write_u64(disc::INITBOOK);
         return b;
@@ -657,6 +710,7 @@ public:
      */
     static InstructionBuilder placeord(OrderType order_type, uint64_t price,
                                         uint64_t amount, int64_t expiry) {
+        AEX402_TRACE_SCOPE("encode.placeord");
         InstructionBuilder b;
         b.write_u64(disc::PLACEORD);
         b.write_u8(static_cast<uint8_t>(order_type));
@@ -670,6 +724,7 @@ public:
      * Cancel limit order.
      */
     static InstructionBuilder cancelord(uint8_t order_index) {
+        AEX402_TRACE_SCOPE("encode.cancelord");
         InstructionBuilder b;
         b.write_u64(disc::CANCELORD);
         b.write_u8(order_index);
@@ -680,6 +735,7 @@ public:
      * Fill limit order (keeper).
      */
     static InstructionBuilder fillord(uint8_t order_index) {
+        AEX402_TRACE_SCOPE("encode.fillord");
         InstructionBuilder b;
         b.write_u64(disc::FILLORD);
         b.write_u8(order_index);
@@ -694,6 +750,7 @@ public:
      * Initialize CL pool extension.
      */
     static InstructionBuilder initclpl() {
+        AEX402_TRACE_SCOPE("encode.initclpl");
         InstructionBuilder b;
         b.write_u64(disc::INITCLPL);
         return b;
@@ -704,6 +761,7 @@ public:
      */
     static InstructionBuilder clmint(int16_t tick_lower, int16_t tick_upper,
                                       uint64_t amount0, uint64_t amount1) {
+        AEX402_TRACE_SCOPE("encode.clmint");
         InstructionBuilder b;
         b.write_u64(disc::CLMINT);
         b.write_i16(tick_lower);
@@ -717,6 +775,7 @@ public:
      * Burn CL position (remove liquidity).
      */
     static InstructionBuilder clburn(uint64_t liquidity) {
+        AEX402_TRACE_SCOPE("encode.clburn");
         InstructionBuilder b;
         b.write_u64(disc::CLBURN);
         b.write_u64(liquidity);
@@ -727,6 +786,7 @@ public:
      * Collect accumulated CL fees.
      */
     static InstructionBuilder clcollect() {
+        AEX402_TRACE_SCOPE("encode.clcollect");
         InstructionBuilder b;
         b.write_u64(disc::CLCOLLECT);
         return b;
@@ -736,6 +796,7 @@ public:
      * Swap through concentrated liquidity.
      */
     static InstructionBuilder clswap(uint64_t amount_in, uint64_t min_out, bool zero_for_one) {
+        AEX402_TRACE_SCOPE("encode.clswap");
         InstructionBuilder b;
         b.write_u64(disc::CLSWAP);
         b.write_u64(amount_in);
@@ -752,6 +813,7 @@ public:
      * Initiate flash loan.
      */
     static InstructionBuilder flashloan(uint64_t amount0, uint64_t amount1) {
+        AEX402_TRACE_SCOPE("encode.flashloan");
         InstructionBuilder b;
         b.write_u64(disc::FLASHLOAN);
         b.write_u64(amount0);
@@ -763,6 +825,7 @@ public:
      * Flash loan repay callback.
      */
     static InstructionBuilder flashrepy() {
+        AEX402_TRACE_SCOPE("encode.flashrepy");
         InstructionBuilder b;
         b.write_u64(disc::FLASHREPY);
         return b;
@@ -777,6 +840,7 @@ public:
      */
     static InstructionBuilder multihop(uint64_t amount_in, uint64_t min_out, int64_t deadline,
                                         const std::vector<uint8_t>& directions) {
+        AEX402_TRACE_SCOPE("encode.multihop");
         InstructionBuilder b;
         b.write_u64(disc::MULTIHOP);
         b.write_u64(amount_in);
@@ -799,6 +863,7 @@ public:
     static InstructionBuilder initml(bool is_stable, uint16_t min_fee, uint16_t max_fee,
                                       uint16_t min_amp, uint16_t max_amp,
                                       uint16_t fee_step, uint16_t amp_step) {
+        AEX402_TRACE_SCOPE("encode.initml");
         InstructionBuilder b;
         b.write_u64(disc::INITML);
         b.write_u8(is_stable ? 1 : 0);
@@ -815,6 +880,7 @@ public:
      * Configure ML brain parameters.
      */
     static InstructionBuilder cfgml(bool enabled, bool auto_apply) {
+        AEX402_TRACE_SCOPE("encode.cfgml");
         InstructionBuilder b;
         b.write_u64(disc::CFGML);
         b.write_u8(enabled ? 1 : 0);
@@ -826,6 +892,7 @@ public:
      * Batch Q-learning training (bot-triggered).
      */
     static InstructionBuilder trainml() {
+        AEX402_TRACE_SCOPE("encode.trainml");
         InstructionBuilder b;
         b.write_u64(disc::TRAINML);
         return b;
@@ -835,6 +902,7 @@ public:
      * Apply ML-suggested action manually.
      */
     static InstructionBuilder applyml(MLAction action) {
+        AEX402_TRACE_SCOPE("encode.applyml");
         InstructionBuilder b;
         b.write_u64(disc::APPLYML);
         b.write_u8(static_cast<uint8_t>(action));
@@ -845,6 +913,7 @@ public:
      * Log ML state for monitoring.
      */
     static InstructionBuilder logml() {
+        AEX402_TRACE_SCOPE("encode.logml");
         InstructionBuilder b;
         b.write_u64(disc::LOGML);
         return b;
@@ -858,6 +927,7 @@ public:
      * Transfer hook execute (called on every LP transfer).
      */
     static InstructionBuilder th_exec() {
+        AEX402_TRACE_SCOPE("encode.th_exec");
         InstructionBuilder b;
         b.write_u64(disc::TH_EXEC);
         return b;
@@ -867,6 +937,7 @@ public:
      * Transfer hook init (initialize ExtraAccountMetaList).
      */
     static InstructionBuilder th_init() {
+        AEX402_TRACE_SCOPE("encode.th_init");
         InstructionBuilder b;
         b.write_u64(disc::TH_INIT);
         return b;
@@ -913,4 +984,91 @@ private:
     }
 };
 
+// ============================================================================
+// Swap Limit Patching
+// ============================================================================
+
+/**
+ * Byte offsets of the slippage fields in an encoded swap instruction.
+ */
+struct SwapLimitOffsets {
+    size_t min_out;
+    size_t deadline;    // 0 if the instruction has no deadline field
+    size_t min_len;     // Shortest valid encoding
+};
+
+/**
+ * Locate min_out/deadline in encoded swap data by its discriminator.
+ * Covers swap, swapt0t1, swapt1t0, swapn, migt0t1, migt1t0, multihop
+ * and clswap; returns nullopt for anything else or truncated data.
+ */
+inline std::optional<SwapLimitOffsets> swap_limit_offsets(const uint8_t* data, size_t len) {
+    if (len < 8) return std::nullopt;
+    SwapLimitOffsets o;
+    switch (detail::load_le<uint64_t>(data)) {
+        case disc::SWAP:      o = {18, 26, 34}; break;
+        case disc::SWAPT0T1:
+        case disc::SWAPT1T0:
+        case disc::MIGT0T1:
+        case disc::MIGT1T0:   o = {16, 0, 24}; break;
+        case disc::SWAPN:     o = {18, 0, 26}; break;
+        case disc::MULTIHOP:  o = {16, 24, 33}; break;
+        case disc::CLSWAP:    o = {16, 0, 25}; break;
+        default:              return std::nullopt;
+    }
+    if (len < o.min_len) return std::nullopt;
+    return o;
+}
+
+/**
+ * Overwrite min_out, and the deadline where the instruction has one, in
+ * encoded swap data. Returns false (leaving data untouched) for non-swap
+ * or truncated data.
+ */
+inline bool patch_swap_limits(uint8_t* data, size_t len, uint64_t min_out,
+                              std::optional<int64_t> deadline = std::nullopt) {
+    auto o = swap_limit_offsets(data, len);
+    if (!o) return false;
+    detail::store_le<uint64_t>(data + o->min_out, min_out);
+    if (deadline && o->deadline) detail::store_le<int64_t>(data + o->deadline, *deadline);
+    return true;
+}
+
+/**
+ * Fill slippage limits of pre-encoded swap instructions in place:
+ *   min_out[i]  = math::calc_min_output(quotes[i], slippage_bps[i])
+ *   deadline[i] = deadlines[i]   (only if deadlines is non-empty)
+ *
+ * quotes and slippage_bps must match instructions in length, and
+ * deadlines must be empty or match too; otherwise nothing is written.
+ * An instruction is skipped if it is not a swap, is truncated, its quote
+ * is 0, or its slippage is 100% or more (any of which would write a zero
+ * min_out and disable slippage protection).
+ *
+ * @param patched If non-null, resized and set to 1 for each patched instruction
+ * @return Number of instructions patched
+ */
+inline size_t fill_swap_limits(std::vector<std::vector<uint8_t>>& instructions,
+                               const std::vector<uint64_t>& quotes,
+                               const std::vector<uint64_t>& slippage_bps,
+                               const std::vector<int64_t>& deadlines = {},
+                               std::vector<uint8_t>* patched = nullptr) {
+    size_t n = instructions.size();
+    if (patched) patched->assign(n, 0);
+    if (quotes.size() != n || slippage_bps.size() != n) return 0;
+    if (!deadlines.empty() && deadlines.size() != n) return 0;
+
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (quotes[i] == 0 || slippage_bps[i] >= math::FEE_DENOMINATOR) continue;
+        uint64_t min_out = math::calc_min_output(quotes[i], slippage_bps[i]);
+        std::optional<int64_t> deadline;
+        if (!deadlines.empty()) deadline = deadlines[i];
+        if (!patch_swap_limits(instructions[i].data(), instructions[i].size(), min_out, deadline)) continue;
+        if (patched) (*patched)[i] = 1;
+        count++;
+    }
+    return count;
+}
+
 }  // namespace aex402
@@ -0,0 +1,459 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Account Layout Tables
+ *
+ * Compile-time offset tables for the on-chain account layouts.
+ * Each field is described by its type and byte offset; static_asserts tie
+ * every entry to offsetof() on the packed structs in types.hpp, so the
+ * memcpy parsers and the field-by-field parsers read identical bytes, and
+ * check each account's exact data size, so a field added to or dropped
+ * from a struct fails the build.
+ *
+ * Usage:
+ *   uint64_t bal0 = layout::pool::bal0::read(data);
+ *   uint64_t b2 = layout::npool::balances::read_at(data, 2);
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include "types.hpp"
+#include "constants.hpp"
+
+namespace aex402 {
+namespace layout {
+
+// ============================================================================
+// Field Descriptors
+// ============================================================================
+
+/**
+ * A single field of type T at byte offset Offset.
+ */
+template <typename T, size_t Offset>
+struct Field {
+    using type = T;
+    static constexpr size_t offset = Offset;
+    static constexpr size_t size = sizeof(T);
+    static constexpr size_t end = Offset + sizeof(T);
+
+    // Read the field from raw account data (no alignment requirement)
+    static T read(const uint8_t* data) {
+        return aex402::detail::load_le<T>(data + Offset);
+    }
+
+    // Read element i of an array field (e.g. balances, hours)
+    template <typename U = T>
+    static typename U::value_type read_at(const uint8_t* data, size_t i) {
+        using E = typename U::value_type;
+        return aex402::detail::load_le<E>(data + Offset + i * sizeof(E));
+    }
+
+    // Copy the field's bytes into dst (e.g. an array member of a packed struct)
+    static void read_into(void* dst, const uint8_t* data) {
+        std::memcpy(dst, data + Offset, sizeof(T));
+    }
+};
+
+namespace detail {
+
+template <size_t N>
+constexpr bool fields_contiguous(const std::array<size_t, N>& offsets,
+                                 const std::array<size_t, N>& ends) {
+    if (offsets[0] != 0) return false;
+    for (size_t i = 1; i < N; i++) {
+        if (offsets[i] != ends[i - 1]) return false;
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * Ordered list of fields making up one account layout.
+ */
+template <typename... Fs>
+struct FieldList {
+    static constexpr size_t count = sizeof...(Fs);
+    static constexpr size_t end = std::array<size_t, count>{Fs::end...}[count - 1];
+    static constexpr bool is_contiguous = detail::fields_contiguous<count>(
+        {Fs::offset...}, {Fs::end...});
+};
+
+// ============================================================================
+// Layout Tables
+// ============================================================================
+
+// Pool
+namespace pool {
+using disc          = Field<uint64_t, 0>;
+using authority     = Field<Pubkey, 8>;
+using mint0         = Field<Pubkey, 40>;
+using mint1         = Field<Pubkey, 72>;
+using vault0        = Field<Pubkey, 104>;
+using vault1        = Field<Pubkey, 136>;
+using lp_mint       = Field<Pubkey, 168>;
+using amp           = Field<uint64_t, 200>;
+using init_amp      = Field<uint64_t, 208>;
+using target_amp    = Field<uint64_t, 216>;
+using ramp_start    = Field<int64_t, 224>;
+using ramp_stop     = Field<int64_t, 232>;
+using fee_bps       = Field<uint64_t, 240>;
+using admin_fee_pct = Field<uint64_t, 248>;
+using bal0          = Field<uint64_t, 256>;
+using bal1          = Field<uint64_t, 264>;
+using lp_supply     = Field<uint64_t, 272>;
+using admin_fee0    = Field<uint64_t, 280>;
+using admin_fee1    = Field<uint64_t, 288>;
+using vol0          = Field<uint64_t, 296>;
+using vol1          = Field<uint64_t, 304>;
+using paused        = Field<uint8_t, 312>;
+using bump          = Field<uint8_t, 313>;
+using v0_bump       = Field<uint8_t, 314>;
+using v1_bump       = Field<uint8_t, 315>;
+using lp_bump       = Field<uint8_t, 316>;
+using _pad          = Field<std::array<uint8_t, 3>, 317>;
+using pending_auth  = Field<Pubkey, 320>;
+using auth_time     = Field<int64_t, 352>;
+using pending_amp   = Field<uint64_t, 360>;
+using amp_time      = Field<int64_t, 368>;
+using trade_count   = Field<uint64_t, 376>;
+using trade_sum     = Field<uint64_t, 384>;
+using max_price     = Field<uint32_t, 392>;
+using min_price     = Field<uint32_t, 396>;
+using hour_slot     = Field<uint32_t, 400>;
+using day_slot      = Field<uint32_t, 404>;
+using hour_idx      = Field<uint8_t, 408>;
+using day_idx       = Field<uint8_t, 409>;
+using _pad2         = Field<std::array<uint8_t, 6>, 410>;
+using bloom         = Field<std::array<uint8_t, BLOOM_SIZE>, 416>;
+using hours         = Field<std::array<Candle, OHLCV_24H>, 544>;
+using days          = Field<std::array<Candle, OHLCV_7D>, 832>;
+
+using fields = FieldList<
+    disc, authority, mint0, mint1, vault0, vault1,
+    lp_mint, amp, init_amp, target_amp, ramp_start, ramp_stop,
+    fee_bps, admin_fee_pct, bal0, bal1, lp_supply, admin_fee0,
+    admin_fee1, vol0, vol1, paused, bump, v0_bump,
+    v1_bump, lp_bump, _pad, pending_auth, auth_time, pending_amp,
+    amp_time, trade_count, trade_sum, max_price, min_price, hour_slot,
+    day_slot, hour_idx, day_idx, _pad2, bloom, hours,
+    days
+>;
+constexpr size_t SIZE = 916;
+}  // namespace pool
+
+// NPool
+namespace npool {
+using disc            = Field<uint64_t, 0>;
+using authority       = Field<Pubkey, 8>;
+using n_tokens        = Field<uint8_t, 40>;
+using paused          = Field<uint8_t, 41>;
+using bump            = Field<uint8_t, 42>;
+using _pad            = Field<std::array<uint8_t, 5>, 43>;
+using amp             = Field<uint64_t, 48>;
+using fee_bps         = Field<uint64_t, 56>;
+using admin_fee_pct   = Field<uint64_t, 64>;
+using lp_supply       = Field<uint64_t, 72>;
+using mints           = Field<std::array<Pubkey, MAX_TOKENS>, 80>;
+using vaults          = Field<std::array<Pubkey, MAX_TOKENS>, 336>;
+using lp_mint         = Field<Pubkey, 592>;
+using balances        = Field<std::array<uint64_t, MAX_TOKENS>, 624>;
+using admin_fees      = Field<std::array<uint64_t, MAX_TOKENS>, 688>;
+using total_volume    = Field<uint64_t, 752>;
+using trade_count     = Field<uint64_t, 760>;
+using last_trade_slot = Field<uint64_t, 768>;
+
+using fields = FieldList<
+    disc, authority, n_tokens, paused, bump, _pad,
+    amp, fee_bps, admin_fee_pct, lp_supply, mints, vaults,
+    lp_mint, balances, admin_fees, total_volume, trade_count, last_trade_slot
+>;
+constexpr size_t SIZE = 776;
+}  // namespace npool
+
+// Farm
+namespace farm {
+using disc         = Field<uint64_t, 0>;
+using pool         = Field<Pubkey, 8>;
+using reward_mint  = Field<Pubkey, 40>;
+using reward_rate  = Field<uint64_t, 72>;
+using start_time   = Field<int64_t, 80>;
+using end_time     = Field<int64_t, 88>;
+using total_staked = Field<uint64_t, 96>;
+using acc_reward   = Field<uint64_t, 104>;
+using last_update  = Field<int64_t, 112>;
+
+using fields = FieldList<
+    disc, pool, reward_mint, reward_rate, start_time, end_time,
+    total_staked, acc_reward, last_update
+>;
+constexpr size_t SIZE = 120;
+}  // namespace farm
+
+// UserFarm
+namespace user_farm {
+using disc        = Field<uint64_t, 0>;
+using owner       = Field<Pubkey, 8>;
+using farm        = Field<Pubkey, 40>;
+using staked      = Field<uint64_t, 72>;
+using reward_debt = Field<uint64_t, 80>;
+using lock_end    = Field<int64_t, 88>;
+
+using fields = FieldList<
+    disc, owner, farm, staked, reward_debt, lock_end
+>;
+constexpr size_t SIZE = 96;
+}  // namespace user_farm
+
+// Lottery
+namespace lottery {
+using disc           = Field<uint64_t, 0>;
+using pool           = Field<Pubkey, 8>;
+using authority      = Field<Pubkey, 40>;
+using lottery_vault  = Field<Pubkey, 72>;
+using ticket_price   = Field<uint64_t, 104>;
+using total_tickets  = Field<uint64_t, 112>;
+using prize_pool     = Field<uint64_t, 120>;
+using end_time       = Field<int64_t, 128>;
+using winning_ticket = Field<uint64_t, 136>;
+using drawn          = Field<uint8_t, 144>;
+using claimed        = Field<uint8_t, 145>;
+using _pad           = Field<std::array<uint8_t, 6>, 146>;
+
+using fields = FieldList<
+    disc, pool, authority, lottery_vault, ticket_price, total_tickets,
+    prize_pool, end_time, winning_ticket, drawn, claimed, _pad
+>;
+constexpr size_t SIZE = 152;
+}  // namespace lottery
+
+// LotteryEntry
+namespace lottery_entry {
+using disc         = Field<uint64_t, 0>;
+using owner        = Field<Pubkey, 8>;
+using lottery      = Field<Pubkey, 40>;
+using ticket_start = Field<uint64_t, 72>;
+using ticket_count = Field<uint64_t, 80>;
+
+using fields = FieldList<
+    disc, owner, lottery, ticket_start, ticket_count
+>;
+constexpr size_t SIZE = 88;
+}  // namespace lottery_entry
+
+// Registry
+namespace registry {
+using disc         = Field<uint64_t, 0>;
+using authority    = Field<Pubkey, 8>;
+using pending_auth = Field<Pubkey, 40>;
+using auth_time    = Field<int64_t, 72>;
+using count        = Field<uint32_t, 80>;
+using _pad         = Field<std::array<uint8_t, 4>, 84>;
+
+using fields = FieldList<
+    disc, authority, pending_auth, auth_time, count, _pad
+>;
+constexpr size_t SIZE = 88;
+}  // namespace registry
+
+// CLPool
+namespace clpool {
+using disc         = Field<uint64_t, 0>;
+using pool         = Field<Pubkey, 8>;
+using authority    = Field<Pubkey, 40>;
+using tick_lower   = Field<int16_t, 72>;
+using tick_upper   = Field<int16_t, 74>;
+using current_tick = Field<int16_t, 76>;
+using initialized  = Field<uint8_t, 78>;
+using _pad         = Field<uint8_t, 79>;
+using sqrt_price   = Field<uint64_t, 80>;
+using liquidity    = Field<uint64_t, 88>;
+using fee_growth_0 = Field<uint64_t, 96>;
+using fee_growth_1 = Field<uint64_t, 104>;
+using tick_bitmap  = Field<std::array<uint8_t, 128>, 112>;
+using reserved     = Field<std::array<uint8_t, 256>, 240>;
+
+using fields = FieldList<
+    disc, pool, authority, tick_lower, tick_upper, current_tick,
+    initialized, _pad, sqrt_price, liquidity, fee_growth_0, fee_growth_1,
+    tick_bitmap, reserved
+>;
+constexpr size_t SIZE = 496;
+}  // namespace clpool
+
+// ============================================================================
+// Verification Against Packed Structs
+// ============================================================================
+
+#define AEX402_CHECK_FIELD(S, NS, F)                                 \
+    static_assert(offsetof(S, F) == NS::F::offset &&                 \
+                  sizeof(S::F) == NS::F::size,                       \
+                  #S "::" #F " does not match its layout table")
+
+AEX402_CHECK_FIELD(Pool, pool, disc);
+AEX402_CHECK_FIELD(Pool, pool, authority);
+AEX402_CHECK_FIELD(Pool, pool, mint0);
+AEX402_CHECK_FIELD(Pool, pool, mint1);
+AEX402_CHECK_FIELD(Pool, pool, vault0);
+AEX402_CHECK_FIELD(Pool, pool, vault1);
+AEX402_CHECK_FIELD(Pool, pool, lp_mint);
+AEX402_CHECK_FIELD(Pool, pool, amp);
+AEX402_CHECK_FIELD(Pool, pool, init_amp);
+AEX402_CHECK_FIELD(Pool, pool, target_amp);
+AEX402_CHECK_FIELD(Pool, pool, ramp_start);
+AEX402_CHECK_FIELD(Pool, pool, ramp_stop);
+AEX402_CHECK_FIELD(Pool, pool, fee_bps);
+AEX402_CHECK_FIELD(Pool, pool, admin_fee_pct);
+AEX402_CHECK_FIELD(Pool, pool, bal0);
+AEX402_CHECK_FIELD(Pool, pool, bal1);
+AEX402_CHECK_FIELD(Pool, pool, lp_supply);
+AEX402_CHECK_FIELD(Pool, pool, admin_fee0);
+AEX402_CHECK_FIELD(Pool, pool, admin_fee1);
+AEX402_CHECK_FIELD(Pool, pool, vol0);
+AEX402_CHECK_FIELD(Pool, pool, vol1);
+AEX402_CHECK_FIELD(Pool, pool, paused);
+AEX402_CHECK_FIELD(Pool, pool, bump);
+AEX402_CHECK_FIELD(Pool, pool, v0_bump);
+AEX402_CHECK_FIELD(Pool, pool, v1_bump);
+AEX402_CHECK_FIELD(Pool, pool, lp_bump);
+AEX402_CHECK_FIELD(Pool, pool, _pad);
+AEX402_CHECK_FIELD(Pool, pool, pending_auth);
+AEX402_CHECK_FIELD(Pool, pool, auth_time);
+AEX402_CHECK_FIELD(Pool, pool, pending_amp);
+AEX402_CHECK_FIELD(Pool, pool, amp_time);
+AEX402_CHECK_FIELD(Pool, pool, trade_count);
+AEX402_CHECK_FIELD(Pool, pool, trade_sum);
+AEX402_CHECK_FIELD(Pool, pool, max_price);
+AEX402_CHECK_FIELD(Pool, pool, min_price);
+AEX402_CHECK_FIELD(Pool, pool, hour_slot);
+AEX402_CHECK_FIELD(Pool, pool, day_slot);
+AEX402_CHECK_FIELD(Pool, pool, hour_idx);
+AEX402_CHECK_FIELD(Pool, pool, day_idx);
+AEX402_CHECK_FIELD(Pool, pool, _pad2);
+AEX402_CHECK_FIELD(Pool, pool, bloom);
+AEX402_CHECK_FIELD(Pool, pool, hours);
+AEX402_CHECK_FIELD(Pool, pool, days);
+static_assert(pool::fields::is_contiguous && pool::fields::end == sizeof(Pool),
+              "Pool layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(NPool, npool, disc);
+AEX402_CHECK_FIELD(NPool, npool, authority);
+AEX402_CHECK_FIELD(NPool, npool, n_tokens);
+AEX402_CHECK_FIELD(NPool, npool, paused);
+AEX402_CHECK_FIELD(NPool, npool, bump);
+AEX402_CHECK_FIELD(NPool, npool, _pad);
+AEX402_CHECK_FIELD(NPool, npool, amp);
+AEX402_CHECK_FIELD(NPool, npool, fee_bps);
+AEX402_CHECK_FIELD(NPool, npool, admin_fee_pct);
+AEX402_CHECK_FIELD(NPool, npool, lp_supply);
+AEX402_CHECK_FIELD(NPool, npool, mints);
+AEX402_CHECK_FIELD(NPool, npool, vaults);
+AEX402_CHECK_FIELD(NPool, npool, lp_mint);
+AEX402_CHECK_FIELD(NPool, npool, balances);
+AEX402_CHECK_FIELD(NPool, npool, admin_fees);
+AEX402_CHECK_FIELD(NPool, npool, total_volume);
+AEX402_CHECK_FIELD(NPool, npool, trade_count);
+AEX402_CHECK_FIELD(NPool, npool, last_trade_slot);
+static_assert(npool::fields::is_contiguous && npool::fields::end == sizeof(NPool),
+              "NPool layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(Farm, farm, disc);
+AEX402_CHECK_FIELD(Farm, farm, pool);
+AEX402_CHECK_FIELD(Farm, farm, reward_mint);
+AEX402_CHECK_FIELD(Farm, farm, reward_rate);
+AEX402_CHECK_FIELD(Farm, farm, start_time);
+AEX402_CHECK_FIELD(Farm, farm, end_time);
+AEX402_CHECK_FIELD(Farm, farm, total_staked);
+AEX402_CHECK_FIELD(Farm, farm, acc_reward);
+AEX402_CHECK_FIELD(Farm, farm, last_update);
+static_assert(farm::fields::is_contiguous && farm::fields::end == sizeof(Farm),
+              "Farm layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(UserFarm, user_farm, disc);
+AEX402_CHECK_FIELD(UserFarm, user_farm, owner);
+AEX402_CHECK_FIELD(UserFarm, user_farm, farm);
+AEX402_CHECK_FIELD(UserFarm, user_farm, staked);
+AEX402_CHECK_FIELD(UserFarm, user_farm, reward_debt);
+AEX402_CHECK_FIELD(UserFarm, user_farm, lock_end);
+static_assert(user_farm::fields::is_contiguous && user_farm::fields::end == sizeof(UserFarm),
+              "UserFarm layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(Lottery, lottery, disc);
+AEX402_CHECK_FIELD(Lottery, lottery, pool);
+AEX402_CHECK_FIELD(Lottery, lottery, authority);
+AEX402_CHECK_FIELD(Lottery, lottery, lottery_vault);
+AEX402_CHECK_FIELD(Lottery, lottery, ticket_price);
+AEX402_CHECK_FIELD(Lottery, lottery, total_tickets);
+AEX402_CHECK_FIELD(Lottery, lottery, prize_pool);
+AEX402_CHECK_FIELD(Lottery, lottery, end_time);
+AEX402_CHECK_FIELD(Lottery, lottery, winning_ticket);
+AEX402_CHECK_FIELD(Lottery, lottery, drawn);
+AEX402_CHECK_FIELD(Lottery, lottery, claimed);
+AEX402_CHECK_FIELD(Lottery, lottery, _pad);
+static_assert(lottery::fields::is_contiguous && lottery::fields::end == sizeof(Lottery),
+              "Lottery layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(LotteryEntry, lottery_entry, disc);
+AEX402_CHECK_FIELD(LotteryEntry, lottery_entry, owner);
+AEX402_CHECK_FIELD(LotteryEntry, lottery_entry, lottery);
+AEX402_CHECK_FIELD(LotteryEntry, lottery_entry, ticket_start);
+AEX402_CHECK_FIELD(LotteryEntry, lottery_entry, ticket_count);
+static_assert(lottery_entry::fields::is_contiguous && lottery_entry::fields::end == sizeof(LotteryEntry),
+              "LotteryEntry layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(Registry, registry, disc);
+AEX402_CHECK_FIELD(Registry, registry, authority);
+AEX402_CHECK_FIELD(Registry, registry, pending_auth);
+AEX402_CHECK_FIELD(Registry, registry, auth_time);
+AEX402_CHECK_FIELD(Registry, registry, count);
+AEX402_CHECK_FIELD(Registry, registry, _pad);
+static_assert(registry::fields::is_contiguous && registry::fields::end == sizeof(Registry),
+              "Registry layout table must cover the struct exactly");
+
+AEX402_CHECK_FIELD(CLPool, clpool, disc);
+AEX402_CHECK_FIELD(CLPool, clpool, pool);
+AEX402_CHECK_FIELD(CLPool, clpool, authority);
+AEX402_CHECK_FIELD(CLPool, clpool, tick_lower);
+AEX402_CHECK_FIELD(CLPool, clpool, tick_upper);
+AEX402_CHECK_FIELD(CLPool, clpool, current_tick);
+AEX402_CHECK_FIELD(CLPool, clpool, initialized);
+AEX402_CHECK_FIELD(CLPool, clpool, _pad);
+AEX402_CHECK_FIELD(CLPool, clpool, sqrt_price);
+AEX402_CHECK_FIELD(CLPool, clpool, liquidity);
+AEX402_CHECK_FIELD(CLPool, clpool, fee_growth_0);
+AEX402_CHECK_FIELD(CLPool, clpool, fee_growth_1);
+AEX402_CHECK_FIELD(CLPool, clpool, tick_bitmap);
+AEX402_CHECK_FIELD(CLPool, clpool, reserved);
+static_assert(clpool::fields::is_contiguous && clpool::fields::end == sizeof(CLPool),
+              "CLPool layout table must cover the struct exactly");
+
+#undef AEX402_CHECK_FIELD
+
+// ============================================================================
+// Account Sizes
+// ============================================================================
+
+static_assert(pool::SIZE == 916 && sizeof(Pool) == pool::SIZE,
+              "Pool data must be exactly 916 bytes");
+static_assert(npool::SIZE == 776 && sizeof(NPool) == npool::SIZE,
+              "NPool data must be exactly 776 bytes");
+static_assert(farm::SIZE == 120 && sizeof(Farm) == farm::SIZE,
+              "Farm data must be exactly 120 bytes");
+static_assert(user_farm::SIZE == 96 && sizeof(UserFarm) == user_farm::SIZE,
+              "UserFarm data must be exactly 96 bytes");
+static_assert(lottery::SIZE == 152 && sizeof(Lottery) == lottery::SIZE,
+              "Lottery data must be exactly 152 bytes");
+static_assert(lottery_entry::SIZE == 88 && sizeof(LotteryEntry) == lottery_entry::SIZE,
+              "LotteryEntry data must be exactly 88 bytes");
+static_assert(registry::SIZE == 88 && sizeof(Registry) == registry::SIZE,
+              "Registry data must be exactly 88 bytes");
+static_assert(clpool::SIZE == 496 && sizeof(CLPool) == clpool::SIZE,
+              "CLPool data must be exactly 496 bytes");
+
+static_assert(pool::SIZE <= POOL_SIZE, "Pool must fit in a 1024-byte account");
+static_assert(npool::SIZE <= NPOOL_SIZE, "NPool must fit in a 2048-byte account");
+
+}  // namespace layout
+}  // namespace aex402
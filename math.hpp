@@ -14,6 +14,7 @@
 #include <optional>
 #include <cmath>
 #include "constants.hpp"
+#include "trace.hpp"
 
 namespace aex402 {
 namespace math {
@@ -23,6 +24,7 @@ namespace math {
 // ============================================================================
 
 constexpr uint64_t FEE_DENOMINATOR = 10000;  // For basis points
+constexpr uint64_t PCT_DENOMINATOR = 100;    // For percentages (admin_fee_pct)
 constexpr uint64_t PRECISION = 1000000000000ULL;  // 1e12 for reward calculations
 
 // ============================================================================
@@ -44,6 +46,25 @@ inline uint64_t div128(__uint128_t n, uint64_t d) {
     return static_cast<uint64_t>(n / d);
 }
 
+/**
+ * floor(a * b / d) with a 128-bit intermediate, saturating at UINT64_MAX.
+ * Returns 0 when d is 0.
+ */
+inline uint64_t mul_div(uint64_t a, uint64_t b, uint64_t d) {
+    if (d == 0) return 0;
+    __uint128_t q = mul128(a, b) / d;
+    return q > UINT64_MAX ? UINT64_MAX : static_cast<uint64_t>(q);
+}
+
+/**
+ * Fee charged on an amount: floor(amount * fee_bps / 10000), computed
+ * without 64-bit overflow. Fees of 100% or more take the whole amount.
+ */
+inline uint64_t calc_fee(uint64_t amount, uint64_t fee_bps) {
+    if (fee_bps >= FEE_DENOMINATOR) return amount;
+    return mul_div(amount, fee_bps, FEE_DENOMINATOR);
+}
+
 /**
  * Integer square root using Newton's method.
  */
@@ -220,11 +241,13 @@ inline std::optional<uint64_t> simulate_swap(
     uint64_t bal_in, uint64_t bal_out,
     uint64_t amount_in, uint64_t amp, uint64_t fee_bps
 ) {
+    AEX402_TRACE_SCOPE("quote.simulate_swap");
     // Calculate current invariant
     auto d = calc_d(bal_in, bal_out, amp);
     if (!d) return std::nullopt;
 
     // Calculate new output balance
+    if (amount_in > UINT64_MAX - bal_in) return std::nullopt;
     uint64_t new_bal_in = bal_in + amount_in;
     auto new_bal_out = calc_y(new_bal_in, *d, amp);
     if (!new_bal_out) return std::nullopt;
@@ -234,8 +257,7 @@ inline std::optional<uint64_t> simulate_swap(
     uint64_t amount_out = bal_out - *new_bal_out;
 
     // Apply fee
-    uint64_t fee = amount_out * fee_bps / FEE_DENOMINATOR;
-    amount_out -= fee;
+    amount_out -= calc_fee(amount_out, fee_bps);
 
     return amount_out;
 }
@@ -367,13 +389,16 @@ inline std::optional<double> calc_price_impact(
 
 /**
  * Calculate minimum output with slippage tolerance.
+ * Uses a 128-bit intermediate, so any expected_output is exact; a
+ * tolerance of 100% or more yields 0.
  *
  * @param expected_output Expected output amount
  * @param slippage_bps Slippage tolerance in basis points
  * @return Minimum acceptable output
  */
 inline uint64_t calc_min_output(uint64_t expected_output, uint64_t slippage_bps) {
-    return expected_output * (FEE_DENOMINATOR - slippage_bps) / FEE_DENOMINATOR;
+    if (slippage_bps >= FEE_DENOMINATOR) return 0;
+    return mul_div(expected_output, FEE_DENOMINATOR - slippage_bps, FEE_DENOMINATOR);
 }
 
 /**
@@ -471,22 +496,42 @@ inline std::optional<uint64_t> calc_d_n(
  * @param amp Amplification coefficient
  * @return New balance of output token, or nullopt if failed
  */
+inline std::optional<uint64_t> calc_y_n_with_d(
+    const uint64_t* balances, uint8_t n_tokens,
+    uint8_t from_idx, uint8_t to_idx,
+    uint64_t amount_in, uint64_t amp, uint64_t d
+);
+
 inline std::optional<uint64_t> calc_y_n(
     const uint64_t* balances, uint8_t n_tokens,
     uint8_t from_idx, uint8_t to_idx,
     uint64_t amount_in, uint64_t amp
+) {
+    // Calculate D with original balances
+    auto d = calc_d_n(balances, n_tokens, amp);
+    if (!d) return std::nullopt;
+    return calc_y_n_with_d(balances, n_tokens, from_idx, to_idx, amount_in, amp, *d);
+}
+
+/**
+ * calc_y_n against an invariant D the caller already has, e.g. when
+ * evaluating several swaps along the same curve.
+ *
+ * @param d Pool invariant D for `balances`
+ * @return New balance of output token, or nullopt if failed
+ */
+inline std::optional<uint64_t> calc_y_n_with_d(
+    const uint64_t* balances, uint8_t n_tokens,
+    uint8_t from_idx, uint8_t to_idx,
+    uint64_t amount_in, uint64_t amp, uint64_t d
 ) {
     // Create new balances array with input added
-    uint64_t new_balances[MAX_TOKENS];
+    uint64_t new_balances[MAX_TOKENS] = {};
     for (uint8_t i = 0; i < n_tokens; i++) {
         new_balances[i] = balances[i];
     }
     new_balances[from_idx] += amount_in;
 
-    // Calculate D with original balances
-    auto d = calc_d_n(balances, n_tokens, amp);
-    if (!d) return std::nullopt;
-
     // Calculate n^n
     __uint128_t nn = 1;
     for (uint8_t i = 0; i < n_tokens; i++) {
@@ -496,7 +541,7 @@ inline std::optional<uint64_t> calc_y_n(
 
     // Calculate S' and P' (excluding output token)
     uint64_t s_prime = 0;
-    __uint128_t c = *d;
+    __uint128_t c = d;
 
     for (uint8_t i = 0; i < n_tokens; i++) {
         if (i == to_idx) continue;
@@ -505,20 +550,20 @@ inline std::optional<uint64_t> calc_y_n(
         s_prime += x;
 
         if (x == 0) return std::nullopt;
-        c = c * (*d) / (n_tokens * x);
+        c = c * d / (n_tokens * x);
     }
 
-    c = c * (*d) / (ann * n_tokens);
-    uint64_t b = s_prime + (*d) / ann;
+    c = c * d / (ann * n_tokens);
+    uint64_t b = s_prime + d / ann;
 
     // Newton iteration to find y
-    uint64_t y = *d;
+    uint64_t y = d;
 
     for (int iter = 0; iter < NEWTON_ITERATIONS; iter++) {
         uint64_t y_prev = y;
 
-        __uint128_t num = mul128(y, y) + static_cast<uint64_t>(c);
-        uint64_t denom = 2 * y + b - (*d);
+        __uint128_t num = mul128(y, y) + c;
+        uint64_t denom = 2 * y + b - d;
 
         if (denom == 0) return std::nullopt;
 
@@ -542,6 +587,9 @@ inline std::optional<uint64_t> simulate_swap_n(
     uint8_t from_idx, uint8_t to_idx,
     uint64_t amount_in, uint64_t amp, uint64_t fee_bps
 ) {
+    AEX402_TRACE_SCOPE("quote.simulate_swap_n");
+    if (n_tokens > MAX_TOKENS || from_idx >= n_tokens || to_idx >= n_tokens) return std::nullopt;
+    if (amount_in > UINT64_MAX - balances[from_idx]) return std::nullopt;
     auto new_y = calc_y_n(balances, n_tokens, from_idx, to_idx, amount_in, amp);
     if (!new_y) return std::nullopt;
 
@@ -549,8 +597,7 @@ inline std::optional<uint64_t> simulate_swap_n(
     uint64_t amount_out = balances[to_idx] - *new_y;
 
     // Apply fee
-    uint64_t fee = amount_out * fee_bps / FEE_DENOMINATOR;
-    amount_out -= fee;
+    amount_out -= calc_fee(amount_out, fee_bps);
 
     return amount_out;
 }
@@ -0,0 +1,452 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Sandwich Exposure Estimator
+ *
+ * For a swap we are about to send, estimates how much an attacker could
+ * extract by sandwiching it (front-run in our direction, let our swap
+ * execute at the worse price, back-run in the opposite direction), given
+ * the min_out we sign, and the tightest min_out that leaves no profitable
+ * sandwich. The on-chain MevProtection check only guards the program's
+ * own heuristics; min_out is the bound an attacker actually has to respect.
+ *
+ * Model:
+ * - Profit is measured in the input token: back-run output minus the
+ *   front-run amount minus a fixed attacker cost (tips, priority fees).
+ * - Searches run on the pool's current invariant: D is computed once, each
+ *   leg is a single calc_y, and swap fees are treated as leaving the pool.
+ *   On that curve the marginal rate between tokens i and j is closed-form,
+ *     |dx_j/dx_i| = (Ann + K/x_i) / (Ann + K/x_j),  K = D^(n+1) / (n^n prod x),
+ *   so the derivatives of attacker profit and of our output with respect
+ *   to the front-run size come out of the same three legs.
+ * - With f = 1 - fee, the profit slope at a zero front-run is
+ *   f^2 * p0 / p1 - 1, where p0 and p1 are the rates before and after our
+ *   swap. Profit is not always concave: small front-runs can lose to fees
+ *   while large ones push the pool into the curved region and pay. So
+ *   profit is sampled on a geometric grid (cap, cap/8, ... down to our own
+ *   size) and the peak, the first break-even front-run and the largest
+ *   front-run our min_out tolerates are each refined by a safeguarded
+ *   Newton/secant search inside the bracketing grid cell.
+ * - Any min_out above our output at break-even makes every sandwich
+ *   unprofitable. A break-even at zero (the slope above is positive and
+ *   the attacker has no fixed cost) means only min_out == victim_out
+ *   protects the swap.
+ * - Reported amounts are re-simulated leg by leg with simulate_swap /
+ *   simulate_swap_n (fees retained in the balances), and the front-run
+ *   bounds are tightened against that exact path.
+ *
+ * Cost is roughly 20 model samples (three calc_y each) plus a handful of
+ * exact swaps per order.
+ *
+ * Usage:
+ *   auto est = mev::estimate_sandwich(pool, 0, amount_in, min_out, now);
+ *   if (est && est->profitable && est->safe_min_out <= est->victim_out) {
+ *       min_out = std::max(min_out, est->safe_min_out);
+ *   }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include "types.hpp"
+#include "constants.hpp"
+#include "math.hpp"
+
+namespace aex402 {
+namespace mev {
+
+// ============================================================================
+// Types
+// ============================================================================
+
+struct SandwichConfig {
+    uint64_t max_front_run = 0;     // Largest front-run considered (0 = input-side pool balance)
+    uint64_t attacker_cost = 0;     // Fixed cost per attack, in input-token units
+};
+
+struct SandwichEstimate {
+    uint64_t victim_out = 0;            // Our output with no attack
+    uint64_t min_out = 0;               // min_out the estimate was made for
+    uint64_t max_front_run = 0;         // Largest front-run that still lets our swap pass min_out
+    uint64_t best_front_run = 0;        // Front-run maximising attacker profit under min_out
+    uint64_t max_profit = 0;            // Attacker profit at best_front_run (0 if none)
+    uint64_t victim_out_attacked = 0;   // Our output when front-run by best_front_run
+    uint64_t safe_min_out = 0;          // Tightest min_out leaving no profitable sandwich (0 = any)
+    bool     profitable = false;        // A profitable sandwich exists under min_out
+};
+
+namespace detail {
+
+// Search precision, as a right shift of the bracket's upper end
+constexpr uint32_t SEARCH_SHIFT = 12;
+constexpr uint32_t BOUND_SHIFT = 16;
+
+// Profit grid: cap, cap/8, ... down to amount_in >> GRID_FLOOR_SHIFT
+constexpr size_t GRID_POINTS = 16;
+constexpr uint32_t GRID_STEP_SHIFT = 3;
+constexpr uint32_t GRID_FLOOR_SHIFT = 3;
+constexpr int MAX_SEARCH_ITERATIONS = 64;
+constexpr double INFEASIBLE = std::numeric_limits<double>::infinity();
+
+/**
+ * Pool balances plus the parameters needed to run legs against them.
+ * `exact` selects per-leg simulate_swap (D recomputed each leg) instead of
+ * a single calc_y against the fixed invariant `d`.
+ */
+struct Curve {
+    uint64_t bal[MAX_TOKENS] = {};
+    uint8_t  n = 0;
+    uint64_t amp = 0;
+    uint64_t fee_bps = 0;
+    uint64_t d = 0;
+    bool     exact = false;
+
+    std::optional<uint64_t> swap(uint8_t from, uint8_t to, uint64_t amount_in) {
+        if (amount_in == 0) return 0;
+        if (amount_in > UINT64_MAX - bal[from]) return std::nullopt;
+
+        if (exact) {
+            auto out = n == 2
+                ? math::simulate_swap(bal[from], bal[to], amount_in, amp, fee_bps)
+                : math::simulate_swap_n(bal, n, from, to, amount_in, amp, fee_bps);
+            if (!out || *out >= bal[to]) return std::nullopt;
+            bal[from] += amount_in;
+            bal[to] -= *out;
+            return out;
+        }
+
+        auto new_y = n == 2
+            ? math::calc_y(bal[from] + amount_in, d, amp)
+            : math::calc_y_n_with_d(bal, n, from, to, amount_in, amp, d);
+        if (!new_y) return std::nullopt;
+        bal[from] += amount_in;
+        if (*new_y >= bal[to]) return 0;
+        uint64_t gross = bal[to] - *new_y;
+        bal[to] = *new_y;
+        return gross - math::calc_fee(gross, fee_bps);
+    }
+
+    /** Marginal rate |d bal[to] / d bal[from]| on the invariant `d`. */
+    double rate(uint8_t from, uint8_t to) const {
+        const double dd = static_cast<double>(d);
+        double ann = static_cast<double>(amp);
+        double k = dd;
+        for (uint8_t i = 0; i < n; i++) {
+            ann *= n;
+            k *= dd / (static_cast<double>(n) * static_cast<double>(bal[i]));
+        }
+        return (ann + k / static_cast<double>(bal[from])) / (ann + k / static_cast<double>(bal[to]));
+    }
+};
+
+/** Sandwich outcome for one front-run size, with slopes from the model. */
+struct Sample {
+    bool     ok = false;
+    __int128_t profit = 0;        // Attacker profit (input-token units)
+    double   slope = 0;         // d profit / d front-run
+    uint64_t victim = 0;        // Our output
+    double   victim_slope = 0;  // d victim / d front-run
+};
+
+struct Leg {
+    const Curve* curve;
+    uint8_t from;
+    uint8_t to;
+    uint64_t amount_in;
+    uint64_t cost;
+
+    /** Our output after a front-run of `a`, or nullopt if either leg fails. */
+    std::optional<uint64_t> victim_out(uint64_t a) const {
+        Curve c = *curve;
+        if (!c.swap(from, to, a)) return std::nullopt;
+        return c.swap(from, to, amount_in);
+    }
+
+    /** Front-run `a`, our swap, back-run of the front-run's output. */
+    Sample sample(uint64_t a) const {
+        Sample s;
+        Curve c = *curve;
+        auto front = c.swap(from, to, a);
+        if (!front) return s;
+        const double p1 = curve->exact ? 0.0 : c.rate(from, to);
+        auto ours = c.swap(from, to, amount_in);
+        if (!ours) return s;
+        const double p2 = curve->exact ? 0.0 : c.rate(from, to);
+        auto back = c.swap(to, from, *front);
+        if (!back) return s;
+
+        s.ok = true;
+        s.victim = *ours;
+        s.profit = static_cast<__int128_t>(*back) - a - cost;
+        if (!curve->exact) {
+            const double p3 = c.rate(from, to);
+            const double f = 1.0 - static_cast<double>(c.fee_bps) / static_cast<double>(math::FEE_DENOMINATOR);
+            s.slope = f * (1.0 + (f * p1 - p2) / p3) - 1.0;
+            s.victim_slope = f * (p2 - p1);
+        }
+        return s;
+    }
+};
+
+/**
+ * Largest a in [lo, hi] with g(a) <= 0, for g increasing with
+ * g(lo) <= 0 < g(hi), starting from x0 in [lo, hi). `eval(a)` returns
+ * {g, g'}; g' <= 0 means unknown, in which case the secant through the
+ * last two points is used. Steps that leave the bracket fall back to
+ * bisection. Stops once the bracket is within hi >> shift, or a Newton
+ * step within x >> shift of the current point x.
+ */
+template<typename Eval>
+inline uint64_t solve_increasing(uint64_t lo, uint64_t hi, uint64_t x0, uint32_t shift, Eval eval) {
+    uint64_t x = x0;
+    auto [gx, dgx] = eval(x0);
+    if (x0 != lo) {
+        if (gx <= 0) lo = x0; else hi = x0;
+    }
+    bool have_prev = false;
+    uint64_t x_prev = 0;
+    double g_prev = 0;
+
+    for (int iter = 0; iter < MAX_SEARCH_ITERATIONS && hi - lo > 1; iter++) {
+        const uint64_t tol = (hi >> shift) > 1 ? (hi >> shift) : 1;
+        if (hi - lo <= tol) break;
+
+        double slope = dgx;
+        if (!(slope > 0) && have_prev && x != x_prev && std::isfinite(gx) && std::isfinite(g_prev)) {
+            slope = (gx - g_prev) / (static_cast<double>(x) - static_cast<double>(x_prev));
+        }
+
+        uint64_t next = lo + (hi - lo) / 2;
+        if (slope > 0 && std::isfinite(gx)) {
+            const double t = static_cast<double>(x) - gx / slope;
+            const double step_tol = (x >> shift) > 1 ? static_cast<double>(x >> shift) : 1.0;
+            if (std::fabs(t - static_cast<double>(x)) <= step_tol) {
+                // Converged: confirm the point just below the root
+                const double below = t - step_tol;
+                const uint64_t probe = below > static_cast<double>(lo) ? static_cast<uint64_t>(below) : lo;
+                if (probe == lo || eval(probe).first <= 0) return probe;
+                hi = probe;
+                continue;
+            }
+            if (t > static_cast<double>(lo) && t < static_cast<double>(hi)) next = static_cast<uint64_t>(t);
+        }
+        if (next <= lo || next >= hi) next = lo + (hi - lo) / 2;
+
+        have_prev = true;
+        x_prev = x;
+        g_prev = gx;
+        x = next;
+        std::tie(gx, dgx) = eval(x);
+        if (gx <= 0) lo = x; else hi = x;
+    }
+    return lo;
+}
+
+inline uint64_t clamp_profit(__int128_t p) {
+    if (p <= 0) return 0;
+    return p > static_cast<__int128_t>(UINT64_MAX) ? UINT64_MAX : static_cast<uint64_t>(p);
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Estimator
+// ============================================================================
+
+/**
+ * Estimate sandwich exposure of swapping `amount_in` of token `from` for
+ * token `to` on a pool with the given balances.
+ *
+ * @param balances Pool balances (n_tokens entries; Pool passes {bal0, bal1})
+ * @param min_out Minimum output our instruction will carry
+ * @param amp Effective amplification at execution time
+ * @return Estimate, or nullopt if the parameters are invalid or our own
+ *         swap cannot be simulated
+ */
+inline std::optional<SandwichEstimate> estimate_sandwich(
+    const uint64_t* balances, uint8_t n_tokens,
+    uint8_t from, uint8_t to,
+    uint64_t amount_in, uint64_t min_out,
+    uint64_t amp, uint64_t fee_bps,
+    const SandwichConfig& cfg = {}
+) {
+    if (n_tokens < 2 || n_tokens > MAX_TOKENS || from >= n_tokens || to >= n_tokens || from == to) {
+        return std::nullopt;
+    }
+
+    detail::Curve exact;
+    exact.n = n_tokens;
+    exact.amp = amp;
+    exact.fee_bps = fee_bps;
+    exact.exact = true;
+    for (uint8_t i = 0; i < n_tokens; i++) exact.bal[i] = balances[i];
+
+    detail::Curve model = exact;
+    model.exact = false;
+    auto d = n_tokens == 2 ? math::calc_d(balances[from], balances[to], amp)
+                           : math::calc_d_n(balances, n_tokens, amp);
+    if (!d) return std::nullopt;
+    model.d = *d;
+
+    const detail::Leg fast{&model, from, to, amount_in, cfg.attacker_cost};
+    const detail::Leg real{&exact, from, to, amount_in, cfg.attacker_cost};
+
+    SandwichEstimate est;
+    est.min_out = min_out;
+    auto base = real.victim_out(0);
+    if (!base) return std::nullopt;
+    est.victim_out = *base;
+
+    const uint64_t cap = cfg.max_front_run ? cfg.max_front_run : balances[from];
+    auto passes = [&real, min_out](uint64_t a) {
+        auto v = real.victim_out(a);
+        return v && *v >= min_out;
+    };
+
+    // Profit profile on a geometric grid: a concave profile is bracketed
+    // around its peak, and one that only turns profitable once a large
+    // front-run pushes the pool into the curved region is still seen.
+    uint64_t grid[detail::GRID_POINTS];
+    detail::Sample at[detail::GRID_POINTS];
+    size_t points = 0;
+    {
+        const uint64_t smallest = (amount_in < cap ? amount_in : cap) >> detail::GRID_FLOOR_SHIFT;
+        uint64_t rev[detail::GRID_POINTS];
+        size_t m = 0;
+        for (uint64_t a = cap; a > 0 && m < detail::GRID_POINTS - 1; a >>= detail::GRID_STEP_SHIFT) {
+            rev[m++] = a;
+            if (a <= smallest) break;
+        }
+        grid[points] = 0;
+        at[points++] = fast.sample(0);
+        while (m > 0) {
+            grid[points] = rev[--m];
+            at[points] = fast.sample(grid[points]);
+            points++;
+        }
+    }
+
+    size_t top = 0;
+    for (size_t i = 1; i < points; i++) {
+        if (at[i].ok && at[i].profit > at[top].profit) top = i;
+    }
+
+    // Refine the peak between the top point's neighbours
+    auto neg_slope = [&fast](uint64_t a) {
+        detail::Sample s = fast.sample(a);
+        return std::make_pair(s.ok ? -s.slope : detail::INFEASIBLE, 0.0);
+    };
+    uint64_t peak = grid[top];
+    __int128_t peak_profit = at[top].profit;
+    if (at[top].ok && at[top].slope > 0 && top + 1 < points) {
+        uint64_t a = detail::solve_increasing(grid[top], grid[top + 1], grid[top], detail::SEARCH_SHIFT, neg_slope);
+        detail::Sample s = fast.sample(a);
+        if (s.ok && s.profit > peak_profit) { peak = a; peak_profit = s.profit; }
+    } else if (at[top].ok && at[top].slope < 0 && top > 0 && at[top - 1].ok && at[top - 1].slope > 0) {
+        uint64_t a = detail::solve_increasing(grid[top - 1], grid[top], grid[top - 1], detail::SEARCH_SHIFT, neg_slope);
+        detail::Sample s = fast.sample(a);
+        if (s.ok && s.profit > peak_profit) { peak = a; peak_profit = s.profit; }
+    }
+
+    if (peak > 0 && (peak_profit > 0 || real.sample(peak).profit > 0)) {
+        // First break-even front-run: profit <= 0 on [0, lo]. With no
+        // attacker cost and a positive slope at zero that is zero itself.
+        uint64_t lo = 0;
+        if (cfg.attacker_cost > 0 || !(at[0].slope > 0)) {
+            size_t j = 1;
+            while (j < points && !(at[j].ok && at[j].profit > 0)) j++;
+            const uint64_t hi = j < points ? grid[j] : peak;
+            const uint64_t start = j < points ? grid[j - 1] : 0;
+            lo = detail::solve_increasing(start, hi, start, detail::SEARCH_SHIFT, [&fast](uint64_t a) {
+                detail::Sample s = fast.sample(a);
+                return s.ok ? std::make_pair(static_cast<double>(s.profit), s.slope)
+                            : std::make_pair(detail::INFEASIBLE, 0.0);
+            });
+        }
+        for (int i = 0; i < detail::MAX_SEARCH_ITERATIONS && lo > 0 && real.sample(lo).profit > 0; i++) lo /= 2;
+
+        uint64_t at_lo = est.victim_out;
+        if (lo > 0) {
+            auto v = real.victim_out(lo);
+            at_lo = v ? *v : 0;
+        }
+        est.safe_min_out = at_lo < est.victim_out ? at_lo + 1 : est.victim_out;
+    }
+
+    // Largest front-run our min_out tolerates: model root, then Newton on
+    // the exact path from there with the model's slope
+    if (min_out > est.victim_out) return est;
+    uint64_t a_max = cap;
+    if (!passes(cap)) {
+        const uint64_t guess = detail::solve_increasing(0, cap, 0, detail::SEARCH_SHIFT,
+            [&fast, min_out](uint64_t a) {
+                detail::Sample s = fast.sample(a);
+                return s.ok ? std::make_pair(static_cast<double>(min_out) - static_cast<double>(s.victim),
+                                             -s.victim_slope)
+                            : std::make_pair(detail::INFEASIBLE, 0.0);
+            });
+        const double slope = -fast.sample(guess).victim_slope;
+        a_max = detail::solve_increasing(0, cap, guess, detail::BOUND_SHIFT,
+            [&real, min_out, slope](uint64_t a) {
+                auto v = real.victim_out(a);
+                return std::make_pair(v ? static_cast<double>(min_out) - static_cast<double>(*v)
+                                        : detail::INFEASIBLE, slope);
+            });
+    }
+    est.max_front_run = a_max;
+
+    // Best attack under that bound: the peak if the bound allows it,
+    // otherwise the bound itself or a better grid point below it
+    uint64_t best = peak;
+    if (peak > a_max) {
+        best = a_max;
+        __int128_t best_profit = fast.sample(a_max).profit;
+        for (size_t i = 1; i < points && grid[i] <= a_max; i++) {
+            if (at[i].ok && at[i].profit > best_profit) { best = grid[i]; best_profit = at[i].profit; }
+        }
+    }
+    const detail::Sample hit = real.sample(best);
+    est.victim_out_attacked = est.victim_out;
+    if (best > 0 && hit.ok && hit.profit > 0) {
+        est.best_front_run = best;
+        est.max_profit = detail::clamp_profit(hit.profit);
+        est.victim_out_attacked = hit.victim;
+        est.profitable = true;
+    }
+    return est;
+}
+
+/**
+ * Sandwich exposure of a swap on a two-token Pool.
+ *
+ * @param from Input token (0 or 1)
+ * @param now Expected execution time, for amps that are mid-ramp
+ */
+inline std::optional<SandwichEstimate> estimate_sandwich(
+    const Pool& pool, uint8_t from,
+    uint64_t amount_in, uint64_t min_out, int64_t now,
+    const SandwichConfig& cfg = {}
+) {
+    if (pool.is_paused() || from > 1) return std::nullopt;
+    const uint64_t bal[2] = {from == 0 ? pool.bal0 : pool.bal1, from == 0 ? pool.bal1 : pool.bal0};
+    return estimate_sandwich(bal, 2, 0, 1, amount_in, min_out, pool.get_amp(now), pool.fee_bps, cfg);
+}
+
+/**
+ * Sandwich exposure of a swap on an N-token pool.
+ */
+inline std::optional<SandwichEstimate> estimate_sandwich(
+    const NPool& pool, uint8_t from, uint8_t to,
+    uint64_t amount_in, uint64_t min_out,
+    const SandwichConfig& cfg = {}
+) {
+    if (pool.is_paused()) return std::nullopt;
+    return estimate_sandwich(pool.balances, pool.n_tokens, from, to, amount_in, min_out,
+                             pool.amp, pool.fee_bps, cfg);
+}
+
+}  // namespace mev
+}  // namespace aex402
@@ -0,0 +1,814 @@
+/**
+ * AeX402 Mock RPC Server
+ *
+ * Local stand-in for a Solana RPC node serving AeX402 accounts, for
+ * load-testing ingest pipelines without a live cluster.
+ *
+ * One port speaks both protocols:
+ * - HTTP POST JSON-RPC: getProgramAccounts (dataSize filter, withContext),
+ *   getAccountInfo, getSlot
+ * - WebSocket JSON-RPC: the same methods plus programSubscribe /
+ *   programUnsubscribe with programNotification pushes
+ *
+ * Accounts come from a recorded getProgramAccounts response (--snapshot)
+ * or a synthetic universe (see synthetic.hpp). A mutator replays a
+ * synthetic swap stream onto Pool/NPool accounts at --rate updates per
+ * second using the SDK's structs and math, and pushes each change to
+ * program subscribers. Notifications
+ * carry an extra "mockSendNs" field in their context (CLOCK_MONOTONIC
+ * nanoseconds) so clients on the same host can measure delivery latency.
+ *
+ * Build:
+ *   cmake -DAEX402_BUILD_MOCK_SERVER=ON ..
+ *   make aex402_mock_server
+ *
+ * Usage:
+ *   ./aex402_mock_server [--port 8899] [--snapshot gpa.json]
+ *                        [--pools 1000] [--npools 200] [--farms 200] [--orderbooks 50]
+ *                        [--rate 1000] [--seed 1]
+ *
+ * POSIX only. Single-threaded poll() loop; slow WebSocket consumers are
+ * disconnected once their send buffer exceeds --max-buffer-mb.
+ */
+
+#include "aex402.hpp"
+#include "synthetic.hpp"
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace aex402;
+
+namespace {
+
+// ============================================================================
+// Encoding Helpers
+// ============================================================================
+
+const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void base64_append(std::string& out, const uint8_t* p, size_t n) {
+    size_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        uint32_t v = (uint32_t(p[i]) << 16) | (uint32_t(p[i + 1]) << 8) | p[i + 2];
+        out += B64[v >> 18];
+        out += B64[(v >> 12) & 63];
+        out += B64[(v >> 6) & 63];
+        out += B64[v & 63];
+    }
+    if (i < n) {
+        uint32_t v = uint32_t(p[i]) << 16;
+        if (i + 1 < n) v |= uint32_t(p[i + 1]) << 8;
+        out += B64[v >> 18];
+        out += B64[(v >> 12) & 63];
+        out += i + 1 < n ? B64[(v >> 6) & 63] : '=';
+        out += '=';
+    }
+}
+
+bool base64_decode(const std::string& in, std::vector<uint8_t>& out) {
+    uint32_t acc = 0;
+    int bits = 0;
+    out.clear();
+    for (char c : in) {
+        int v;
+        if (c >= 'A' && c <= 'Z') v = c - 'A';
+        else if (c >= 'a' && c <= 'z') v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') v = c - '0' + 52;
+        else if (c == '+') v = 62;
+        else if (c == '/') v = 63;
+        else if (c == '=') break;
+        else return false;
+        acc = (acc << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>(acc >> bits));
+        }
+    }
+    return true;
+}
+
+// SHA-1, only for the WebSocket handshake (RFC 6455 section 4.2.2)
+void sha1(const uint8_t* msg, size_t len, uint8_t out[20]) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::vector<uint8_t> m(msg, msg + len);
+    m.push_back(0x80);
+    while (m.size() % 64 != 56) m.push_back(0);
+    uint64_t bit_len = static_cast<uint64_t>(len) * 8;
+    for (int i = 7; i >= 0; i--) m.push_back(static_cast<uint8_t>(bit_len >> (i * 8)));
+
+    auto rol = [](uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+    for (size_t off = 0; off < m.size(); off += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            const uint8_t* b = &m[off + static_cast<size_t>(i) * 4];
+            w[i] = (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | b[3];
+        }
+        for (int i = 16; i < 80; i++) w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+            uint32_t t = rol(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rol(b, 30); b = a; a = t;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 4; j++) out[i * 4 + j] = static_cast<uint8_t>(h[i] >> (24 - 8 * j));
+    }
+}
+
+uint64_t monotonic_ns() {
+    auto d = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+// ============================================================================
+// Minimal JSON Scanning
+// ============================================================================
+
+// The server only needs a handful of fields from small requests, so it
+// scans for "key": and reads the value that follows instead of parsing.
+
+size_t skip_ws(const std::string& s, size_t i) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n' || s[i] == ':')) i++;
+    return i;
+}
+
+// Position just past "key", or npos
+size_t find_key(const std::string& s, const char* key, size_t from = 0) {
+    std::string pat = std::string("\"") + key + "\"";
+    size_t p = s.find(pat, from);
+    return p == std::string::npos ? p : p + pat.size();
+}
+
+bool read_string_at(const std::string& s, size_t i, std::string& out, size_t* end = nullptr) {
+    i = skip_ws(s, i);
+    if (i >= s.size() || s[i] != '"') return false;
+    size_t close = s.find('"', i + 1);
+    if (close == std::string::npos) return false;
+    out = s.substr(i + 1, close - i - 1);
+    if (end) *end = close + 1;
+    return true;
+}
+
+// Raw text of a scalar value (number, string with quotes, null)
+std::string raw_value(const std::string& s, const char* key) {
+    size_t p = find_key(s, key);
+    if (p == std::string::npos) return "null";
+    p = skip_ws(s, p);
+    size_t e = p;
+    if (e < s.size() && s[e] == '"') {
+        e = s.find('"', e + 1);
+        return e == std::string::npos ? "null" : s.substr(p, e - p + 1);
+    }
+    while (e < s.size() && s[e] != ',' && s[e] != '}' && s[e] != ']' && s[e] != ' ') e++;
+    return e > p ? s.substr(p, e - p) : "null";
+}
+
+// First string element of "params"
+bool first_param(const std::string& s, std::string& out) {
+    size_t p = find_key(s, "params");
+    if (p == std::string::npos) return false;
+    p = skip_ws(s, p);
+    if (p >= s.size() || s[p] != '[') return false;
+    return read_string_at(s, p + 1, out);
+}
+
+// ============================================================================
+// Account Store
+// ============================================================================
+
+/**
+ * Accounts served by the mock, held as a synthetic::Universe so recorded
+ * and generated data share the same swap stream and replay code.
+ */
+class AccountStore {
+public:
+    const std::string program_b58{PROGRAM_ID_STR};
+
+    synthetic::Universe universe;
+    std::vector<std::string> key_b58;   // Parallel to universe.accounts
+
+    size_t size() const { return universe.accounts.size(); }
+    size_t mutable_count() const { return universe.pools.size() + universe.npools.size(); }
+
+    void add(const Pubkey& key, std::vector<uint8_t> data) {
+        auto [idx, inserted] = index_.try_emplace(key, size());
+        if (!inserted) {
+            universe.accounts[*idx].data = std::move(data);
+            b64_[*idx].clear();
+            return;
+        }
+        AccountType type = detect_account_type(data.data(), data.size());
+        if (type == AccountType::Pool) universe.pools.push_back(size());
+        if (type == AccountType::NPool) universe.npools.push_back(size());
+        universe.accounts.push_back({key, type, std::move(data)});
+        key_b58.push_back(pda::base58_encode(key));
+        b64_.emplace_back();
+    }
+
+    std::optional<size_t> find(const std::string& b58) const {
+        const size_t* idx = index_.find(pda::base58_decode(b58));
+        return idx ? std::optional<size_t>(*idx) : std::nullopt;
+    }
+
+    const std::vector<uint8_t>& data(size_t i) const { return universe.accounts[i].data; }
+
+    const std::string& b64(size_t i) {
+        if (b64_[i].empty()) base64_append(b64_[i], universe.accounts[i].data.data(), universe.accounts[i].data.size());
+        return b64_[i];
+    }
+
+    /**
+     * Load a recorded getProgramAccounts response (base64 encoding).
+     */
+    bool load_snapshot(const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) return false;
+        std::stringstream ss;
+        ss << f.rdbuf();
+        std::string s = ss.str();
+
+        // Entries are {"account":{...,"data":[b64,"base64"],...},"pubkey":...}
+        // as returned by the RPC, or with "pubkey" first; either order works
+        // as long as it is consistent within the file.
+        size_t pos = 0;
+        std::vector<uint8_t> bytes;
+        for (;;) {
+            size_t k = find_key(s, "pubkey", pos);
+            size_t d = find_key(s, "data", pos);
+            if (k == std::string::npos || d == std::string::npos) break;
+            if (d < k) k = find_key(s, "pubkey", d);
+            if (k == std::string::npos) break;
+
+            std::string key;
+            std::string b64;
+            size_t key_end = k;
+            size_t data_end = d;
+            d = skip_ws(s, d);
+            if (d < s.size() && s[d] == '[') d++;
+            if (!read_string_at(s, k, key, &key_end) || !read_string_at(s, d, b64, &data_end)) break;
+            pos = key_end > data_end ? key_end : data_end;
+            if (!base64_decode(b64, bytes)) continue;
+            add(pda::base58_decode(key), bytes);
+        }
+        return size() > 0;
+    }
+
+    /**
+     * Generate a synthetic universe (pools, NPools, farms, orderbooks).
+     */
+    void generate(const synthetic::UniverseConfig& cfg) {
+        synthetic::Universe u = synthetic::generate_universe(cfg);
+        for (auto& a : u.accounts) add(a.address, std::move(a.data));
+        universe.now = u.now;
+        universe.slot = u.slot;
+    }
+
+    /**
+     * Apply the next swap from the stream. Returns the changed account.
+     */
+    std::optional<size_t> mutate(synthetic::SwapStream& swaps) {
+        if (swaps.empty()) return std::nullopt;
+        synthetic::SwapEvent ev = swaps.next();
+        if (!synthetic::apply_swap(universe.accounts[ev.account], ev)) return std::nullopt;
+        b64_[ev.account].clear();
+        return ev.account;
+    }
+
+private:
+    PubkeyMap<size_t> index_;
+    std::vector<std::string> b64_;      // Cached encodings; empty when stale
+};
+
+// ============================================================================
+// Server
+// ============================================================================
+
+struct Options {
+    uint16_t port = 8899;
+    std::string snapshot;
+    size_t pools = 1000;
+    size_t npools = 200;
+    size_t farms = 200;
+    size_t orderbooks = 50;
+    double rate = 1000.0;           // Mutations per second
+    uint64_t seed = 1;
+    size_t max_buffer = 64u << 20;  // Per-connection send buffer limit
+};
+
+struct Connection {
+    int fd;
+    std::string in;
+    std::string out;
+    bool websocket = false;
+    bool closing = false;
+    std::string fragment;           // Partial WebSocket message
+    std::vector<uint64_t> subs;     // programSubscribe ids
+};
+
+struct Stats {
+    uint64_t requests = 0;
+    uint64_t updates = 0;
+    uint64_t notifications = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t dropped = 0;
+};
+
+constexpr uint64_t BASE_SLOT = 250000000ULL;
+
+volatile std::sig_atomic_t g_stop = 0;
+
+class MockServer {
+public:
+    MockServer(Options opt, AccountStore& store)
+        : opt_(std::move(opt)), store_(store), swaps_(store.universe, opt_.seed, swap_config(opt_)) {}
+
+    bool listen() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd_ < 0) return false;
+        int one = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(opt_.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+        if (::listen(listen_fd_, 128) != 0) return false;
+        set_nonblocking(listen_fd_);
+        return true;
+    }
+
+    void run() {
+        start_ns_ = monotonic_ns();
+        uint64_t last_tick = start_ns_;
+        uint64_t last_report = start_ns_;
+        double owed = 0.0;
+
+        while (!g_stop) {
+            std::vector<pollfd> fds;
+            fds.push_back({listen_fd_, POLLIN, 0});
+            for (const auto& c : conns_) {
+                short ev = POLLIN;
+                if (!c->out.empty()) ev |= POLLOUT;
+                fds.push_back({c->fd, ev, 0});
+            }
+            ::poll(fds.data(), static_cast<nfds_t>(fds.size()), 1);
+
+            if (fds[0].revents & POLLIN) accept_all();
+            for (size_t i = 1; i < fds.size(); i++) {
+                Connection& c = *conns_[i - 1];
+                if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) c.closing = true;
+                if (fds[i].revents & POLLIN) on_readable(c);
+                if (!c.out.empty()) flush(c);
+            }
+            reap();
+
+            // Mutations owed since the last tick
+            uint64_t now = monotonic_ns();
+            owed += opt_.rate * static_cast<double>(now - last_tick) / 1e9;
+            last_tick = now;
+            for (; owed >= 1.0; owed -= 1.0) mutate_once();
+
+            if (now - last_report >= 1000000000ULL) {
+                report(now);
+                last_report = now;
+            }
+        }
+        for (auto& c : conns_) ::close(c->fd);
+        ::close(listen_fd_);
+    }
+
+private:
+    Options opt_;
+    AccountStore& store_;
+    synthetic::SwapStream swaps_;
+    int listen_fd_ = -1;
+    std::vector<std::unique_ptr<Connection>> conns_;
+    uint64_t next_sub_ = 1;
+    uint64_t start_ns_ = 0;
+    Stats stats_;
+
+    static void set_nonblocking(int fd) { ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+    uint64_t slot() const { return BASE_SLOT + (monotonic_ns() - start_ns_) / 400000000ULL; }
+
+    static synthetic::SwapStreamConfig swap_config(const Options& opt) {
+        synthetic::SwapStreamConfig cfg;
+        cfg.rate = opt.rate > 0 ? opt.rate : 1.0;
+        return cfg;
+    }
+
+    void accept_all() {
+        for (;;) {
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) return;
+            set_nonblocking(fd);
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            conns_.push_back(std::make_unique<Connection>(Connection{fd, {}, {}, false, false, {}, {}}));
+        }
+    }
+
+    void reap() {
+        for (size_t i = 0; i < conns_.size();) {
+            if (conns_[i]->closing && conns_[i]->out.empty()) {
+                ::close(conns_[i]->fd);
+                conns_[i] = std::move(conns_.back());
+                conns_.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+
+    void flush(Connection& c) {
+        while (!c.out.empty()) {
+            ssize_t n = ::send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+            if (n <= 0) {
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+                c.out.clear();
+                c.closing = true;
+                return;
+            }
+            stats_.bytes_sent += static_cast<uint64_t>(n);
+            c.out.erase(0, static_cast<size_t>(n));
+        }
+    }
+
+    void on_readable(Connection& c) {
+        char buf[65536];
+        for (;;) {
+            ssize_t n = ::recv(c.fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                c.in.append(buf, static_cast<size_t>(n));
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) c.closing = true;
+            break;
+        }
+        if (c.websocket) {
+            read_frames(c);
+        } else {
+            read_http(c);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // HTTP
+    // ------------------------------------------------------------------------
+
+    static std::string header_value(const std::string& head, const char* name) {
+        std::string lower = head;
+        for (auto& ch : lower) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        std::string pat = std::string("\r\n") + name + ":";
+        size_t p = lower.find(pat);
+        if (p == std::string::npos) return {};
+        p += pat.size();
+        size_t e = head.find("\r\n", p);
+        std::string v = head.substr(p, e - p);
+        size_t b = v.find_first_not_of(' ');
+        return b == std::string::npos ? std::string() : v.substr(b);
+    }
+
+    void read_http(Connection& c) {
+        for (;;) {
+            size_t end = c.in.find("\r\n\r\n");
+            if (end == std::string::npos) return;
+            std::string head = c.in.substr(0, end);
+
+            if (!header_value(head, "sec-websocket-key").empty()) {
+                upgrade(c, header_value(head, "sec-websocket-key"));
+                c.in.erase(0, end + 4);
+                read_frames(c);
+                return;
+            }
+
+            size_t len = static_cast<size_t>(std::strtoull(header_value(head, "content-length").c_str(), nullptr, 10));
+            if (c.in.size() < end + 4 + len) return;
+            std::string body = c.in.substr(end + 4, len);
+            c.in.erase(0, end + 4 + len);
+
+            std::string resp = handle(c, body);
+            c.out += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: ";
+            c.out += std::to_string(resp.size());
+            c.out += "\r\n\r\n";
+            c.out += resp;
+        }
+    }
+
+    void upgrade(Connection& c, const std::string& key) {
+        std::string accept_src = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        uint8_t digest[20];
+        sha1(reinterpret_cast<const uint8_t*>(accept_src.data()), accept_src.size(), digest);
+        std::string accept;
+        base64_append(accept, digest, sizeof(digest));
+        c.out += "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 "Sec-WebSocket-Accept: " + accept + "\r\n\r\n";
+        c.websocket = true;
+    }
+
+    // ------------------------------------------------------------------------
+    // WebSocket framing
+    // ------------------------------------------------------------------------
+
+    static void frame(std::string& out, uint8_t opcode, const std::string& payload) {
+        out += static_cast<char>(0x80 | opcode);
+        size_t n = payload.size();
+        if (n < 126) {
+            out += static_cast<char>(n);
+        } else if (n < 65536) {
+            out += static_cast<char>(126);
+            out += static_cast<char>(n >> 8);
+            out += static_cast<char>(n & 0xFF);
+        } else {
+            out += static_cast<char>(127);
+            for (int i = 7; i >= 0; i--) out += static_cast<char>((static_cast<uint64_t>(n) >> (i * 8)) & 0xFF);
+        }
+        out += payload;
+    }
+
+    void read_frames(Connection& c) {
+        for (;;) {
+            const auto* p = reinterpret_cast<const uint8_t*>(c.in.data());
+            size_t avail = c.in.size();
+            if (avail < 2) return;
+            bool fin = p[0] & 0x80;
+            uint8_t opcode = p[0] & 0x0F;
+            bool masked = p[1] & 0x80;
+            uint64_t len = p[1] & 0x7F;
+            size_t hdr = 2;
+            if (len == 126) {
+                if (avail < 4) return;
+                len = (uint64_t(p[2]) << 8) | p[3];
+                hdr = 4;
+            } else if (len == 127) {
+                if (avail < 10) return;
+                len = 0;
+                for (int i = 0; i < 8; i++) len = (len << 8) | p[2 + i];
+                hdr = 10;
+            }
+            size_t mask_at = hdr;
+            if (masked) hdr += 4;
+            if (avail < hdr + len) return;
+
+            std::string payload = c.in.substr(hdr, static_cast<size_t>(len));
+            if (masked) {
+                for (size_t i = 0; i < payload.size(); i++) payload[i] = static_cast<char>(payload[i] ^ p[mask_at + i % 4]);
+            }
+            c.in.erase(0, hdr + static_cast<size_t>(len));
+
+            switch (opcode) {
+                case 0x0:  // Continuation
+                case 0x1:  // Text
+                case 0x2:  // Binary
+                    c.fragment += payload;
+                    if (fin) {
+                        std::string msg = std::move(c.fragment);
+                        c.fragment.clear();
+                        frame(c.out, 0x1, handle(c, msg));
+                    }
+                    break;
+                case 0x8:  // Close
+                    frame(c.out, 0x8, payload.substr(0, 2));
+                    c.closing = true;
+                    return;
+                case 0x9:  // Ping
+                    frame(c.out, 0xA, payload);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // JSON-RPC
+    // ------------------------------------------------------------------------
+
+    std::string account_json(size_t i) {
+        size_t space = store_.data(i).size();
+        std::string s = "{\"data\":[\"";
+        s += store_.b64(i);
+        s += "\",\"base64\"],\"executable\":false,\"lamports\":";
+        s += std::to_string((space + 128) * 6960);
+        s += ",\"owner\":\"" + store_.program_b58 + "\",\"rentEpoch\":18446744073709551615,\"space\":";
+        s += std::to_string(space);
+        s += "}";
+        return s;
+    }
+
+    std::string context_json() const {
+        return "{\"apiVersion\":\"mock\",\"slot\":" + std::to_string(slot()) + "}";
+    }
+
+    static std::string reply(const std::string& id, const std::string& result) {
+        return "{\"jsonrpc\":\"2.0\",\"result\":" + result + ",\"id\":" + id + "}";
+    }
+
+    static std::string error(const std::string& id, int code, const char* msg) {
+        return "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":" + std::to_string(code) +
+               ",\"message\":\"" + msg + "\"},\"id\":" + id + "}";
+    }
+
+    std::string handle(Connection& c, const std::string& req) {
+        stats_.requests++;
+        std::string id = raw_value(req, "id");
+        std::string method;
+        size_t m = find_key(req, "method");
+        if (m == std::string::npos || !read_string_at(req, m, method)) return error(id, -32600, "Invalid request");
+
+        if (method == "getSlot") return reply(id, std::to_string(slot()));
+
+        if (method == "getAccountInfo") {
+            std::string key;
+            if (!first_param(req, key)) return error(id, -32602, "Invalid params");
+            auto idx = store_.find(key);
+            std::string value = idx ? account_json(*idx) : "null";
+            return reply(id, "{\"context\":" + context_json() + ",\"value\":" + value + "}");
+        }
+
+        if (method == "getProgramAccounts") {
+            std::string program;
+            if (!first_param(req, program)) return error(id, -32602, "Invalid params");
+            std::string ds = raw_value(req, "dataSize");
+            long long data_size = ds == "null" ? -1 : std::atoll(ds.c_str());
+
+            std::string list = "[";
+            if (program == store_.program_b58) {
+                bool first = true;
+                for (size_t i = 0; i < store_.size(); i++) {
+                    if (data_size >= 0 && store_.data(i).size() != static_cast<size_t>(data_size)) continue;
+                    if (!first) list += ',';
+                    first = false;
+                    list += "{\"account\":" + account_json(i) + ",\"pubkey\":\"" + store_.key_b58[i] + "\"}";
+                }
+            }
+            list += "]";
+            if (raw_value(req, "withContext") == "true") {
+                return reply(id, "{\"context\":" + context_json() + ",\"value\":" + list + "}");
+            }
+            return reply(id, list);
+        }
+
+        if (method == "programSubscribe") {
+            if (!c.websocket) return error(id, -32601, "Subscriptions require a WebSocket");
+            std::string program;
+            if (!first_param(req, program) || program != store_.program_b58) {
+                return error(id, -32602, "Invalid params: unknown program");
+            }
+            c.subs.push_back(next_sub_);
+            return reply(id, std::to_string(next_sub_++));
+        }
+
+        if (method == "programUnsubscribe") {
+            size_t p = find_key(req, "params");
+            uint64_t sub = p == std::string::npos ? 0 : std::strtoull(req.c_str() + skip_ws(req, p) + 1, nullptr, 10);
+            for (size_t i = 0; i < c.subs.size(); i++) {
+                if (c.subs[i] == sub) {
+                    c.subs.erase(c.subs.begin() + static_cast<std::ptrdiff_t>(i));
+                    return reply(id, "true");
+                }
+            }
+            return reply(id, "false");
+        }
+
+        return error(id, -32601, "Method not found");
+    }
+
+    // ------------------------------------------------------------------------
+    // Mutation and notifications
+    // ------------------------------------------------------------------------
+
+    void mutate_once() {
+        auto idx = store_.mutate(swaps_);
+        if (!idx) return;
+        stats_.updates++;
+
+        std::string head = "{\"jsonrpc\":\"2.0\",\"method\":\"programNotification\",\"params\":{\"result\":"
+                           "{\"context\":{\"slot\":" + std::to_string(slot()) +
+                           ",\"mockSendNs\":" + std::to_string(monotonic_ns()) + "},\"value\":{\"account\":" +
+                           account_json(*idx) + ",\"pubkey\":\"" + store_.key_b58[*idx] + "\"}},\"subscription\":";
+        for (auto& c : conns_) {
+            if (c->closing) continue;
+            for (uint64_t sub : c->subs) {
+                if (c->out.size() > opt_.max_buffer) {
+                    c->out.clear();
+                    c->closing = true;
+                    stats_.dropped++;
+                    break;
+                }
+                frame(c->out, 0x1, head + std::to_string(sub) + "}}");
+                stats_.notifications++;
+            }
+        }
+    }
+
+    void report(uint64_t now) {
+        size_t ws = 0;
+        for (const auto& c : conns_) {
+            if (c->websocket) ws++;
+        }
+        std::fprintf(stderr, "[%6.1fs] slot=%llu conns=%zu ws=%zu requests=%llu updates=%llu "
+                     "notifications=%llu sent=%.1fMB dropped=%llu\n",
+                     static_cast<double>(now - start_ns_) / 1e9,
+                     static_cast<unsigned long long>(slot()), conns_.size(), ws,
+                     static_cast<unsigned long long>(stats_.requests),
+                     static_cast<unsigned long long>(stats_.updates),
+                     static_cast<unsigned long long>(stats_.notifications),
+                     static_cast<double>(stats_.bytes_sent) / 1e6,
+                     static_cast<unsigned long long>(stats_.dropped));
+    }
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "Usage: %s [--port N] [--snapshot gpa.json] [--pools N] [--npools N]\n"
+                 "          [--farms N] [--orderbooks N]\n"
+                 "          [--rate UPDATES_PER_SEC] [--seed N] [--max-buffer-mb N]\n", argv0);
+}
+
+}  // namespace
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!v) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (a == "--port") opt.port = static_cast<uint16_t>(std::atoi(v));
+        else if (a == "--snapshot") opt.snapshot = v;
+        else if (a == "--pools") opt.pools = std::strtoull(v, nullptr, 10);
+        else if (a == "--npools") opt.npools = std::strtoull(v, nullptr, 10);
+        else if (a == "--farms") opt.farms = std::strtoull(v, nullptr, 10);
+        else if (a == "--orderbooks") opt.orderbooks = std::strtoull(v, nullptr, 10);
+        else if (a == "--rate") opt.rate = std::atof(v);
+        else if (a == "--seed") opt.seed = std::strtoull(v, nullptr, 10);
+        else if (a == "--max-buffer-mb") opt.max_buffer = std::strtoull(v, nullptr, 10) << 20;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    AccountStore store;
+    if (!opt.snapshot.empty()) {
+        if (!store.load_snapshot(opt.snapshot)) {
+            std::fprintf(stderr, "Failed to load snapshot %s\n", opt.snapshot.c_str());
+            return 1;
+        }
+    } else {
+        synthetic::UniverseConfig cfg;
+        cfg.seed = opt.seed;
+        cfg.pools = opt.pools;
+        cfg.npools = opt.npools;
+        cfg.farms = opt.farms;
+        cfg.orderbooks = opt.orderbooks;
+        store.generate(cfg);
+    }
+    store.universe.now = static_cast<int64_t>(std::time(nullptr));
+    store.universe.slot = BASE_SLOT;
+
+    MockServer server(opt, store);
+    if (!server.listen()) {
+        std::fprintf(stderr, "Cannot listen on 127.0.0.1:%u: %s\n", opt.port, std::strerror(errno));
+        return 1;
+    }
+    std::signal(SIGINT, [](int) { g_stop = 1; });
+    std::signal(SIGTERM, [](int) { g_stop = 1; });
+    std::fprintf(stderr, "Serving %zu accounts (%zu mutable) on http://127.0.0.1:%u and ws://127.0.0.1:%u\n",
+                 store.size(), store.mutable_count(), opt.port, opt.port);
+    server.run();
+    return 0;
+}
@@ -0,0 +1,370 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Pool Health Monitor
+ *
+ * Keeps the health-relevant fields of every Pool and NPool in column
+ * (structure-of-arrays) form and evaluates a configurable rule set over
+ * the whole universe after each update batch:
+ * - Imbalance: largest/smallest balance beyond max_ratio (the rule of
+ *   math::check_imbalance; empty pools are not flagged)
+ * - VirtualPriceDrop: D / lp_supply below its high-water mark by vp_drop_bps
+ * - AmpRamp: an amp ramp is scheduled or in progress
+ * - Paused: the pool is paused
+ * - AdminFees: unclaimed admin fees of some token above admin_fee_bps of
+ *   its balance
+ *
+ * update() decodes an account into the columns (computing D for the
+ * virtual price); evaluate() runs each enabled rule as one branch-free
+ * loop over 4-byte columns, which the compiler vectorizes at -O3, then
+ * diffs the result against the previous state. Events are emitted only when a rule
+ * turns on or off for a pool, so a condition that persists across batches
+ * is reported once. Numeric rules clear only after moving back inside the
+ * threshold by hysteresis_bps, so a value hovering at the boundary does
+ * not flap.
+ *
+ * Usage:
+ *   PoolMonitor monitor;
+ *   for (const auto& acc : batch) monitor.update(acc.pubkey, acc.data, acc.len, now);
+ *   std::vector<HealthEvent> events;
+ *   monitor.evaluate(now, slot, events);
+ *   for (const auto& e : events) alert(e.pool, health_rule_name(e.rule), e.raised, e.value);
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+#include "types.hpp"
+#include "constants.hpp"
+#include "accounts.hpp"
+#include "math.hpp"
+#include "pubkey_map.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Rules
+// ============================================================================
+
+/**
+ * Health rules (bit flags).
+ */
+enum class HealthRule : uint32_t {
+    None             = 0,
+    Imbalance        = 1u << 0,  // Balance ratio beyond max_ratio
+    VirtualPriceDrop = 1u << 1,  // Virtual price below its high-water mark
+    AmpRamp          = 1u << 2,  // Amp ramp scheduled or in progress
+    Paused           = 1u << 3,  // Pool paused
+    AdminFees        = 1u << 4,  // Unclaimed admin fees piling up
+};
+
+constexpr size_t HEALTH_RULES = 5;
+constexpr uint32_t HEALTH_ALL_RULES = (1u << HEALTH_RULES) - 1;
+
+inline constexpr uint32_t operator|(HealthRule a, HealthRule b) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+}
+
+inline constexpr uint32_t operator|(uint32_t a, HealthRule b) {
+    return a | static_cast<uint32_t>(b);
+}
+
+/**
+ * Get health rule name as string.
+ */
+inline const char* health_rule_name(HealthRule r) {
+    switch (r) {
+        case HealthRule::None:             return "None";
+        case HealthRule::Imbalance:        return "Imbalance";
+        case HealthRule::VirtualPriceDrop: return "VirtualPriceDrop";
+        case HealthRule::AmpRamp:          return "AmpRamp";
+        case HealthRule::Paused:           return "Paused";
+        case HealthRule::AdminFees:        return "AdminFees";
+        default:                           return "Unknown";
+    }
+}
+
+/**
+ * Rule set and thresholds.
+ */
+struct MonitorConfig {
+    uint32_t rules = HEALTH_ALL_RULES;  // Enabled rules (HealthRule bits)
+    uint64_t max_ratio = 10;            // Imbalance: largest / smallest balance
+    uint64_t vp_drop_bps = 10;          // VirtualPriceDrop: drop from the high-water mark
+    uint64_t admin_fee_bps = 100;       // AdminFees: fees relative to the token balance
+    uint64_t hysteresis_bps = 1000;     // Numeric rules clear this far (relative) inside the threshold
+};
+
+/**
+ * A rule turning on or off for one pool.
+ */
+struct HealthEvent {
+    Pubkey     pool;
+    HealthRule rule;
+    bool       raised;      // true when the condition starts, false when it clears
+    uint64_t   slot;
+    int64_t    timestamp;
+    double     value;       // Balance ratio, drop in bps, target amp, fee bps; 0 for Paused
+};
+
+// ============================================================================
+// PoolMonitor
+// ============================================================================
+
+class PoolMonitor {
+public:
+    explicit PoolMonitor(MonitorConfig cfg = {}) : cfg_(cfg) {}
+
+    const MonitorConfig& config() const { return cfg_; }
+    size_t pool_count() const { return index_.size(); }
+
+    void reserve(size_t pools) {
+        index_.reserve(pools);
+        address_.reserve(pools);
+        amp_to_.reserve(pools);
+        for (auto* c : {&lo_, &hi_, &vp_, &vp_peak_, &fee_, &fee_bal_}) c->reserve(pools);
+        for (auto* c : {&ramp_stop_, &ramping_, &paused_, &live_, &state_, &next_}) c->reserve(pools);
+    }
+
+    /**
+     * Decode a Pool or NPool account into its row.
+     *
+     * @param now Unix time, for the effective amp of a ramping Pool
+     * @return false if the data is not a Pool or NPool
+     */
+    bool update(const Pubkey& address, const uint8_t* data, size_t len, int64_t now) {
+        if (auto v = view_pool(data, len)) {
+            size_t i = row(address);
+            const uint64_t b0 = v->bal0();
+            const uint64_t b1 = v->bal1();
+            lo_[i] = static_cast<float>(b0 < b1 ? b0 : b1);
+            hi_[i] = static_cast<float>(b0 < b1 ? b1 : b0);
+            vp_[i] = virtual_price(math::calc_d(b0, b1, v->get_amp(now)), v->lp_supply());
+
+            // Token whose admin fees are the larger share of its balance
+            const uint64_t f0 = v->admin_fee0();
+            const uint64_t f1 = v->admin_fee1();
+            const bool second = static_cast<double>(f1) * static_cast<double>(b0) >
+                                static_cast<double>(f0) * static_cast<double>(b1);
+            fee_[i] = static_cast<float>(second ? f1 : f0);
+            fee_bal_[i] = static_cast<float>(second ? b1 : b0);
+
+            ramp_stop_[i] = clamp_time(v->ramp_stop());
+            ramping_[i] = v->amp() != v->target_amp() ? 1 : 0;
+            amp_to_[i] = v->target_amp();
+            paused_[i] = v->is_paused() ? 1 : 0;
+            live_[i] = ~0u;
+            return true;
+        }
+
+        if (auto v = view_npool(data, len)) {
+            const uint8_t n = v->n_tokens();
+            if (n < 2 || n > MAX_TOKENS) return false;
+            size_t i = row(address);
+            uint64_t bal[MAX_TOKENS];
+            uint64_t lo = UINT64_MAX, hi = 0;
+            double worst = -1.0;
+            for (uint8_t k = 0; k < n; k++) {
+                bal[k] = v->balance(k);
+                if (bal[k] < lo) lo = bal[k];
+                if (bal[k] > hi) hi = bal[k];
+                const uint64_t f = v->admin_fee(k);
+                const double share = bal[k] ? static_cast<double>(f) / static_cast<double>(bal[k])
+                                            : (f > 0 ? HUGE_VAL : 0.0);
+                if (share > worst) {
+                    worst = share;
+                    fee_[i] = static_cast<float>(f);
+                    fee_bal_[i] = static_cast<float>(bal[k]);
+                }
+            }
+            lo_[i] = static_cast<float>(lo);
+            hi_[i] = static_cast<float>(hi);
+            vp_[i] = virtual_price(math::calc_d_n(bal, n, v->amp()), v->lp_supply());
+
+            ramp_stop_[i] = 0;
+            ramping_[i] = 0;
+            amp_to_[i] = v->amp();
+            paused_[i] = v->is_paused() ? 1 : 0;
+            live_[i] = ~0u;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Stop tracking a pool (closed account). No clear events are emitted.
+     */
+    bool remove(const Pubkey& address) {
+        const size_t* idx = index_.find(address);
+        if (!idx) return false;
+        live_[*idx] = 0;
+        state_[*idx] = 0;
+        return true;
+    }
+
+    /**
+     * Evaluate every enabled rule over all pools and append an event for
+     * each rule that turned on or off since the previous call.
+     *
+     * @return Number of events appended
+     */
+    size_t evaluate(int64_t now, uint64_t slot, std::vector<HealthEvent>& events) {
+        const size_t n = state_.size();
+        const uint32_t rules = cfg_.rules;
+        const float keep = 1.0f - static_cast<float>(cfg_.hysteresis_bps) / 10000.0f;
+        uint32_t* next = next_.data();
+        const uint32_t* state = state_.data();
+
+        for (size_t i = 0; i < n; i++) next[i] = 0;
+
+        if (rules & static_cast<uint32_t>(HealthRule::Imbalance)) {
+            constexpr uint32_t bit = static_cast<uint32_t>(HealthRule::Imbalance);
+            const float on = static_cast<float>(cfg_.max_ratio);
+            const float off = on * keep;
+            const float* lo = lo_.data();
+            const float* hi = hi_.data();
+            for (size_t i = 0; i < n; i++) {
+                const float lim = lo[i] * ((state[i] & bit) ? off : on);
+                next[i] |= hi[i] > lim ? bit : 0u;
+            }
+        }
+
+        if (rules & static_cast<uint32_t>(HealthRule::VirtualPriceDrop)) {
+            constexpr uint32_t bit = static_cast<uint32_t>(HealthRule::VirtualPriceDrop);
+            const float drop = static_cast<float>(cfg_.vp_drop_bps) / 10000.0f;
+            const float on = 1.0f - drop;
+            const float off = 1.0f - drop * keep;
+            const float* vp = vp_.data();
+            float* peak = vp_peak_.data();
+            for (size_t i = 0; i < n; i++) {
+                peak[i] = vp[i] > peak[i] ? vp[i] : peak[i];
+                const float lim = peak[i] * ((state[i] & bit) ? off : on);
+                next[i] |= (vp[i] > 0.0f && vp[i] < lim) ? bit : 0u;
+            }
+        }
+
+        if (rules & static_cast<uint32_t>(HealthRule::AmpRamp)) {
+            constexpr uint32_t bit = static_cast<uint32_t>(HealthRule::AmpRamp);
+            const uint32_t t = clamp_time(now);
+            const uint32_t* stop = ramp_stop_.data();
+            const uint32_t* ramping = ramping_.data();
+            for (size_t i = 0; i < n; i++) {
+                next[i] |= (stop[i] > t && ramping[i]) ? bit : 0u;
+            }
+        }
+
+        if (rules & static_cast<uint32_t>(HealthRule::Paused)) {
+            constexpr uint32_t bit = static_cast<uint32_t>(HealthRule::Paused);
+            const uint32_t* paused = paused_.data();
+            for (size_t i = 0; i < n; i++) {
+                next[i] |= paused[i] ? bit : 0u;
+            }
+        }
+
+        if (rules & static_cast<uint32_t>(HealthRule::AdminFees)) {
+            constexpr uint32_t bit = static_cast<uint32_t>(HealthRule::AdminFees);
+            const float on = static_cast<float>(cfg_.admin_fee_bps) / 10000.0f;
+            const float off = on * keep;
+            const float* fee = fee_.data();
+            const float* bal = fee_bal_.data();
+            for (size_t i = 0; i < n; i++) {
+                const float lim = bal[i] * ((state[i] & bit) ? off : on);
+                next[i] |= fee[i] > lim ? bit : 0u;
+            }
+        }
+
+        const uint32_t* live = live_.data();
+        for (size_t i = 0; i < n; i++) next[i] &= live[i];
+
+        // Transitions (rare; the scan is a compare per row)
+        const size_t before = events.size();
+        for (size_t i = 0; i < n; i++) {
+            if (next[i] == state[i]) continue;
+            uint32_t changed = next[i] ^ state[i];
+            state_[i] = next[i];
+            while (changed) {
+                const uint32_t bit = changed & (~changed + 1);
+                changed &= changed - 1;
+                const HealthRule rule = static_cast<HealthRule>(bit);
+                events.push_back(HealthEvent{address_[i], rule, (next[i] & bit) != 0, slot, now, metric(i, rule)});
+            }
+        }
+        return events.size() - before;
+    }
+
+    /**
+     * Rules currently on for a pool (HealthRule bits), 0 if unknown.
+     */
+    uint32_t state(const Pubkey& address) const {
+        const size_t* idx = index_.find(address);
+        return idx ? state_[*idx] : 0;
+    }
+
+    /**
+     * Number of pools with a rule currently on.
+     */
+    size_t active(HealthRule rule) const {
+        size_t count = 0;
+        for (uint32_t s : state_) count += (s & static_cast<uint32_t>(rule)) ? 1 : 0;
+        return count;
+    }
+
+private:
+    MonitorConfig cfg_;
+    PubkeyMap<size_t> index_;
+    std::vector<Pubkey> address_;
+    std::vector<uint64_t> amp_to_;            // Target amp, reported with AmpRamp
+
+    // Predicate columns, one row per pool. All 4 bytes wide so each rule
+    // loop vectorizes at a single lane width; single precision is ample for
+    // ratio thresholds.
+    std::vector<float> lo_, hi_;              // Smallest / largest balance
+    std::vector<float> vp_, vp_peak_;         // D / lp_supply and its high-water mark
+    std::vector<float> fee_, fee_bal_;        // Admin fees and balance of the worst token
+    std::vector<uint32_t> ramp_stop_;         // Unix seconds, clamped to 32 bits
+    std::vector<uint32_t> ramping_;           // amp != target_amp
+    std::vector<uint32_t> paused_;
+    std::vector<uint32_t> live_;              // All-ones while tracked
+    std::vector<uint32_t> state_, next_;      // HealthRule bits
+
+    size_t row(const Pubkey& address) {
+        auto [idx, inserted] = index_.try_emplace(address, address_.size());
+        if (inserted) {
+            address_.push_back(address);
+            amp_to_.push_back(0);
+            for (auto* c : {&lo_, &hi_, &vp_, &vp_peak_, &fee_, &fee_bal_}) c->push_back(0.0f);
+            for (auto* c : {&ramp_stop_, &ramping_, &paused_, &live_, &state_, &next_}) c->push_back(0);
+        }
+        return *idx;
+    }
+
+    static uint32_t clamp_time(int64_t t) {
+        if (t <= 0) return 0;
+        return t >= static_cast<int64_t>(UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(t);
+    }
+
+    static float virtual_price(std::optional<uint64_t> d, uint64_t lp_supply) {
+        if (!d || lp_supply == 0) return 0.0f;
+        return static_cast<float>(static_cast<double>(*d) / static_cast<double>(lp_supply));
+    }
+
+    double metric(size_t i, HealthRule rule) const {
+        switch (rule) {
+            case HealthRule::Imbalance:
+                return lo_[i] > 0 ? static_cast<double>(hi_[i]) / static_cast<double>(lo_[i]) : HUGE_VAL;
+            case HealthRule::VirtualPriceDrop:
+                return vp_peak_[i] > 0 ? (1.0 - static_cast<double>(vp_[i]) / static_cast<double>(vp_peak_[i])) * 10000.0 : 0.0;
+            case HealthRule::AmpRamp:
+                return static_cast<double>(amp_to_[i]);
+            case HealthRule::AdminFees:
+                return fee_bal_[i] > 0 ? static_cast<double>(fee_[i]) / static_cast<double>(fee_bal_[i]) * 10000.0 : HUGE_VAL;
+            default:
+                return 0.0;
+        }
+    }
+};
+
+}  // namespace aex402
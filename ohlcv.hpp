@@ -0,0 +1,305 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Streaming OHLCV Aggregation
+ *
+ * Builds candles at arbitrary resolutions (1s to 1d and beyond) from a
+ * stream of trades, per pool, in O(1) per trade and resolution.
+ *
+ * Storage is columnar (open/high/low/close/volume/trades in separate
+ * arrays) in a ring indexed by bucket number, so the candle for any time
+ * still inside the window is found without searching. Buckets with no
+ * trades are carried forward as flat candles at the previous close. Gaps
+ * are filled lazily: each slot records the bucket it last held, and a slot
+ * holding an older bucket reads as a flat candle at the close carried into
+ * the next traded bucket. A trade after a quiet period is still O(1); a
+ * read of an empty bucket walks forward to the next traded one.
+ *
+ * Prices are scaled 1e6 as in the on-chain candles (token1 per token0).
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <vector>
+#include "types.hpp"
+#include "pubkey_map.hpp"
+#include "inference.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+constexpr uint64_t OHLCV_PRICE_SCALE = 1000000;
+
+namespace resolution {
+    constexpr int64_t S1  = 1;
+    constexpr int64_t S5  = 5;
+    constexpr int64_t M1  = 60;
+    constexpr int64_t M5  = 300;
+    constexpr int64_t M15 = 900;
+    constexpr int64_t H1  = 3600;
+    constexpr int64_t H4  = 14400;
+    constexpr int64_t D1  = 86400;
+}
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * A trade as consumed by the aggregator.
+ */
+struct Trade {
+    int64_t timestamp;  // Unix seconds
+    uint64_t price;     // Scaled 1e6
+    uint64_t volume;    // Base (token0) amount
+};
+
+/**
+ * One candle, materialized from the columnar store.
+ */
+struct OhlcvBar {
+    int64_t start;      // Bucket start time
+    uint64_t open;
+    uint64_t high;
+    uint64_t low;
+    uint64_t close;
+    uint64_t volume;
+    uint32_t trades;
+};
+
+/**
+ * Convert an inferred swap into a trade (token1 per token0, scaled 1e6).
+ * Returns nullopt for non-swap events and zero amounts.
+ */
+inline std::optional<Trade> trade_from_event(const InferredEvent& e, int64_t timestamp) {
+    if (e.kind != EventKind::Swap || e.amount_in == 0 || e.amount_out == 0) return std::nullopt;
+    uint64_t base = e.token_in == 0 ? e.amount_in : e.amount_out;
+    uint64_t quote = e.token_in == 0 ? e.amount_out : e.amount_in;
+    __uint128_t price = static_cast<__uint128_t>(quote) * OHLCV_PRICE_SCALE / base;
+    if (price > UINT64_MAX) return std::nullopt;
+    return Trade{timestamp, static_cast<uint64_t>(price), base};
+}
+
+// ============================================================================
+// CandleSeries
+// ============================================================================
+
+/**
+ * Ring of the most recent `capacity` candles at one resolution.
+ */
+class CandleSeries {
+public:
+    CandleSeries(int64_t resolution_secs, size_t capacity)
+        : res_(resolution_secs > 0 ? resolution_secs : 1),
+          cap_(capacity > 0 ? capacity : 1),
+          bucket_(cap_, std::numeric_limits<int64_t>::min()), carry_(cap_),
+          open_(cap_), high_(cap_), low_(cap_), close_(cap_), volume_(cap_), trades_(cap_) {}
+
+    int64_t resolution() const { return res_; }
+    size_t capacity() const { return cap_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    uint64_t dropped() const { return dropped_; }
+
+    /**
+     * Add a trade. Trades older than the window are counted in dropped().
+     */
+    void update(const Trade& t) {
+        int64_t bucket = floor_div(t.timestamp, res_);
+
+        if (count_ == 0) {
+            head_ = bucket;
+            open_bucket(slot(bucket), bucket, t.price);
+            count_ = 1;
+        } else if (bucket > head_) {
+            // Skipped buckets are not written; they read as carried forward
+            uint64_t carry = close_[slot(head_)];
+            uint64_t gap = static_cast<uint64_t>(bucket - head_);
+            count_ = gap >= cap_ - count_ ? cap_ : count_ + static_cast<size_t>(gap);
+            head_ = bucket;
+            open_bucket(slot(bucket), bucket, carry);
+        } else if (head_ - bucket >= static_cast<int64_t>(count_)) {
+            dropped_++;
+            return;
+        } else if (!live(bucket)) {
+            // Late trade into a carried-forward bucket
+            open_bucket(slot(bucket), bucket, carry_before(bucket));
+        }
+
+        size_t i = slot(bucket);
+        if (trades_[i] == 0) {
+            // First trade of a carried-forward bucket
+            open_[i] = high_[i] = low_[i] = t.price;
+        } else {
+            if (t.price > high_[i]) high_[i] = t.price;
+            if (t.price < low_[i]) low_[i] = t.price;
+        }
+        close_[i] = t.price;  // Arrival order within a bucket
+        volume_[i] += t.volume;
+        trades_[i]++;
+    }
+
+    /**
+     * Candle i, oldest first (0 <= i < size()).
+     */
+    OhlcvBar at(size_t i) const {
+        return bar(head_ - static_cast<int64_t>(count_ - 1 - i));
+    }
+
+    OhlcvBar latest() const { return bar(head_); }
+
+    /**
+     * Candle covering timestamp, if still inside the window.
+     */
+    std::optional<OhlcvBar> find(int64_t timestamp) const {
+        if (count_ == 0) return std::nullopt;
+        int64_t bucket = floor_div(timestamp, res_);
+        if (bucket > head_ || head_ - bucket >= static_cast<int64_t>(count_)) return std::nullopt;
+        return bar(bucket);
+    }
+
+    /**
+     * Append candles with start in [from, to) to out, oldest first.
+     */
+    void range(int64_t from, int64_t to, std::vector<OhlcvBar>& out) const {
+        if (count_ == 0 || to <= from) return;
+        int64_t first = head_ - static_cast<int64_t>(count_) + 1;
+        int64_t lo = std::max(first, ceil_div(from, res_));
+        int64_t hi = std::min(head_, ceil_div(to, res_) - 1);
+        if (lo > hi) return;
+
+        // Walk newest to oldest so each empty bucket takes the carry of the
+        // traded bucket after it, then restore oldest-first order
+        size_t base = out.size();
+        uint64_t carry = live(hi) ? 0 : carry_before(hi);
+        for (int64_t b = hi; b >= lo; b--) {
+            if (live(b)) {
+                out.push_back(live_bar(slot(b)));
+                carry = carry_[slot(b)];
+            } else {
+                out.push_back(flat_bar(b, carry));
+            }
+        }
+        std::reverse(out.begin() + static_cast<std::ptrdiff_t>(base), out.end());
+    }
+
+private:
+    int64_t res_;
+    size_t cap_;
+    std::vector<int64_t> bucket_;     // Bucket each slot last held
+    std::vector<uint64_t> carry_;     // Close carried into the slot's bucket
+    std::vector<uint64_t> open_, high_, low_, close_, volume_;
+    std::vector<uint32_t> trades_;
+    int64_t head_ = 0;      // Newest bucket number
+    size_t count_ = 0;      // Buckets held (<= cap_)
+    uint64_t dropped_ = 0;
+
+    static int64_t floor_div(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+    }
+
+    static int64_t ceil_div(int64_t a, int64_t b) { return -floor_div(-a, b); }
+
+    size_t slot(int64_t bucket) const {
+        int64_t m = bucket % static_cast<int64_t>(cap_);
+        return static_cast<size_t>(m < 0 ? m + static_cast<int64_t>(cap_) : m);
+    }
+
+    // True if `bucket` has been written (it has a trade, or is the head)
+    bool live(int64_t bucket) const { return bucket_[slot(bucket)] == bucket; }
+
+    void open_bucket(size_t i, int64_t bucket, uint64_t carry) {
+        bucket_[i] = bucket;
+        carry_[i] = carry;
+        open_[i] = high_[i] = low_[i] = close_[i] = carry;
+        volume_[i] = 0;
+        trades_[i] = 0;
+    }
+
+    // Price of the empty bucket `bucket` (< head_): the close carried into
+    // the next written bucket. The head is always written, so this ends.
+    uint64_t carry_before(int64_t bucket) const {
+        int64_t b = bucket + 1;
+        while (!live(b)) b++;
+        return carry_[slot(b)];
+    }
+
+    OhlcvBar live_bar(size_t i) const {
+        return OhlcvBar{bucket_[i] * res_, open_[i], high_[i], low_[i], close_[i], volume_[i], trades_[i]};
+    }
+
+    OhlcvBar flat_bar(int64_t bucket, uint64_t price) const {
+        return OhlcvBar{bucket * res_, price, price, price, price, 0, 0};
+    }
+
+    OhlcvBar bar(int64_t bucket) const {
+        return live(bucket) ? live_bar(slot(bucket)) : flat_bar(bucket, carry_before(bucket));
+    }
+};
+
+// ============================================================================
+// OhlcvAggregator
+// ============================================================================
+
+/**
+ * Per-pool candle series at a fixed set of resolutions.
+ */
+class OhlcvAggregator {
+public:
+    /**
+     * @param resolutions Bucket sizes in seconds (e.g. {60, 3600, 86400})
+     * @param capacity    Candles kept per pool and resolution
+     */
+    OhlcvAggregator(std::vector<int64_t> resolutions, size_t capacity)
+        : resolutions_(std::move(resolutions)), capacity_(capacity) {}
+
+    const std::vector<int64_t>& resolutions() const { return resolutions_; }
+    size_t pool_count() const { return pools_.size(); }
+
+    /**
+     * Add a trade for a pool, updating every resolution.
+     */
+    void on_trade(const Pubkey& pool, const Trade& t) {
+        auto [idx, inserted] = index_.try_emplace(pool, pools_.size());
+        if (inserted) {
+            pools_.emplace_back();
+            auto& series = pools_.back();
+            series.reserve(resolutions_.size());
+            for (int64_t r : resolutions_) series.emplace_back(r, capacity_);
+        }
+        for (auto& s : pools_[*idx]) s.update(t);
+    }
+
+    /**
+     * Add an inferred event; non-swap events are ignored.
+     */
+    void on_event(const Pubkey& pool, const InferredEvent& e, int64_t timestamp) {
+        if (auto t = trade_from_event(e, timestamp)) on_trade(pool, *t);
+    }
+
+    /**
+     * Series for a pool at one of the configured resolutions.
+     */
+    const CandleSeries* series(const Pubkey& pool, int64_t resolution_secs) const {
+        const size_t* idx = index_.find(pool);
+        if (!idx) return nullptr;
+        for (size_t i = 0; i < resolutions_.size(); i++) {
+            if (resolutions_[i] == resolution_secs) return &pools_[*idx][i];
+        }
+        return nullptr;
+    }
+
+private:
+    std::vector<int64_t> resolutions_;
+    size_t capacity_;
+    PubkeyMap<size_t> index_;
+    std::vector<std::vector<CandleSeries>> pools_;
+};
+
+}  // namespace aex402
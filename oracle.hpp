@@ -0,0 +1,423 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Multi-pool Price Oracle
+ *
+ * Aggregates per-pool TWAP results (gettwap) and spot prices into one
+ * reference price per mint, quoted in a numeraire mint (e.g. USDC), and
+ * keeps it current as individual pools update.
+ *
+ * Prices follow the candle convention: a pool's price is token1 per token0
+ * in raw units. Each pool yields up to two observations for each of its
+ * mints, its TWAP and its spot rate (the marginal rate on the invariant).
+ * Converting them to the numeraire:
+ * - the pool pairs the mint with the numeraire: used as is
+ * - the pool pairs it with another mint C: multiplied by C's direct price
+ *   (from C's numeraire pools only, so prices never chain further)
+ *
+ * Weighting and rejection:
+ * - weight = depth * confidence. Depth is the pool's TVL in units of the
+ *   mint. Confidence is the TWAP confidence (0-1) or `spot_confidence`, times
+ *   the confidence of the cross price used to convert it.
+ * - Outliers: log prices further than mad_k * 1.4826 * MAD from the
+ *   weighted median (band floored at min_band) are dropped; the price is
+ *   the weighted geometric mean of the rest. The median is weighted so
+ *   thin pools cannot move it; the MAD is not, so one deep pool does not
+ *   collapse the band for the others.
+ * - Result confidence: depth-weighted mean confidence of the kept
+ *   observations times the fraction of total weight kept.
+ *
+ * update() stores a pool's observation and marks the mints it affects as
+ * stale; price() recomputes a stale mint from its own pools only, so a
+ * query costs O(pools containing the mint) instead of a pass over all
+ * pools.
+ *
+ * Usage:
+ *   oracle::PriceOracle oracle(usdc_mint);
+ *   for (const auto& acc : updates) oracle.update(acc.pubkey, view, now, twap_of(acc.pubkey));
+ *   if (auto p = oracle.price(pyusd_mint); p && p->confidence > 0.5) use(p->price);
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+#include "types.hpp"
+#include "constants.hpp"
+#include "accounts.hpp"
+#include "math.hpp"
+#include "pubkey_map.hpp"
+
+namespace aex402 {
+namespace oracle {
+
+// ============================================================================
+// Inputs and Results
+// ============================================================================
+
+/**
+ * Latest state of one pool as seen by the oracle.
+ * `spot` and `twap.price` are token1 per token0; 0 means not available.
+ */
+struct PoolQuote {
+    Pubkey     pool = {};
+    Pubkey     mint0 = {};
+    Pubkey     mint1 = {};
+    uint64_t   bal0 = 0;
+    uint64_t   bal1 = 0;
+    double     spot = 0;
+    TwapResult twap = {};
+};
+
+struct OracleConfig {
+    double   spot_confidence = 0.5;   // Confidence given to a spot observation
+    uint16_t min_twap_samples = 4;    // TWAPs over fewer candles are ignored
+    uint16_t min_twap_confidence = 0; // TWAPs below this (0-10000) are ignored
+    double   mad_k = 3.0;             // Rejection threshold in robust std devs
+    double   min_band = 1e-3;         // Log-price band never rejected (~10 bps)
+};
+
+/** Aggregated price of one mint. */
+struct OraclePrice {
+    double   price = 0;        // Numeraire units per mint unit (raw amounts)
+    double   confidence = 0;   // 0-1
+    double   dispersion = 0;   // Weighted std dev of kept log prices
+    double   depth = 0;        // TVL of contributing pools, in mint units
+    uint32_t used = 0;         // Observations kept
+    uint32_t rejected = 0;     // Observations dropped as outliers
+};
+
+/**
+ * Marginal price of token0 in token1 on the pool invariant (fees excluded),
+ * or 0 if either balance is empty or D does not converge.
+ */
+inline double spot_price(uint64_t bal0, uint64_t bal1, uint64_t amp) {
+    if (bal0 == 0 || bal1 == 0) return 0;
+    auto d = math::calc_d(bal0, bal1, amp);
+    if (!d || *d == 0) return 0;
+    const double dd = static_cast<double>(*d);
+    const double x0 = static_cast<double>(bal0);
+    const double x1 = static_cast<double>(bal1);
+    const double ann = static_cast<double>(amp) * 4.0;
+    const double k = dd * (dd / (2.0 * x0)) * (dd / (2.0 * x1));
+    return (ann + k / x0) / (ann + k / x1);
+}
+
+// ============================================================================
+// Aggregation
+// ============================================================================
+
+namespace detail {
+
+struct Observation {
+    double log_price;
+    double depth;
+    double confidence;
+    double weight;
+};
+
+/** Weighted median log price; sorts `obs` by log price. */
+inline double weighted_median(std::vector<Observation>& obs, double total) {
+    std::sort(obs.begin(), obs.end(), [](const Observation& a, const Observation& b) {
+        return a.log_price < b.log_price;
+    });
+    double acc = 0;
+    for (const auto& o : obs) {
+        acc += o.weight;
+        if (acc >= 0.5 * total) return o.log_price;
+    }
+    return obs.back().log_price;
+}
+
+/**
+ * Median absolute deviation from `center`, unweighted: one deep pool that
+ * agrees with itself must not shrink the band to zero for all the others.
+ */
+inline double median_abs_dev(const std::vector<Observation>& obs, double center,
+                             std::vector<double>& dev) {
+    dev.clear();
+    for (const auto& o : obs) dev.push_back(std::fabs(o.log_price - center));
+    auto mid = dev.begin() + static_cast<std::ptrdiff_t>(dev.size() / 2);
+    std::nth_element(dev.begin(), mid, dev.end());
+    return *mid;
+}
+
+/** Combine observations with MAD outlier rejection. */
+inline std::optional<OraclePrice> aggregate(std::vector<Observation>& obs, const OracleConfig& cfg,
+                                            std::vector<double>& dev) {
+    double total = 0;
+    for (const auto& o : obs) total += o.weight;
+    if (obs.empty() || !(total > 0)) return std::nullopt;
+
+    const double median = weighted_median(obs, total);
+    const double mad = median_abs_dev(obs, median, dev);
+    const double band = std::max(cfg.mad_k * 1.4826 * mad, cfg.min_band);
+
+    OraclePrice r;
+    double kept = 0, sum = 0, sum2 = 0, conf = 0;
+    for (const auto& o : obs) {
+        if (std::fabs(o.log_price - median) > band) {
+            r.rejected++;
+            continue;
+        }
+        r.used++;
+        kept += o.weight;
+        sum += o.weight * o.log_price;
+        sum2 += o.weight * o.log_price * o.log_price;
+        r.depth += o.depth;
+        conf += o.depth * o.confidence;
+    }
+    const double mean = sum / kept;
+    r.price = std::exp(mean);
+    r.dispersion = std::sqrt(std::max(0.0, sum2 / kept - mean * mean));
+    r.confidence = r.depth > 0 ? conf / r.depth * (kept / total) : 0;
+    return r;
+}
+
+} // namespace detail
+
+// ============================================================================
+// PriceOracle
+// ============================================================================
+
+/**
+ * Incremental reference prices for every mint seen in pool updates,
+ * quoted in `numeraire`.
+ */
+class PriceOracle {
+public:
+    explicit PriceOracle(const Pubkey& numeraire, OracleConfig cfg = {})
+        : numeraire_(numeraire), cfg_(cfg) {
+        mint_id(numeraire_);
+    }
+
+    const OracleConfig& config() const { return cfg_; }
+    const Pubkey& numeraire() const { return numeraire_; }
+    size_t pools() const { return pool_index_.size(); }
+    size_t mints() const { return mints_.size(); }
+
+    /**
+     * Insert or replace a pool's observation.
+     */
+    void update(const PoolQuote& q) {
+        const uint32_t* found = pool_index_.find(q.pool);
+        if (found) {
+            const Slot& old = slots_[*found];
+            if (!pubkey_eq(mints_[old.mint[0]].mint, q.mint0) ||
+                !pubkey_eq(mints_[old.mint[1]].mint, q.mint1)) {
+                remove(q.pool);
+                found = nullptr;
+            }
+        }
+
+        uint32_t id;
+        if (found) {
+            id = *found;
+        } else {
+            if (free_.empty()) {
+                id = static_cast<uint32_t>(slots_.size());
+                slots_.emplace_back();
+            } else {
+                id = free_.back();
+                free_.pop_back();
+            }
+            pool_index_.insert_or_assign(q.pool, id);
+            Slot& s = slots_[id];
+            s.mint[0] = mint_id(q.mint0);
+            s.mint[1] = mint_id(q.mint1);
+            mints_[s.mint[0]].pools.push_back(id);
+            mints_[s.mint[1]].pools.push_back(id);
+        }
+
+        Slot& s = slots_[id];
+        s.quote = q;
+        s.live = true;
+        touch(s);
+    }
+
+    /**
+     * Update from a Pool account at `now`, with the pool's latest TWAP if
+     * known. A paused pool is removed until it reports unpaused.
+     */
+    void update(const Pubkey& pool, const PoolView& view, int64_t now,
+                std::optional<TwapResult> twap = std::nullopt) {
+        if (view.is_paused()) {
+            remove(pool);
+            return;
+        }
+        PoolQuote q;
+        q.pool = pool;
+        q.mint0 = view.mint0();
+        q.mint1 = view.mint1();
+        q.bal0 = view.bal0();
+        q.bal1 = view.bal1();
+        q.spot = spot_price(q.bal0, q.bal1, view.get_amp(now));
+        if (twap) q.twap = *twap;
+        update(q);
+    }
+
+    /**
+     * Drop a pool. Returns false if it was not tracked.
+     */
+    bool remove(const Pubkey& pool) {
+        const uint32_t* found = pool_index_.find(pool);
+        if (!found) return false;
+        const uint32_t id = *found;
+        Slot& s = slots_[id];
+        touch(s);
+        for (uint32_t m : s.mint) {
+            auto& list = mints_[m].pools;
+            auto it = std::find(list.begin(), list.end(), id);
+            if (it != list.end()) {
+                *it = list.back();
+                list.pop_back();
+            }
+        }
+        s.live = false;
+        pool_index_.erase(pool);
+        free_.push_back(id);
+        return true;
+    }
+
+    /**
+     * Reference price of `mint` in the numeraire, recomputed only if a pool
+     * it depends on changed. nullopt if no pool prices it.
+     */
+    std::optional<OraclePrice> price(const Pubkey& mint) {
+        const uint32_t* found = mint_index_.find(mint);
+        if (!found) return std::nullopt;
+        if (*found == NUMERAIRE) {
+            OraclePrice one;
+            one.price = 1.0;
+            one.confidence = 1.0;
+            return one;
+        }
+        MintState& m = mints_[*found];
+        if (m.stale) {
+            m.ref = compute(*found, false);
+            m.stale = false;
+        }
+        return m.ref;
+    }
+
+private:
+    static constexpr uint32_t NUMERAIRE = 0;
+
+    struct Slot {
+        PoolQuote quote;
+        uint32_t  mint[2] = {};
+        bool      live = false;
+    };
+
+    struct MintState {
+        Pubkey                     mint = {};
+        std::vector<uint32_t>      pools;
+        std::optional<OraclePrice> direct;   // From numeraire pools only
+        std::optional<OraclePrice> ref;      // From all pools
+        bool direct_stale = true;
+        bool stale = true;
+    };
+
+    uint32_t mint_id(const Pubkey& mint) {
+        auto [id, inserted] = mint_index_.try_emplace(mint, static_cast<uint32_t>(mints_.size()));
+        if (inserted) {
+            mints_.emplace_back();
+            mints_.back().mint = mint;
+        }
+        return *id;
+    }
+
+    /**
+     * Mark what a change to `s` invalidates: both mints, and for a numeraire
+     * pool also every mint converted through the other mint's direct price.
+     */
+    void touch(const Slot& s) {
+        for (uint32_t m : s.mint) mints_[m].stale = true;
+        for (int side = 0; side < 2; side++) {
+            if (s.mint[1 - side] != NUMERAIRE || s.mint[side] == NUMERAIRE) continue;
+            MintState& x = mints_[s.mint[side]];
+            x.direct_stale = true;
+            for (uint32_t p : x.pools) {
+                const Slot& o = slots_[p];
+                mints_[o.mint[o.mint[0] == s.mint[side] ? 1 : 0]].stale = true;
+            }
+        }
+    }
+
+    const std::optional<OraclePrice>& direct(uint32_t m) {
+        MintState& x = mints_[m];
+        if (x.direct_stale) {
+            x.direct = compute(m, true);
+            x.direct_stale = false;
+        }
+        return x.direct;
+    }
+
+    /** Observations of mint `m` from its pools, then aggregate. */
+    std::optional<OraclePrice> compute(uint32_t m, bool direct_only) {
+        // Direct prices of other mints are computed from inside this loop,
+        // so each pass has its own buffer
+        std::vector<detail::Observation>& obs = scratch_[direct_only ? 1 : 0];
+        obs.clear();
+        for (size_t i = 0; i < mints_[m].pools.size(); i++) {
+            const Slot& s = slots_[mints_[m].pools[i]];
+            const int side = s.mint[0] == m ? 0 : 1;
+            const uint32_t other = s.mint[1 - side];
+            if (other == m) continue;
+
+            double factor = 1.0, factor_conf = 1.0;
+            if (other != NUMERAIRE) {
+                if (direct_only) continue;
+                const auto& c = direct(other);
+                if (!c || !(c->price > 0)) continue;
+                factor = c->price;
+                factor_conf = c->confidence;
+            }
+            add_observations(obs, s.quote, side, factor, factor_conf);
+        }
+        return detail::aggregate(obs, cfg_, dev_);
+    }
+
+    /**
+     * Observations of the mint on `side` of pool `q`, in numeraire units via
+     * `factor` (numeraire per unit of the other mint).
+     */
+    void add_observations(std::vector<detail::Observation>& obs, const PoolQuote& q, int side,
+                          double factor, double factor_conf) {
+        const double twap = q.twap.price > 0 &&
+                            q.twap.samples >= cfg_.min_twap_samples &&
+                            q.twap.confidence >= cfg_.min_twap_confidence
+                          ? q.twap.price_f64() : 0.0;
+        const double ref = q.spot > 0 ? q.spot : twap;
+        if (!(ref > 0)) return;
+
+        // Pool TVL in units of this mint, valued at the pool's own rate
+        const double bal_self = static_cast<double>(side == 0 ? q.bal0 : q.bal1);
+        const double bal_other = static_cast<double>(side == 0 ? q.bal1 : q.bal0);
+        const double depth = side == 0 ? bal_self + bal_other / ref : bal_self + bal_other * ref;
+        if (!(depth > 0)) return;
+
+        auto push = [&](double pool_price, double conf) {
+            const double p = (side == 0 ? pool_price : 1.0 / pool_price) * factor;
+            const double c = conf * factor_conf;
+            if (!(p > 0) || !std::isfinite(p) || !(c > 0)) return;
+            obs.push_back({std::log(p), depth, c, depth * c});
+        };
+        if (q.spot > 0) push(q.spot, cfg_.spot_confidence);
+        if (twap > 0) push(twap, q.twap.confidence / 10000.0);
+    }
+
+    Pubkey numeraire_;
+    OracleConfig cfg_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_;
+    std::vector<MintState> mints_;
+    PubkeyMap<uint32_t> pool_index_;
+    PubkeyMap<uint32_t> mint_index_;
+    std::vector<detail::Observation> scratch_[2];
+    std::vector<double> dev_;
+};
+
+} // namespace oracle
+} // namespace aex402
@@ -16,6 +16,7 @@
 #include <cstring>
 #include "types.hpp"
 #include "constants.hpp"
+#include "trace.hpp"
 
 namespace aex402 {
 namespace pda {
@@ -91,6 +92,7 @@ constexpr const char* GLOBAL_VPOOL_SEED = "global_vpool";
  * Seeds: ["pool", mint0(32), mint1(32)]
  */
 inline Seeds pool_seeds(const Pubkey& mint0, const Pubkey& mint1) {
+    AEX402_TRACE_SCOPE("pda.pool_seeds");
     Seeds s;
     s.add(POOL_SEED);
     s.add(mint0);
@@ -103,6 +105,7 @@ inline Seeds pool_seeds(const Pubkey& mint0, const Pubkey& mint1) {
  * Seeds: ["pool", mint0(32), mint1(32), bump(1)]
  */
 inline Seeds pool_seeds_with_bump(const Pubkey& mint0, const Pubkey& mint1, uint8_t bump) {
+    AEX402_TRACE_SCOPE("pda.pool_seeds_with_bump");
     Seeds s = pool_seeds(mint0, mint1);
     s.add(bump);
     return s;
@@ -113,6 +116,7 @@ inline Seeds pool_seeds_with_bump(const Pubkey& mint0, const Pubkey& mint1, uint
  * Seeds: ["farm", pool(32)]
  */
 inline Seeds farm_seeds(const Pubkey& pool) {
+    AEX402_TRACE_SCOPE("pda.farm_seeds");
     Seeds s;
     s.add(FARM_SEED);
     s.add(pool);
@@ -124,6 +128,7 @@ inline Seeds farm_seeds(const Pubkey& pool) {
  * Seeds: ["user_farm", farm(32), user(32)]
  */
 inline Seeds user_farm_seeds(const Pubkey& farm, const Pubkey& user) {
+    AEX402_TRACE_SCOPE("pda.user_farm_seeds");
     Seeds s;
     s.add(USER_FARM_SEED);
     s.add(farm);
@@ -136,6 +141,7 @@ inline Seeds user_farm_seeds(const Pubkey& farm, const Pubkey& user) {
  * Seeds: ["lottery", pool(32)]
  */
 inline Seeds lottery_seeds(const Pubkey& pool) {
+    AEX402_TRACE_SCOPE("pda.lottery_seeds");
     Seeds s;
     s.add(LOTTERY_SEED);
     s.add(pool);
@@ -147,6 +153,7 @@ inline Seeds lottery_seeds(const Pubkey& pool) {
  * Seeds: ["lottery_entry", lottery(32), user(32)]
  */
 inline Seeds lottery_entry_seeds(const Pubkey& lottery, const Pubkey& user) {
+    AEX402_TRACE_SCOPE("pda.lottery_entry_seeds");
     Seeds s;
     s.add(LOTTERY_ENTRY_SEED);
     s.add(lottery);
@@ -159,6 +166,7 @@ inline Seeds lottery_entry_seeds(const Pubkey& lottery, const Pubkey& user) {
  * Seeds: ["registry"]
  */
 inline Seeds registry_seeds() {
+    AEX402_TRACE_SCOPE("pda.registry_seeds");
     Seeds s;
     s.add(REGISTRY_SEED);
     return s;
@@ -169,6 +177,7 @@ inline Seeds registry_seeds() {
  * Seeds: ["vault", pool(32), mint(32)]
  */
 inline Seeds vault_seeds(const Pubkey& pool, const Pubkey& mint) {
+    AEX402_TRACE_SCOPE("pda.vault_seeds");
     Seeds s;
     s.add(VAULT_SEED);
     s.add(pool);
@@ -181,6 +190,7 @@ inline Seeds vault_seeds(const Pubkey& pool, const Pubkey& mint) {
  * Seeds: ["lp_mint", pool(32)]
  */
 inline Seeds lp_mint_seeds(const Pubkey& pool) {
+    AEX402_TRACE_SCOPE("pda.lp_mint_seeds");
     Seeds s;
     s.add(LP_MINT_SEED);
     s.add(pool);
@@ -192,6 +202,7 @@ inline Seeds lp_mint_seeds(const Pubkey& pool) {
  * Seeds: ["vpclaim", pool_id(4), wallet(32)]
  */
 inline Seeds vpclaim_seeds(uint32_t pool_id, const Pubkey& wallet) {
+    AEX402_TRACE_SCOPE("pda.vpclaim_seeds");
     Seeds s;
     s.add(VPCLAIM_SEED);
     s.add(pool_id);
@@ -204,6 +215,7 @@ inline Seeds vpclaim_seeds(uint32_t pool_id, const Pubkey& wallet) {
  * Seeds: ["global_vpool"]
  */
 inline Seeds global_vpool_seeds() {
+    AEX402_TRACE_SCOPE("pda.global_vpool_seeds");
     Seeds s;
     s.add(GLOBAL_VPOOL_SEED);
     return s;
@@ -235,7 +247,6 @@ constexpr const char* BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdef
  */
 inline std::string base58_encode(const Pubkey& key) {
     std::vector<uint8_t> digits;
-    digits.push_back(0);
 
     for (uint8_t byte : key) {
         uint32_t carry = byte;
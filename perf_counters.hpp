@@ -0,0 +1,239 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Hardware Performance Counters
+ *
+ * Thin wrapper over Linux perf_event_open for measuring a code region:
+ * cycles, instructions, branch misses, L1d read misses and last-level
+ * cache misses, counted for the calling thread in user space only.
+ *
+ * Counters are opened as one group so they cover the same interval. Any
+ * event the host does not expose (common in VMs and containers, or when
+ * kernel.perf_event_paranoid forbids it) is simply marked unavailable;
+ * if none can be opened, available() is false and samples carry wall
+ * time only. On non-Linux platforms every counter is unavailable.
+ *
+ * Usage:
+ *   perf::PerfCounters pc;
+ *   pc.start();
+ *   run_kernel();
+ *   perf::CounterSample s = pc.stop();
+ *   if (s.has(perf::Counter::Instructions)) printf("IPC %.2f\n", s.ipc());
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <chrono>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aex402 {
+namespace perf {
+
+// ============================================================================
+// Types
+// ============================================================================
+
+enum class Counter : uint8_t {
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    L1dMisses,
+    LlcMisses,
+};
+
+constexpr size_t COUNTER_COUNT = 5;
+
+inline const char* counter_name(Counter c) {
+    switch (c) {
+        case Counter::Cycles:       return "cycles";
+        case Counter::Instructions: return "instructions";
+        case Counter::BranchMisses: return "branch-misses";
+        case Counter::L1dMisses:    return "L1d-misses";
+        case Counter::LlcMisses:    return "LLC-misses";
+    }
+    return "unknown";
+}
+
+/**
+ * Counter values for one measured interval.
+ * Values are scaled up when the kernel multiplexed the group.
+ */
+struct CounterSample {
+    std::array<uint64_t, COUNTER_COUNT> values{};
+    std::array<bool, COUNTER_COUNT> valid{};
+    double wall_ns = 0.0;
+
+    bool has(Counter c) const { return valid[static_cast<size_t>(c)]; }
+    uint64_t get(Counter c) const { return values[static_cast<size_t>(c)]; }
+
+    /**
+     * Instructions per cycle, or 0 when either counter is missing.
+     */
+    double ipc() const {
+        if (!has(Counter::Cycles) || !has(Counter::Instructions) || get(Counter::Cycles) == 0) return 0.0;
+        return static_cast<double>(get(Counter::Instructions)) / static_cast<double>(get(Counter::Cycles));
+    }
+
+    /**
+     * Counter value divided by the number of operations in the interval.
+     */
+    double per_op(Counter c, uint64_t ops) const {
+        return ops ? static_cast<double>(get(c)) / static_cast<double>(ops) : 0.0;
+    }
+};
+
+// ============================================================================
+// PerfCounters
+// ============================================================================
+
+/**
+ * One counter group for the calling thread. Not thread-safe; construct
+ * one per measuring thread.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+#if defined(__linux__)
+        fds_.fill(-1);
+        for (size_t i = 0; i < COUNTER_COUNT; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.disabled = leader_ < 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                               PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            config(static_cast<Counter>(i), attr);
+
+            long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0);
+            if (fd < 0) {
+                if (error_.empty()) error_ = std::strerror(errno);
+                continue;
+            }
+            fds_[i] = static_cast<int>(fd);
+            if (leader_ < 0) leader_ = fds_[i];
+            uint64_t id = 0;
+            if (::ioctl(fds_[i], PERF_EVENT_IOC_ID, &id) == 0) ids_[i] = id;
+        }
+        if (leader_ >= 0) error_.clear();
+#else
+        error_ = "perf_event_open is Linux-only";
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * True if at least one hardware counter could be opened.
+     */
+    bool available() const { return leader_ >= 0; }
+
+    bool has(Counter c) const {
+#if defined(__linux__)
+        return fds_[static_cast<size_t>(c)] >= 0;
+#else
+        (void)c;
+        return false;
+#endif
+    }
+
+    /**
+     * Why no counter could be opened (empty when available()).
+     */
+    const std::string& error() const { return error_; }
+
+    void start() {
+#if defined(__linux__)
+        if (leader_ >= 0) {
+            ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    CounterSample stop() {
+        auto end = std::chrono::steady_clock::now();
+        CounterSample s;
+        s.wall_ns = std::chrono::duration<double, std::nano>(end - start_).count();
+#if defined(__linux__)
+        if (leader_ < 0) return s;
+        ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // { nr, time_enabled, time_running, { value, id }[nr] }
+        uint64_t buf[3 + 2 * COUNTER_COUNT] = {};
+        if (::read(leader_, buf, sizeof(buf)) < static_cast<ssize_t>(3 * sizeof(uint64_t))) return s;
+        uint64_t nr = buf[0];
+        double scale = buf[2] > 0 ? static_cast<double>(buf[1]) / static_cast<double>(buf[2]) : 0.0;
+        for (uint64_t k = 0; k < nr && k < COUNTER_COUNT; k++) {
+            uint64_t value = buf[3 + 2 * k];
+            uint64_t id = buf[4 + 2 * k];
+            for (size_t i = 0; i < COUNTER_COUNT; i++) {
+                if (fds_[i] >= 0 && ids_[i] == id) {
+                    s.values[i] = static_cast<uint64_t>(static_cast<double>(value) * scale);
+                    s.valid[i] = buf[2] > 0;
+                }
+            }
+        }
+#endif
+        return s;
+    }
+
+private:
+    int leader_ = -1;
+    std::string error_;
+    std::chrono::steady_clock::time_point start_{};
+#if defined(__linux__)
+    std::array<int, COUNTER_COUNT> fds_{};
+    std::array<uint64_t, COUNTER_COUNT> ids_{};
+
+    static void config(Counter c, perf_event_attr& attr) {
+        switch (c) {
+            case Counter::Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Counter::Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case Counter::BranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case Counter::L1dMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case Counter::LlcMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+        }
+    }
+#endif
+};
+
+}  // namespace perf
+}  // namespace aex402
@@ -0,0 +1,286 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Pubkey Hash Containers
+ *
+ * Open-addressing flat hash map and set keyed by 32-byte Pubkeys.
+ *
+ * Layout:
+ * - One control byte per slot (0 = empty, 0x80 | 7-bit fingerprint = full)
+ * - Keys and values in parallel arrays
+ *
+ * Probing is linear over the control bytes, so a miss touches a single
+ * cache line in the common case and full key compares only happen on a
+ * fingerprint match. Erase uses backward-shift deletion (no tombstones).
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+
+namespace aex402 {
+
+namespace detail {
+
+// Empty value type used by PubkeySet
+struct Unit {};
+
+inline void prefetch_read(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#else
+    (void)p;
+#endif
+}
+
+}  // namespace detail
+
+// ============================================================================
+// PubkeyMap
+// ============================================================================
+
+/**
+ * Flat hash map from Pubkey to V.
+ * V must be default-constructible and movable.
+ */
+template <typename V>
+class PubkeyMap {
+public:
+    PubkeyMap() = default;
+
+    explicit PubkeyMap(size_t expected) { reserve(expected); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return ctrl_.size(); }
+
+    void clear() {
+        std::fill(ctrl_.begin(), ctrl_.end(), static_cast<uint8_t>(0));
+        for (auto& v : values_) v = V{};
+        size_ = 0;
+    }
+
+    /**
+     * Ensure capacity for at least `expected` entries without rehashing.
+     */
+    void reserve(size_t expected) {
+        size_t cap = 16;
+        while (cap * 7 / 8 < expected) cap *= 2;
+        if (cap > ctrl_.size()) rehash(cap);
+    }
+
+    /**
+     * Find value for key. Returns nullptr if not present.
+     */
+    V* find(const Pubkey& key) {
+        size_t idx = find_index(key);
+        return idx == NPOS ? nullptr : &values_[idx];
+    }
+
+    const V* find(const Pubkey& key) const {
+        size_t idx = find_index(key);
+        return idx == NPOS ? nullptr : &values_[idx];
+    }
+
+    bool contains(const Pubkey& key) const { return find_index(key) != NPOS; }
+
+    /**
+     * Insert key with value if absent.
+     * Returns pointer to the stored value and whether an insert happened.
+     */
+    std::pair<V*, bool> try_emplace(const Pubkey& key, V value = V{}) {
+        grow_if_needed();
+        size_t h = PubkeyHash{}(key);
+        uint8_t tag = fingerprint(h);
+        size_t idx = h & mask_;
+
+        while (ctrl_[idx] != 0) {
+            if (ctrl_[idx] == tag && pubkey_eq(keys_[idx], key)) {
+                return {&values_[idx], false};
+            }
+            idx = (idx + 1) & mask_;
+        }
+
+        ctrl_[idx] = tag;
+        keys_[idx] = key;
+        values_[idx] = std::move(value);
+        size_++;
+        return {&values_[idx], true};
+    }
+
+    /**
+     * Insert or overwrite. Returns true if the key was newly inserted.
+     */
+    bool insert_or_assign(const Pubkey& key, V value) {
+        auto [slot, inserted] = try_emplace(key);
+        *slot = std::move(value);
+        return inserted;
+    }
+
+    V& operator[](const Pubkey& key) { return *try_emplace(key).first; }
+
+    /**
+     * Remove key. Returns true if it was present.
+     */
+    bool erase(const Pubkey& key) {
+        size_t idx = find_index(key);
+        if (idx == NPOS) return false;
+
+        // Backward-shift: pull later entries of the probe run into the hole
+        size_t hole = idx;
+        size_t next = (hole + 1) & mask_;
+        while (ctrl_[next] != 0) {
+            size_t home = PubkeyHash{}(keys_[next]) & mask_;
+            // Entry can move if its home is not in (hole, next]
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                ctrl_[hole] = ctrl_[next];
+                keys_[hole] = keys_[next];
+                values_[hole] = std::move(values_[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+
+        ctrl_[hole] = 0;
+        values_[hole] = V{};
+        size_--;
+        return true;
+    }
+
+    /**
+     * Prefetch the home slot of key (issue ahead of a later find).
+     */
+    void prefetch(const Pubkey& key) const {
+        if (ctrl_.empty()) return;
+        size_t idx = PubkeyHash{}(key) & mask_;
+        detail::prefetch_read(&ctrl_[idx]);
+        detail::prefetch_read(&keys_[idx]);
+    }
+
+    /**
+     * Look up many keys, prefetching `distance` lookups ahead.
+     * out[i] receives the value pointer for keys[i] or nullptr.
+     */
+    void find_batch(const Pubkey* keys, size_t n, V** out, size_t distance = 8) {
+        for (size_t i = 0; i < n && i < distance; i++) prefetch(keys[i]);
+        for (size_t i = 0; i < n; i++) {
+            if (i + distance < n) prefetch(keys[i + distance]);
+            out[i] = find(keys[i]);
+        }
+    }
+
+    /**
+     * Visit every entry as f(const Pubkey&, V&).
+     */
+    template <typename F>
+    void for_each(F&& f) {
+        for (size_t i = 0; i < ctrl_.size(); i++) {
+            if (ctrl_[i] != 0) f(keys_[i], values_[i]);
+        }
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        for (size_t i = 0; i < ctrl_.size(); i++) {
+            if (ctrl_[i] != 0) f(keys_[i], values_[i]);
+        }
+    }
+
+private:
+    static constexpr size_t NPOS = ~static_cast<size_t>(0);
+
+    std::vector<uint8_t> ctrl_;
+    std::vector<Pubkey> keys_;
+    std::vector<V> values_;
+    size_t size_ = 0;
+    size_t mask_ = 0;
+
+    static uint8_t fingerprint(size_t h) {
+        return static_cast<uint8_t>(0x80 | (static_cast<uint64_t>(h) >> 57));
+    }
+
+    size_t find_index(const Pubkey& key) const {
+        if (size_ == 0) return NPOS;
+
+        size_t h = PubkeyHash{}(key);
+        uint8_t tag = fingerprint(h);
+        size_t idx = h & mask_;
+
+        while (ctrl_[idx] != 0) {
+            if (ctrl_[idx] == tag && pubkey_eq(keys_[idx], key)) return idx;
+            idx = (idx + 1) & mask_;
+        }
+        return NPOS;
+    }
+
+    void grow_if_needed() {
+        // Max load factor 7/8
+        if (ctrl_.empty() || (size_ + 1) * 8 > ctrl_.size() * 7) {
+            rehash(ctrl_.empty() ? 16 : ctrl_.size() * 2);
+        }
+    }
+
+    void rehash(size_t new_cap) {
+        std::vector<uint8_t> old_ctrl = std::move(ctrl_);
+        std::vector<Pubkey> old_keys = std::move(keys_);
+        std::vector<V> old_values = std::move(values_);
+
+        ctrl_.assign(new_cap, 0);
+        keys_.assign(new_cap, Pubkey{});
+        values_.clear();
+        values_.resize(new_cap);
+        mask_ = new_cap - 1;
+
+        for (size_t i = 0; i < old_ctrl.size(); i++) {
+            if (old_ctrl[i] == 0) continue;
+            size_t idx = PubkeyHash{}(old_keys[i]) & mask_;
+            while (ctrl_[idx] != 0) idx = (idx + 1) & mask_;
+            ctrl_[idx] = old_ctrl[i];
+            keys_[idx] = old_keys[i];
+            values_[idx] = std::move(old_values[i]);
+        }
+    }
+};
+
+// ============================================================================
+// PubkeySet
+// ============================================================================
+
+/**
+ * Flat hash set of Pubkeys.
+ */
+class PubkeySet {
+public:
+    PubkeySet() = default;
+
+    explicit PubkeySet(size_t expected) : map_(expected) {}
+
+    size_t size() const { return map_.size(); }
+    bool empty() const { return map_.empty(); }
+    void clear() { map_.clear(); }
+    void reserve(size_t expected) { map_.reserve(expected); }
+
+    /**
+     * Insert key. Returns true if it was not already present.
+     */
+    bool insert(const Pubkey& key) { return map_.try_emplace(key).second; }
+
+    bool contains(const Pubkey& key) const { return map_.contains(key); }
+    bool erase(const Pubkey& key) { return map_.erase(key); }
+    void prefetch(const Pubkey& key) const { map_.prefetch(key); }
+
+    /**
+     * Visit every key as f(const Pubkey&).
+     */
+    template <typename F>
+    void for_each(F&& f) const {
+        map_.for_each([&](const Pubkey& k, const detail::Unit&) { f(k); });
+    }
+
+private:
+    PubkeyMap<detail::Unit> map_;
+};
+
+}  // namespace aex402
@@ -0,0 +1,347 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Quote Cache
+ *
+ * Deduplicates repeated swap quotes against the same pool state. Entries
+ * are keyed by (pool index, direction, size bucket) and tagged with a
+ * caller-supplied state version (a slot number, or a counter bumped
+ * whenever the pool's balances/amp/fee change); an entry whose version
+ * differs from the caller's is a miss, so no explicit invalidation pass
+ * is needed when a pool updates.
+ *
+ * Each entry holds:
+ * - the last exact quote seen in its bucket (returned only for the same
+ *   amount), and
+ * - exact quotes at the bucket's lower and upper bounds, from which any
+ *   amount inside the bucket can be interpolated in O(1).
+ *
+ * Size buckets are log-linear: QUOTE_SUB_BITS mantissa bits per power of
+ * two, so a bucket spans at most 1/8 of its lower bound. StableSwap output
+ * is concave in the input amount, so the chord between the two bounds
+ * lies at or below the curve. Integer rounding can still put the chord one
+ * unit above an exact quote, so interpolation rounds one unit further down
+ * inside a bucket and interpolated quotes err low.
+ *
+ * The table is direct-mapped with a fixed power-of-two capacity; a
+ * colliding insert overwrites. Reads are lock-free (per-entry seqlock,
+ * retried on a torn read); concurrent writers to one entry do not block
+ * each other, the loser simply skips its insert.
+ *
+ * Usage:
+ *   QuoteCache cache(1 << 16);
+ *   auto out = cache.quote(pool_idx, 0, amount, slot, bal0, bal1, amp, fee_bps);
+ *   auto approx = cache.quote_interpolated(pool_idx, 0, amount, slot, bal0, bal1, amp, fee_bps);
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include "math.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Size Buckets
+// ============================================================================
+
+constexpr uint32_t QUOTE_SUB_BITS = 3;
+constexpr uint32_t QUOTE_BUCKETS = (64 - QUOTE_SUB_BITS + 1) << QUOTE_SUB_BITS;
+
+/**
+ * Log-linear bucket of an amount. Amounts below 2^QUOTE_SUB_BITS get a
+ * bucket each.
+ */
+inline uint32_t quote_bucket(uint64_t amount) {
+    constexpr uint64_t sub = uint64_t(1) << QUOTE_SUB_BITS;
+    if (amount < sub) return static_cast<uint32_t>(amount);
+    uint32_t msb = 63u - static_cast<uint32_t>(__builtin_clzll(amount));
+    uint32_t shift = msb - QUOTE_SUB_BITS;
+    return ((shift + 1) << QUOTE_SUB_BITS) | static_cast<uint32_t>((amount >> shift) & (sub - 1));
+}
+
+inline uint64_t quote_bucket_lower(uint32_t bucket) {
+    constexpr uint32_t sub = 1u << QUOTE_SUB_BITS;
+    if (bucket < sub) return bucket;
+    uint32_t shift = (bucket >> QUOTE_SUB_BITS) - 1;
+    return static_cast<uint64_t>((bucket & (sub - 1)) | sub) << shift;
+}
+
+inline uint64_t quote_bucket_upper(uint32_t bucket) {
+    constexpr uint32_t sub = 1u << QUOTE_SUB_BITS;
+    if (bucket < sub) return bucket;
+    uint32_t shift = (bucket >> QUOTE_SUB_BITS) - 1;
+    uint64_t mant = ((bucket & (sub - 1)) | sub) + 1;
+    return (mant << shift) - 1;  // Wraps to UINT64_MAX for the top bucket
+}
+
+// ============================================================================
+// Quote Cache
+// ============================================================================
+
+struct QuoteCacheStats {
+    uint64_t exact_hits;
+    uint64_t interpolated_hits;
+    uint64_t misses;
+
+    double hit_rate() const {
+        uint64_t total = exact_hits + interpolated_hits + misses;
+        return total ? static_cast<double>(exact_hits + interpolated_hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+class QuoteCache {
+public:
+    /**
+     * capacity is rounded up to a power of two (minimum 64 entries).
+     */
+    explicit QuoteCache(size_t capacity = size_t(1) << 16) {
+        size_t cap = 64;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        entries_.reset(new Entry[cap]);
+    }
+
+    QuoteCache(const QuoteCache&) = delete;
+    QuoteCache& operator=(const QuoteCache&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // ------------------------------------------------------------------------
+    // Raw lookups and inserts
+    // ------------------------------------------------------------------------
+
+    /**
+     * Exact quote previously stored for this amount at this version.
+     */
+    std::optional<uint64_t> find(uint32_t pool, uint8_t direction, uint64_t amount, uint64_t version) const {
+        Snapshot s;
+        if (!load(pool, direction, quote_bucket(amount), version, s)) return std::nullopt;
+        if (!(s.flags & HAS_EXACT) || s.amount != amount) return std::nullopt;
+        return s.out;
+    }
+
+    /**
+     * Quote interpolated between the stored bucket bounds.
+     */
+    std::optional<uint64_t> find_interpolated(uint32_t pool, uint8_t direction, uint64_t amount,
+                                              uint64_t version) const {
+        uint32_t bucket = quote_bucket(amount);
+        Snapshot s;
+        if (!load(pool, direction, bucket, version, s)) return std::nullopt;
+        if ((s.flags & HAS_EXACT) && s.amount == amount) return s.out;
+        if (!(s.flags & HAS_BOUNDS)) return std::nullopt;
+        return interpolate(bucket, amount, s.lo_out, s.hi_out);
+    }
+
+    /**
+     * Store an exact quote, keeping the entry's bounds if still current.
+     */
+    void insert(uint32_t pool, uint8_t direction, uint64_t amount, uint64_t version, uint64_t out) {
+        store(pool, direction, quote_bucket(amount), version, [&](Snapshot& s) {
+            s.flags |= HAS_EXACT;
+            s.amount = amount;
+            s.out = out;
+        });
+    }
+
+    /**
+     * Store exact quotes at quote_bucket_lower/upper(bucket).
+     */
+    void insert_bounds(uint32_t pool, uint8_t direction, uint32_t bucket, uint64_t version,
+                       uint64_t lo_out, uint64_t hi_out) {
+        store(pool, direction, bucket, version, [&](Snapshot& s) {
+            s.flags |= HAS_BOUNDS;
+            s.lo_out = lo_out;
+            s.hi_out = hi_out;
+        });
+    }
+
+    // ------------------------------------------------------------------------
+    // Quoting through the cache
+    // ------------------------------------------------------------------------
+
+    /**
+     * Exact two-token quote (math::simulate_swap), computed on a miss.
+     * direction is the caller's convention (e.g. 0 = token0 -> token1);
+     * bal_in/bal_out must already be oriented to match it.
+     */
+    std::optional<uint64_t> quote(uint32_t pool, uint8_t direction, uint64_t amount, uint64_t version,
+                                  uint64_t bal_in, uint64_t bal_out, uint64_t amp, uint64_t fee_bps) {
+        if (auto hit = find(pool, direction, amount, version)) {
+            count(exact_hits_);
+            return hit;
+        }
+        count(misses_);
+        auto out = math::simulate_swap(bal_in, bal_out, amount, amp, fee_bps);
+        if (out) insert(pool, direction, amount, version, *out);
+        return out;
+    }
+
+    /**
+     * Approximate two-token quote. The first request in a bucket computes
+     * both bounds exactly (two simulate_swap calls); later requests in the
+     * same bucket and version are answered by interpolation. Returns the
+     * exact quote when the amount matches a cached one.
+     */
+    std::optional<uint64_t> quote_interpolated(uint32_t pool, uint8_t direction, uint64_t amount,
+                                               uint64_t version, uint64_t bal_in, uint64_t bal_out,
+                                               uint64_t amp, uint64_t fee_bps) {
+        if (auto hit = find_interpolated(pool, direction, amount, version)) {
+            count(interpolated_hits_);
+            return hit;
+        }
+        count(misses_);
+        uint32_t bucket = quote_bucket(amount);
+        uint64_t lo = quote_bucket_lower(bucket);
+        uint64_t hi = quote_bucket_upper(bucket);
+        auto lo_out = lo ? math::simulate_swap(bal_in, bal_out, lo, amp, fee_bps) : std::optional<uint64_t>(0);
+        auto hi_out = math::simulate_swap(bal_in, bal_out, hi, amp, fee_bps);
+        if (lo_out && hi_out) {
+            insert_bounds(pool, direction, bucket, version, *lo_out, *hi_out);
+            return interpolate(bucket, amount, *lo_out, *hi_out);
+        }
+        // Upper bound not quotable (e.g. exceeds the pool); fall back to exact
+        auto out = math::simulate_swap(bal_in, bal_out, amount, amp, fee_bps);
+        if (out) insert(pool, direction, amount, version, *out);
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+    // Maintenance
+    // ------------------------------------------------------------------------
+
+    /**
+     * Drop every entry. Not safe against concurrent inserts.
+     */
+    void clear() {
+        for (size_t i = 0; i <= mask_; i++) {
+            Entry& e = entries_[i];
+            e.seq.store(e.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            store_word(&e.words[W_FLAGS], 0);
+            e.seq.store(e.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        exact_hits_.store(0, std::memory_order_relaxed);
+        interpolated_hits_.store(0, std::memory_order_relaxed);
+        misses_.store(0, std::memory_order_relaxed);
+    }
+
+    QuoteCacheStats stats() const {
+        return {exact_hits_.load(std::memory_order_relaxed),
+                interpolated_hits_.load(std::memory_order_relaxed),
+                misses_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr uint64_t HAS_EXACT = 1;
+    static constexpr uint64_t HAS_BOUNDS = 2;
+
+    // Word indices within an entry
+    enum : size_t { W_KEY, W_VERSION, W_FLAGS, W_AMOUNT, W_OUT, W_LO, W_HI, W_COUNT };
+
+    struct alignas(64) Entry {
+        std::atomic<uint64_t> seq{0};
+        uint64_t words[W_COUNT] = {};
+    };
+    static_assert(sizeof(Entry) == 64, "QuoteCache entry should fill one cache line");
+
+    struct Snapshot {
+        uint64_t flags = 0;
+        uint64_t amount = 0;
+        uint64_t out = 0;
+        uint64_t lo_out = 0;
+        uint64_t hi_out = 0;
+    };
+
+    std::unique_ptr<Entry[]> entries_;
+    size_t mask_ = 0;
+    mutable std::atomic<uint64_t> exact_hits_{0};
+    mutable std::atomic<uint64_t> interpolated_hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+
+    static uint64_t load_word(const uint64_t* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+    static void store_word(uint64_t* p, uint64_t v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+    static void count(std::atomic<uint64_t>& c) { c.fetch_add(1, std::memory_order_relaxed); }
+
+    static uint64_t make_key(uint32_t pool, uint8_t direction, uint32_t bucket) {
+        // +1 so no live key is 0, the value of an empty entry
+        return ((static_cast<uint64_t>(pool) << 24) | (static_cast<uint64_t>(direction) << 16) | bucket) + 1;
+    }
+
+    Entry& entry_for(uint64_t key) const {
+        uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+        return entries_[static_cast<size_t>(h ^ (h >> 29)) & mask_];
+    }
+
+    static uint64_t interpolate(uint32_t bucket, uint64_t amount, uint64_t lo_out, uint64_t hi_out) {
+        uint64_t lo = quote_bucket_lower(bucket);
+        uint64_t hi = quote_bucket_upper(bucket);
+        if (hi <= lo || hi_out <= lo_out) return lo_out;
+        __uint128_t num = static_cast<__uint128_t>(hi_out - lo_out) * (amount - lo);
+        uint64_t step = static_cast<uint64_t>(num / (hi - lo));
+        // Exact quotes are rounded and not concave at the unit level, so the
+        // chord can sit one unit above one inside the bucket; give up that unit
+        if (amount > lo && amount < hi && step > 0) step--;
+        return lo_out + step;
+    }
+
+    bool load(uint32_t pool, uint8_t direction, uint32_t bucket, uint64_t version, Snapshot& out) const {
+        uint64_t key = make_key(pool, direction, bucket);
+        const Entry& e = entry_for(key);
+        uint64_t w[W_COUNT];
+        for (;;) {
+            uint64_t s1 = e.seq.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            for (size_t i = 0; i < W_COUNT; i++) w[i] = load_word(&e.words[i]);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.seq.load(std::memory_order_relaxed) == s1) break;
+        }
+        if (w[W_KEY] != key || w[W_VERSION] != version || w[W_FLAGS] == 0) return false;
+        out.flags = w[W_FLAGS];
+        out.amount = w[W_AMOUNT];
+        out.out = w[W_OUT];
+        out.lo_out = w[W_LO];
+        out.hi_out = w[W_HI];
+        return true;
+    }
+
+    /**
+     * Read-modify-write an entry under its seqlock. An entry holding a
+     * different key or an older version is reset first. If another writer
+     * holds the entry, the update is dropped.
+     */
+    template <typename Fn>
+    void store(uint32_t pool, uint8_t direction, uint32_t bucket, uint64_t version, Fn&& update) {
+        uint64_t key = make_key(pool, direction, bucket);
+        Entry& e = entry_for(key);
+        uint64_t seq = e.seq.load(std::memory_order_relaxed);
+        if ((seq & 1) || !e.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Snapshot s;
+        if (load_word(&e.words[W_KEY]) == key && load_word(&e.words[W_VERSION]) == version) {
+            s.flags = load_word(&e.words[W_FLAGS]);
+            s.amount = load_word(&e.words[W_AMOUNT]);
+            s.out = load_word(&e.words[W_OUT]);
+            s.lo_out = load_word(&e.words[W_LO]);
+            s.hi_out = load_word(&e.words[W_HI]);
+        }
+        update(s);
+        store_word(&e.words[W_KEY], key);
+        store_word(&e.words[W_VERSION], version);
+        store_word(&e.words[W_FLAGS], s.flags);
+        store_word(&e.words[W_AMOUNT], s.amount);
+        store_word(&e.words[W_OUT], s.out);
+        store_word(&e.words[W_LO], s.lo_out);
+        store_word(&e.words[W_HI], s.hi_out);
+
+        e.seq.store(seq + 2, std::memory_order_release);
+    }
+};
+
+}  // namespace aex402
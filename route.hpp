@@ -0,0 +1,446 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Multi-hop Route Quoting
+ *
+ * Predicts the result of a multihop instruction (2-4 hops) hop by hop, with
+ * the same integer math the program runs for each pool:
+ * - D from the hop's input/output balances, then calc_y on the new input
+ *   balance (amp from the ramp schedule at `now`)
+ * - fee = floor(gross * fee_bps / 10000) taken from the output
+ * - admin share = floor(fee * admin_fee_pct / 100) leaves the output balance
+ * Each hop's net output is the next hop's input. A route fails (nullopt)
+ * when a pool is paused, a direction byte is not 0/1, a hop's output mint
+ * is not the next hop's input mint, or any hop yields nothing.
+ *
+ * A pool that appears twice in one route sees its own earlier hop: pass the
+ * same snapshot (same PoolView buffer or Pool object) for both positions
+ * and the second hop runs against the updated balances.
+ *
+ * simulate_routes() quotes many candidate routes over one pool array. Routes
+ * are sorted by (amount_in, pool, direction, ...) so routes sharing a prefix
+ * are adjacent, and the hops of the shared prefix are taken from the
+ * previous route instead of re-run; each pool's D is also computed once per
+ * direction. A router fanning out 2-4 hop paths from one input pool pays
+ * for the first hop once per amount.
+ *
+ * Usage:
+ *   const PoolView path[] = {usdc_usdt, usdt_pyusd};
+ *   const uint8_t dirs[] = {0, 1};
+ *   auto q = route::simulate_multihop(path, dirs, 2, amount_in, now);
+ *   if (q) {
+ *       auto ix = InstructionBuilder::multihop(amount_in,
+ *           math::calc_min_output(q->amount_out(), 50), deadline, {0, 1});
+ *   }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <optional>
+#include <vector>
+#include "types.hpp"
+#include "constants.hpp"
+#include "math.hpp"
+#include "accounts.hpp"
+#include "trace.hpp"
+
+namespace aex402 {
+namespace route {
+
+constexpr size_t MIN_HOPS = 2;
+constexpr size_t MAX_HOPS = 4;
+
+// ============================================================================
+// Quote Types
+// ============================================================================
+
+/** One hop of a route. */
+struct HopQuote {
+    uint64_t amount_in = 0;
+    uint64_t amount_out = 0;     // Net of fee; input to the next hop
+    uint64_t fee = 0;            // Swap fee taken from the gross output
+    uint64_t admin_fee = 0;      // Admin share of `fee`
+};
+
+/** Per-hop result of a multihop route. */
+struct MultihopQuote {
+    uint8_t  hops = 0;
+    HopQuote hop[MAX_HOPS] = {};
+
+    uint64_t amount_in() const { return hop[0].amount_in; }
+    uint64_t amount_out() const { return hops ? hop[hops - 1].amount_out : 0; }
+};
+
+/**
+ * Candidate route over a caller-owned pool array. `pools` are indices into
+ * that array; `directions` are the multihop direction bytes (0 = token0 to
+ * token1, 1 = token1 to token0).
+ */
+struct Route {
+    uint64_t amount_in = 0;
+    uint8_t  hops = 0;
+    uint8_t  directions[MAX_HOPS] = {};
+    uint32_t pools[MAX_HOPS] = {};
+
+    std::vector<uint8_t> direction_bytes() const {
+        return std::vector<uint8_t>(directions, directions + hops);
+    }
+};
+
+/** Work done by simulate_routes(). */
+struct RouteBatchStats {
+    size_t routes = 0;           // Routes submitted
+    size_t quoted = 0;           // Routes with a quote
+    size_t hops = 0;             // Hops across all well-formed routes
+    size_t hops_simulated = 0;   // Hops actually run (rest came from shared prefixes)
+};
+
+// ============================================================================
+// Hop Math
+// ============================================================================
+
+namespace detail {
+
+/** Per-pool parameters a hop needs, loaded once. */
+struct Leg {
+    uint64_t bal[2] = {};
+    uint64_t amp = 0;
+    uint64_t fee_bps = 0;
+    uint64_t admin_fee_pct = 0;
+    Pubkey   mint[2] = {};
+    bool     paused = false;
+};
+
+inline Leg load(const PoolView& p, int64_t now) {
+    Leg l;
+    l.bal[0] = p.bal0();
+    l.bal[1] = p.bal1();
+    l.amp = p.get_amp(now);
+    l.fee_bps = p.fee_bps();
+    l.admin_fee_pct = p.admin_fee_pct();
+    l.mint[0] = p.mint0();
+    l.mint[1] = p.mint1();
+    l.paused = p.is_paused();
+    return l;
+}
+
+inline Leg load(const Pool& p, int64_t now) {
+    Leg l;
+    l.bal[0] = p.bal0;
+    l.bal[1] = p.bal1;
+    l.amp = p.get_amp(now);
+    l.fee_bps = p.fee_bps;
+    l.admin_fee_pct = p.admin_fee_pct;
+    l.mint[0] = p.mint0;
+    l.mint[1] = p.mint1;
+    l.paused = p.paused != 0;
+    return l;
+}
+
+inline bool same_pool(const PoolView& a, const PoolView& b) { return a.data == b.data; }
+inline bool same_pool(const Pool& a, const Pool& b) { return &a == &b; }
+
+inline uint64_t admin_share(uint64_t fee, uint64_t admin_fee_pct) {
+    uint64_t pct = std::min(admin_fee_pct, MAX_ADMIN_FEE_PCT);
+    return math::mul_div(fee, pct, math::PCT_DENOMINATOR);
+}
+
+/**
+ * Run one hop against `bal`. `d` is the invariant for (bal[dir],
+ * bal[1 - dir]) in that argument order, or 0 to compute it here; the
+ * result matches math::simulate_swap except that a zero output fails.
+ */
+inline std::optional<HopQuote> hop(const Leg& leg, const uint64_t bal[2], uint8_t dir,
+                                   uint64_t amount_in, uint64_t d) {
+    const uint64_t bal_in = bal[dir];
+    const uint64_t bal_out = bal[1 - dir];
+    if (d == 0) {
+        auto dd = math::calc_d(bal_in, bal_out, leg.amp);
+        if (!dd) return std::nullopt;
+        d = *dd;
+    }
+    if (amount_in > UINT64_MAX - bal_in) return std::nullopt;
+    auto new_bal_out = math::calc_y(bal_in + amount_in, d, leg.amp);
+    if (!new_bal_out || *new_bal_out >= bal_out) return std::nullopt;
+
+    HopQuote q;
+    const uint64_t gross = bal_out - *new_bal_out;
+    q.amount_in = amount_in;
+    q.fee = math::calc_fee(gross, leg.fee_bps);
+    q.amount_out = gross - q.fee;
+    q.admin_fee = admin_share(q.fee, leg.admin_fee_pct);
+    if (q.amount_out == 0) return std::nullopt;
+    return q;
+}
+
+/** Pool balances after `q` ran in direction `dir`. */
+inline void apply(uint64_t bal[2], uint8_t dir, const HopQuote& q) {
+    bal[dir] += q.amount_in;
+    bal[1 - dir] -= q.amount_out + q.admin_fee;
+}
+
+template <typename P>
+std::optional<MultihopQuote> simulate_multihop(const P* pools, const uint8_t* directions,
+                                               size_t hops, uint64_t amount_in, int64_t now) {
+    if (hops < MIN_HOPS || hops > MAX_HOPS) return std::nullopt;
+
+    Leg legs[MAX_HOPS];
+    uint64_t bal[MAX_HOPS][2];
+    MultihopQuote out;
+    out.hops = static_cast<uint8_t>(hops);
+    uint64_t amount = amount_in;
+
+    for (size_t k = 0; k < hops; k++) {
+        const uint8_t dir = directions[k];
+        if (dir > 1) return std::nullopt;
+
+        // Latest state of this pool if an earlier hop already touched it
+        size_t prev = k;
+        for (size_t j = 0; j < k; j++) {
+            if (same_pool(pools[j], pools[k])) prev = j;
+        }
+        if (prev == k) {
+            legs[k] = load(pools[k], now);
+            bal[k][0] = legs[k].bal[0];
+            bal[k][1] = legs[k].bal[1];
+        } else {
+            legs[k] = legs[prev];
+            bal[k][0] = bal[prev][0];
+            bal[k][1] = bal[prev][1];
+        }
+
+        if (legs[k].paused) return std::nullopt;
+        if (k > 0 && legs[k].mint[dir] != legs[k - 1].mint[1 - directions[k - 1]]) {
+            return std::nullopt;
+        }
+
+        auto q = hop(legs[k], bal[k], dir, amount, 0);
+        if (!q) return std::nullopt;
+        apply(bal[k], dir, *q);
+        out.hop[k] = *q;
+        amount = q->amount_out;
+    }
+    return out;
+}
+
+/** Pool slot for simulate_routes: leg plus D per direction. */
+struct Slot {
+    Leg      leg;
+    uint64_t d[2] = {};
+    bool     ok[2] = {};
+};
+
+/**
+ * Sort key for a route: amount, then one 32-bit step per hop, packed two
+ * to a word. A step is (slot << 1 | dir) + 1, so a missing hop (0) sorts a
+ * route before its extensions.
+ */
+struct RouteKey {
+    uint64_t amount_in;
+    uint64_t steps[2];
+    uint32_t index;
+
+    uint32_t step(size_t k) const {
+        return static_cast<uint32_t>(steps[k >> 1] >> (k & 1 ? 0 : 32));
+    }
+
+    bool operator<(const RouteKey& o) const {
+        if (amount_in != o.amount_in) return amount_in < o.amount_in;
+        if (steps[0] != o.steps[0]) return steps[0] < o.steps[0];
+        if (steps[1] != o.steps[1]) return steps[1] < o.steps[1];
+        return index < o.index;
+    }
+};
+
+inline size_t common_prefix(const RouteKey& a, const RouteKey& b) {
+    if (a.amount_in != b.amount_in) return 0;
+    size_t k = 0;
+    while (k < MAX_HOPS && a.step(k) != 0 && a.step(k) == b.step(k)) k++;
+    return k;
+}
+
+template <typename P>
+RouteBatchStats simulate_routes(const P* pools, size_t n_pools, const Route* routes, size_t n,
+                                int64_t now, std::vector<std::optional<MultihopQuote>>& out) {
+    constexpr uint32_t NO_SLOT = UINT32_MAX;
+    RouteBatchStats stats;
+    stats.routes = n;
+    out.assign(n, std::nullopt);
+
+    // Keys for well-formed routes; one slot per distinct pool they use
+    std::vector<RouteKey> keys;
+    std::vector<uint32_t> slot_index(n_pools, NO_SLOT);
+    std::vector<Slot> slots;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        const Route& r = routes[i];
+        if (r.hops < MIN_HOPS || r.hops > MAX_HOPS) continue;
+        bool ok = true;
+        for (size_t k = 0; k < r.hops; k++) {
+            ok = ok && r.pools[k] < n_pools && r.directions[k] <= 1;
+        }
+        if (!ok) continue;
+
+        RouteKey key = {r.amount_in, {0, 0}, static_cast<uint32_t>(i)};
+        for (size_t k = 0; k < r.hops; k++) {
+            uint32_t& s = slot_index[r.pools[k]];
+            if (s == NO_SLOT) {
+                s = static_cast<uint32_t>(slots.size());
+                slots.emplace_back();
+                slots.back().leg = load(pools[r.pools[k]], now);
+            }
+            const uint64_t step = ((static_cast<uint64_t>(s) << 1) | r.directions[k]) + 1;
+            key.steps[k >> 1] |= step << (k & 1 ? 0 : 32);
+        }
+        keys.push_back(key);
+        stats.hops += r.hops;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Hops of the previous route: [0, depth) are valid; if `failed`, the
+    // hop at `depth` failed and so does every route sharing it.
+    HopQuote stack[MAX_HOPS];
+    size_t slot_at[MAX_HOPS] = {};
+    size_t depth = 0;
+    bool failed = false;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        const RouteKey& key = keys[i];
+        const Route& r = routes[key.index];
+        const size_t shared = i > 0 ? common_prefix(keys[i - 1], key) : 0;
+        if (failed && shared > depth) continue;
+
+        depth = std::min(shared, depth);
+        failed = false;
+        for (size_t k = depth; k < r.hops; k++) {
+            const uint8_t dir = r.directions[k];
+            const size_t s = (key.step(k) - 1) >> 1;
+            Slot& slot = slots[s];
+            slot_at[k] = s;
+
+            if (slot.leg.paused ||
+                (k > 0 && slot.leg.mint[dir] != slots[slot_at[k - 1]].leg.mint[1 - r.directions[k - 1]])) {
+                failed = true;
+                break;
+            }
+
+            // Replay earlier hops of this route through the same pool
+            uint64_t bal[2] = {slot.leg.bal[0], slot.leg.bal[1]};
+            bool touched = false;
+            for (size_t j = 0; j < k; j++) {
+                if (slot_at[j] != s) continue;
+                apply(bal, r.directions[j], stack[j]);
+                touched = true;
+            }
+
+            uint64_t d = 0;
+            if (!touched) {
+                if (!slot.ok[dir]) {
+                    auto dd = math::calc_d(bal[dir], bal[1 - dir], slot.leg.amp);
+                    if (!dd) { failed = true; break; }
+                    slot.d[dir] = *dd;
+                    slot.ok[dir] = true;
+                }
+                d = slot.d[dir];
+            }
+
+            const uint64_t amount = k == 0 ? r.amount_in : stack[k - 1].amount_out;
+            stats.hops_simulated++;
+            auto q = hop(slot.leg, bal, dir, amount, d);
+            if (!q) { failed = true; break; }
+            stack[k] = *q;
+            depth = k + 1;
+        }
+        if (failed) continue;
+
+        MultihopQuote& q = out[key.index].emplace();
+        q.hops = r.hops;
+        std::copy(stack, stack + r.hops, q.hop);
+        stats.quoted++;
+    }
+    return stats;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Single Route
+// ============================================================================
+
+/**
+ * Quote a multihop route hop by hop.
+ *
+ * @param pools Pool snapshot for each hop
+ * @param directions Direction byte for each hop (as passed to multihop)
+ * @param hops Number of hops (2-4)
+ * @param amount_in Input amount of the first hop
+ * @param now Unix timestamp for amp ramping
+ * @return Per-hop quote, or nullopt if the program would reject the route
+ */
+inline std::optional<MultihopQuote> simulate_multihop(
+    const PoolView* pools, const uint8_t* directions, size_t hops,
+    uint64_t amount_in, int64_t now
+) {
+    AEX402_TRACE_SCOPE("quote.simulate_multihop");
+    return detail::simulate_multihop(pools, directions, hops, amount_in, now);
+}
+
+inline std::optional<MultihopQuote> simulate_multihop(
+    const Pool* pools, const uint8_t* directions, size_t hops,
+    uint64_t amount_in, int64_t now
+) {
+    AEX402_TRACE_SCOPE("quote.simulate_multihop");
+    return detail::simulate_multihop(pools, directions, hops, amount_in, now);
+}
+
+inline std::optional<MultihopQuote> simulate_multihop(
+    const std::vector<PoolView>& pools, const std::vector<uint8_t>& directions,
+    uint64_t amount_in, int64_t now
+) {
+    if (pools.size() != directions.size()) return std::nullopt;
+    return simulate_multihop(pools.data(), directions.data(), pools.size(), amount_in, now);
+}
+
+// ============================================================================
+// Route Batches
+// ============================================================================
+
+/**
+ * Quote many candidate routes over one pool array, reusing the hops of
+ * shared prefixes. out[i] is the quote for routes[i] (nullopt for a
+ * malformed or rejected route) and equals simulate_multihop on the same
+ * pools; a pool index repeated within a route is treated as the same pool.
+ *
+ * @param pools Pool snapshots indexed by Route::pools
+ * @param n_pools Number of pool snapshots
+ * @param routes Candidate routes
+ * @param n Number of routes
+ * @param now Unix timestamp for amp ramping
+ * @param out Per-route quotes (resized to n)
+ * @return Route and hop counts, including how many hops were run
+ */
+inline RouteBatchStats simulate_routes(
+    const PoolView* pools, size_t n_pools, const Route* routes, size_t n,
+    int64_t now, std::vector<std::optional<MultihopQuote>>& out
+) {
+    AEX402_TRACE_SCOPE("quote.simulate_routes");
+    return detail::simulate_routes(pools, n_pools, routes, n, now, out);
+}
+
+inline RouteBatchStats simulate_routes(
+    const Pool* pools, size_t n_pools, const Route* routes, size_t n,
+    int64_t now, std::vector<std::optional<MultihopQuote>>& out
+) {
+    AEX402_TRACE_SCOPE("quote.simulate_routes");
+    return detail::simulate_routes(pools, n_pools, routes, n, now, out);
+}
+
+inline RouteBatchStats simulate_routes(
+    const std::vector<PoolView>& pools, const std::vector<Route>& routes,
+    int64_t now, std::vector<std::optional<MultihopQuote>>& out
+) {
+    return simulate_routes(pools.data(), pools.size(), routes.data(), routes.size(), now, out);
+}
+
+} // namespace route
+} // namespace aex402
@@ -0,0 +1,452 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Shared-Memory Pool State
+ *
+ * Publishes parsed Pool/NPool state into a POSIX shared-memory segment so
+ * several processes on one host can share a single ingest pipeline.
+ *
+ * Segment layout (all offsets fixed at creation):
+ *   ShmHeader                       (one cache line)
+ *   ShmSlot[capacity]               (1024 bytes each, per-slot seqlock)
+ *   std::atomic<uint32_t>[ring]     (notification ring of changed indices)
+ *
+ * One writer maps the segment read-write; readers map it read-only and
+ * never write to it. A slot update is bracketed by an odd/even sequence
+ * number; readers retry while the sequence is odd or changes under them,
+ * giving up after READ_RETRY_LIMIT attempts so a writer that dies
+ * mid-update cannot hang them.
+ * Payload words are copied with relaxed atomic loads/stores so concurrent
+ * access is well-defined.
+ *
+ * POSIX only; not included from aex402.hpp.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "types.hpp"
+#include "accounts.hpp"
+#include "pubkey_map.hpp"
+
+namespace aex402 {
+namespace shm {
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+constexpr uint64_t SHM_MAGIC = 0x4853323034584541ULL;  // "AEX402SH"
+constexpr uint32_t SHM_VERSION = 1;
+constexpr uint32_t MAX_RING_CAPACITY = 1u << 31;   // Largest power of two in uint32_t
+constexpr uint32_t READ_RETRY_LIMIT = 1u << 16;    // Seqlock attempts before a read fails
+
+constexpr size_t PAYLOAD_BYTES =
+    ((sizeof(Pool) > sizeof(NPool) ? sizeof(Pool) : sizeof(NPool)) + 7) & ~size_t{7};
+constexpr size_t META_WORDS = 6;   // slot, type|len, key[4]
+constexpr size_t SLOT_WORDS = META_WORDS + PAYLOAD_BYTES / 8;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shm atomics must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shm atomics must be lock-free");
+
+struct alignas(64) ShmHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t capacity;              // Number of slots
+    uint32_t ring_capacity;         // Power of two
+    uint32_t slot_stride;
+    std::atomic<uint32_t> count;    // Slots assigned so far
+    uint32_t _pad;
+    std::atomic<uint64_t> ring_head;  // Total notifications published
+};
+
+struct alignas(64) ShmSlot {
+    std::atomic<uint32_t> seq;
+    uint32_t _pad;
+    uint64_t words[SLOT_WORDS];
+};
+
+static_assert(sizeof(ShmHeader) == 64, "ShmHeader must be one cache line");
+static_assert(sizeof(ShmSlot) == 1024, "ShmSlot stride must stay 1024 bytes");
+
+inline size_t segment_size(uint32_t capacity, uint32_t ring_capacity) {
+    return sizeof(ShmHeader) + static_cast<size_t>(capacity) * sizeof(ShmSlot) +
+           static_cast<size_t>(ring_capacity) * sizeof(std::atomic<uint32_t>);
+}
+
+/**
+ * Consistent copy of one slot.
+ */
+struct SlotSnapshot {
+    uint64_t slot;          // Solana slot of the update
+    AccountType type;
+    uint32_t len;           // Valid payload bytes
+    Pubkey key;
+    uint8_t payload[PAYLOAD_BYTES];
+
+    std::optional<Pool> pool() const {
+        if (type != AccountType::Pool || len < sizeof(Pool)) return std::nullopt;
+        Pool p;
+        std::memcpy(&p, payload, sizeof(Pool));
+        return p;
+    }
+
+    std::optional<NPool> npool() const {
+        if (type != AccountType::NPool || len < sizeof(NPool)) return std::nullopt;
+        NPool p;
+        std::memcpy(&p, payload, sizeof(NPool));
+        return p;
+    }
+};
+
+namespace detail {
+
+inline uint64_t load_word(const uint64_t* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+inline void store_word(uint64_t* p, uint64_t v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+
+inline ShmSlot* slot_at(uint8_t* base, uint32_t i) {
+    return reinterpret_cast<ShmSlot*>(base + sizeof(ShmHeader)) + i;
+}
+
+inline std::atomic<uint32_t>* ring_at(uint8_t* base, uint32_t capacity) {
+    size_t offset = sizeof(ShmHeader) + static_cast<size_t>(capacity) * sizeof(ShmSlot);
+    return reinterpret_cast<std::atomic<uint32_t>*>(base + offset);
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+/**
+ * Single writer for a segment. Not thread-safe: one publishing thread.
+ */
+class ShmWriter {
+public:
+    /**
+     * Create (or replace) a segment. ring_capacity is rounded up to a power of two
+     * and must not exceed MAX_RING_CAPACITY.
+     *
+     * An existing segment is unlinked, not truncated: readers that still map it
+     * keep valid (if stale) memory and must reopen to see the new one.
+     */
+    static std::optional<ShmWriter> create(const std::string& name, uint32_t capacity,
+                                           uint32_t ring_capacity = 4096) {
+        if (capacity == 0 || ring_capacity > MAX_RING_CAPACITY) return std::nullopt;
+        uint32_t ring = 1;
+        while (ring < ring_capacity) ring <<= 1;
+
+        size_t size = segment_size(capacity, ring);
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) return std::nullopt;  // Includes another process re-creating it first
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        // ftruncate zero-fills: all sequence numbers and ring entries start at 0
+        auto* hdr = static_cast<ShmHeader*>(p);
+        hdr->version = SHM_VERSION;
+        hdr->capacity = capacity;
+        hdr->ring_capacity = ring;
+        hdr->slot_stride = sizeof(ShmSlot);
+        std::atomic_thread_fence(std::memory_order_release);
+        __atomic_store_n(&hdr->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+
+        return ShmWriter(name, static_cast<uint8_t*>(p), size);
+    }
+
+    ShmWriter(ShmWriter&& o) noexcept { *this = std::move(o); }
+
+    ShmWriter& operator=(ShmWriter&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            name_ = std::move(o.name_);
+            base_ = std::exchange(o.base_, nullptr);
+            size_ = std::exchange(o.size_, 0);
+            index_ = std::move(o.index_);
+            unlink_ = o.unlink_;
+        }
+        return *this;
+    }
+
+    ShmWriter(const ShmWriter&) = delete;
+    ShmWriter& operator=(const ShmWriter&) = delete;
+
+    ~ShmWriter() {
+        unmap();
+        if (unlink_ && !name_.empty()) ::shm_unlink(name_.c_str());
+    }
+
+    /**
+     * Remove the segment name when this writer is destroyed.
+     */
+    void unlink_on_close(bool v) { unlink_ = v; }
+
+    uint32_t capacity() const { return header()->capacity; }
+    uint32_t count() const { return header()->count.load(std::memory_order_relaxed); }
+
+    /**
+     * Slot index for key, assigning the next free slot on first use.
+     * Returns nullopt when the segment is full.
+     */
+    std::optional<uint32_t> index_of(const Pubkey& key) {
+        if (const uint32_t* idx = index_.find(key)) return *idx;
+        uint32_t n = count();
+        if (n >= capacity()) return std::nullopt;
+        index_.insert_or_assign(key, n);
+        header()->count.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    bool publish(const Pubkey& key, const Pool& pool, uint64_t slot) {
+        return publish_raw(key, AccountType::Pool, reinterpret_cast<const uint8_t*>(&pool),
+                           sizeof(Pool), slot);
+    }
+
+    bool publish(const Pubkey& key, const NPool& pool, uint64_t slot) {
+        return publish_raw(key, AccountType::NPool, reinterpret_cast<const uint8_t*>(&pool),
+                           sizeof(NPool), slot);
+    }
+
+    /**
+     * Publish raw bytes (truncated to the slot payload size) and notify readers.
+     */
+    bool publish_raw(const Pubkey& key, AccountType type, const uint8_t* data, size_t len,
+                     uint64_t slot) {
+        auto idx = index_of(key);
+        if (!idx) return false;
+        if (len > PAYLOAD_BYTES) len = PAYLOAD_BYTES;
+
+        ShmSlot* s = detail::slot_at(base_, *idx);
+        uint32_t seq = s->seq.load(std::memory_order_relaxed);
+        s->seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        detail::store_word(&s->words[0], slot);
+        detail::store_word(&s->words[1], static_cast<uint64_t>(type) |
+                                         (static_cast<uint64_t>(len) << 32));
+        for (size_t i = 0; i < 4; i++) {
+            uint64_t w = aex402::detail::load_le<uint64_t>(key.data() + 8 * i);
+            detail::store_word(&s->words[2 + i], w);
+        }
+        size_t full = len / 8;
+        for (size_t i = 0; i < full; i++) {
+            uint64_t w;
+            std::memcpy(&w, data + 8 * i, 8);
+            detail::store_word(&s->words[META_WORDS + i], w);
+        }
+        if (len % 8) {
+            uint64_t w = 0;
+            std::memcpy(&w, data + 8 * full, len % 8);
+            detail::store_word(&s->words[META_WORDS + full], w);
+        }
+
+        s->seq.store(seq + 2, std::memory_order_release);
+
+        // Notify: write the entry, then advance head
+        ShmHeader* hdr = header();
+        uint64_t head = hdr->ring_head.load(std::memory_order_relaxed);
+        detail::ring_at(base_, hdr->capacity)[head & (hdr->ring_capacity - 1)]
+            .store(*idx, std::memory_order_relaxed);
+        hdr->ring_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::string name_;
+    uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    PubkeyMap<uint32_t> index_;
+    bool unlink_ = false;
+
+    ShmWriter(std::string name, uint8_t* base, size_t size)
+        : name_(std::move(name)), base_(base), size_(size) {}
+
+    ShmHeader* header() const { return reinterpret_cast<ShmHeader*>(base_); }
+
+    void unmap() {
+        if (base_) ::munmap(base_, size_);
+        base_ = nullptr;
+    }
+};
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+/**
+ * Read-only view of a segment. Each reader keeps its own ring cursor.
+ */
+class ShmReader {
+public:
+    static std::optional<ShmReader> open(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return std::nullopt;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmHeader)) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return std::nullopt;
+
+        auto* hdr = static_cast<const ShmHeader*>(p);
+        if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC ||
+            hdr->version != SHM_VERSION || hdr->slot_stride != sizeof(ShmSlot) ||
+            segment_size(hdr->capacity, hdr->ring_capacity) > size) {
+            ::munmap(p, size);
+            return std::nullopt;
+        }
+
+        ShmReader r(static_cast<uint8_t*>(p), size);
+        r.cursor_ = hdr->ring_head.load(std::memory_order_acquire);
+        return r;
+    }
+
+    ShmReader(ShmReader&& o) noexcept { *this = std::move(o); }
+
+    ShmReader& operator=(ShmReader&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            base_ = std::exchange(o.base_, nullptr);
+            size_ = std::exchange(o.size_, 0);
+            cursor_ = o.cursor_;
+            index_ = std::move(o.index_);
+            indexed_ = o.indexed_;
+        }
+        return *this;
+    }
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    ~ShmReader() { unmap(); }
+
+    uint32_t capacity() const { return header()->capacity; }
+    uint32_t count() const { return header()->count.load(std::memory_order_acquire); }
+
+    /**
+     * Consistent copy of slot i. Returns false if i is unassigned, or if no
+     * consistent copy was seen in READ_RETRY_LIMIT attempts (the writer is
+     * stuck or died mid-update).
+     */
+    bool read(uint32_t i, SlotSnapshot& out) const {
+        if (i >= count()) return false;
+        const ShmSlot* s = detail::slot_at(base_, i);
+        uint64_t words[SLOT_WORDS];
+        for (uint32_t attempt = 0;; attempt++) {
+            if (attempt == READ_RETRY_LIMIT) return false;
+            uint32_t s1 = s->seq.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            for (size_t w = 0; w < SLOT_WORDS; w++) words[w] = detail::load_word(&s->words[w]);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s->seq.load(std::memory_order_relaxed) == s1) {
+                if (s1 == 0) return false;  // Assigned but not yet published
+                break;
+            }
+        }
+
+        out.slot = words[0];
+        out.type = static_cast<AccountType>(words[1] & 0xFFFFFFFF);
+        out.len = static_cast<uint32_t>(words[1] >> 32);
+        for (size_t k = 0; k < 4; k++) {
+            aex402::detail::store_le<uint64_t>(out.key.data() + 8 * k, words[2 + k]);
+        }
+        std::memcpy(out.payload, words + META_WORDS, PAYLOAD_BYTES);
+        return true;
+    }
+
+    std::optional<Pool> read_pool(uint32_t i) const {
+        SlotSnapshot s;
+        return read(i, s) ? s.pool() : std::nullopt;
+    }
+
+    std::optional<NPool> read_npool(uint32_t i) const {
+        SlotSnapshot s;
+        return read(i, s) ? s.npool() : std::nullopt;
+    }
+
+    /**
+     * Slot index for key (index built from slot keys on demand).
+     */
+    std::optional<uint32_t> find(const Pubkey& key) {
+        if (const uint32_t* idx = index_.find(key)) return *idx;
+        uint32_t n = count();
+        SlotSnapshot s;
+        for (; indexed_ < n; indexed_++) {
+            if (read(indexed_, s)) index_.insert_or_assign(s.key, indexed_);
+            else break;
+        }
+        if (const uint32_t* idx = index_.find(key)) return *idx;
+        return std::nullopt;
+    }
+
+    /**
+     * Append indices changed since the last poll (may repeat an index).
+     * Returns false if the ring overran this reader; `changed` then holds
+     * every assigned index so the caller can resync.
+     */
+    bool poll(std::vector<uint32_t>& changed) {
+        const ShmHeader* hdr = header();
+        uint64_t head = hdr->ring_head.load(std::memory_order_acquire);
+        uint64_t cap = hdr->ring_capacity;
+        const std::atomic<uint32_t>* ring = detail::ring_at(base_, hdr->capacity);
+
+        size_t mark = changed.size();
+        bool ok = head - cursor_ <= cap;
+        if (ok) {
+            for (uint64_t c = cursor_; c < head; c++) {
+                changed.push_back(ring[c & (cap - 1)].load(std::memory_order_relaxed));
+            }
+            // Entries read above may have been overwritten if the writer lapped us
+            uint64_t after = hdr->ring_head.load(std::memory_order_acquire);
+            ok = after - cursor_ <= cap;
+        }
+        if (!ok) {
+            changed.resize(mark);
+            uint32_t n = count();
+            for (uint32_t i = 0; i < n; i++) changed.push_back(i);
+        }
+        cursor_ = head;
+        return ok;
+    }
+
+private:
+    uint8_t* base_ = nullptr;
+    size_t size_ = 0;
+    uint64_t cursor_ = 0;
+    PubkeyMap<uint32_t> index_;
+    uint32_t indexed_ = 0;
+
+    ShmReader(uint8_t* base, size_t size) : base_(base), size_(size) {}
+
+    const ShmHeader* header() const { return reinterpret_cast<const ShmHeader*>(base_); }
+
+    void unmap() {
+        if (base_) ::munmap(base_, size_);
+        base_ = nullptr;
+    }
+};
+
+}  // namespace shm
+}  // namespace aex402
@@ -5,6 +5,10 @@
  * Pure C++17 SDK for interacting with the AeX402 AMM on Solana.
  * No external dependencies beyond standard library.
  *
+ * Legacy single-header version. Its account structs are NOT packed and do
+ * not match the on-chain layout; use aex402.hpp (types.hpp / layout.hpp)
+ * for parsing account data.
+ *
  * Program ID: 3AMM53MsJZy2Jvf7PeHHga3bsGjWV4TSaYz29WUtcdje
  */
 
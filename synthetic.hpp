@@ -0,0 +1,523 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Synthetic Account Universe
+ *
+ * Seeded generator of realistic raw account bytes for benchmarks, soak
+ * tests and the mock RPC server: Pool and NPool accounts with heavy-tailed
+ * TVL, near-peg balance ratios with a tail of imbalanced pools, amps drawn
+ * log-uniformly over MIN_AMP..MAX_AMP, ramps in progress, populated hourly
+ * and daily candles and trader blooms, plus farms and orderbooks attached
+ * to generated pools.
+ *
+ * A matching swap stream picks pools with a skewed (hot-pool) distribution
+ * and sizes trades log-uniformly against the input balance; apply_swap()
+ * replays an event onto the account bytes with the SDK's swap math.
+ *
+ * The same seed and config always produce the same bytes.
+ *
+ * Usage:
+ *   synthetic::UniverseConfig cfg;
+ *   cfg.pools = 5000;
+ *   synthetic::Universe u = synthetic::generate_universe(cfg);
+ *   synthetic::SwapStream swaps(u, cfg.seed);
+ *   for (int i = 0; i < 1000000; i++) {
+ *       synthetic::SwapEvent ev = swaps.next();
+ *       synthetic::apply_swap(u.accounts[ev.account], ev);
+ *   }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <vector>
+#include "constants.hpp"
+#include "types.hpp"
+#include "layout.hpp"
+#include "accounts.hpp"
+#include "math.hpp"
+
+namespace aex402 {
+namespace synthetic {
+
+// ============================================================================
+// Random Source
+// ============================================================================
+
+/**
+ * SplitMix64; small, fast and good enough for test data.
+ */
+struct Rng {
+    uint64_t s;
+
+    explicit Rng(uint64_t seed) : s(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [lo, hi)
+    uint64_t range(uint64_t lo, uint64_t hi) { return hi > lo ? lo + next() % (hi - lo) : lo; }
+
+    // Uniform in [0, 1)
+    double unit() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    // Log-uniform in [lo, hi]
+    double log_uniform(double lo, double hi) {
+        return std::exp(std::log(lo) + unit() * (std::log(hi) - std::log(lo)));
+    }
+
+    bool chance(double p) { return unit() < p; }
+
+    Pubkey pubkey() {
+        Pubkey k;
+        for (size_t i = 0; i < 32; i += 8) aex402::detail::store_le<uint64_t>(&k[i], next());
+        return k;
+    }
+};
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+struct UniverseConfig {
+    uint64_t seed = 1;
+    size_t pools = 1000;            // 2-token pools
+    size_t npools = 200;            // N-token pools
+    size_t farms = 200;             // Attached to random pools
+    size_t orderbooks = 50;         // Attached to random pools
+    int64_t now = 1700000000;       // Unix time the snapshot represents
+    uint64_t slot = 250000000;      // Slot the snapshot represents
+
+    double min_tvl = 1e6;           // Per-token balance range (raw units),
+    double max_tvl = 1e15;          // drawn log-uniformly
+    double imbalanced_frac = 0.05;  // Pools far off peg (ratio up to 20x)
+    double ramping_frac = 0.05;     // Pools with an amp ramp in progress
+    double paused_frac = 0.01;
+    double bloom_density = 0.3;     // Fraction of bloom bits set
+};
+
+// ============================================================================
+// Universe
+// ============================================================================
+
+struct SyntheticAccount {
+    Pubkey address;
+    AccountType type;
+    std::vector<uint8_t> data;      // Raw account bytes as stored on-chain
+};
+
+struct Universe {
+    std::vector<SyntheticAccount> accounts;
+    std::vector<size_t> pools;      // Indices into accounts, by type
+    std::vector<size_t> npools;
+    std::vector<size_t> farms;
+    std::vector<size_t> orderbooks;
+    int64_t now = 0;
+    uint64_t slot = 0;
+};
+
+namespace detail {
+
+template <typename T>
+inline SyntheticAccount make_account(const Pubkey& address, AccountType type, const T& value, size_t size) {
+    SyntheticAccount a{address, type, std::vector<uint8_t>(size, 0)};
+    std::memcpy(a.data.data(), &value, sizeof(T));
+    return a;
+}
+
+inline uint64_t clamp_u64(double v, uint64_t lo, uint64_t hi) {
+    if (!(v >= static_cast<double>(lo))) return lo;
+    if (v >= static_cast<double>(hi)) return hi;
+    return static_cast<uint64_t>(v);
+}
+
+// Price of token0 in token1, scaled 1e6 and clamped to the candle range
+inline uint32_t spot_price(uint64_t bal0, uint64_t bal1) {
+    if (bal0 == 0) return 0;
+    double p = static_cast<double>(bal1) / static_cast<double>(bal0) * 1e6;
+    return static_cast<uint32_t>(clamp_u64(p, 1, 0xFFFFFFF0u));
+}
+
+/**
+ * Random-walk candle closing at `price`. Volatility is a fraction of price.
+ * On return `price` holds the candle's open, i.e. the previous candle's
+ * close, so successive calls walk backwards in time.
+ */
+inline Candle random_candle(Rng& rng, uint32_t& price, double vol, uint64_t volume_1e9) {
+    double close = price;
+    double drift = close / (1.0 + vol * (rng.unit() * 2.0 - 1.0));
+    // Keep close - open within the int16 delta and the open positive
+    uint64_t open_lo = price > 32768u ? price - 32767u : 1;
+    uint64_t open_hi = std::min<uint64_t>(static_cast<uint64_t>(price) + 32768u, 0xFFFFFFF0u);
+    uint32_t open_px = static_cast<uint32_t>(clamp_u64(drift, open_lo, open_hi));
+    double open = open_px;
+    double high = std::max(open, close) * (1.0 + vol * rng.unit() * 0.5);
+    double low = std::min(open, close) * (1.0 - vol * rng.unit() * 0.5);
+
+    Candle c{};
+    c.open = open_px;
+    c.high_d = static_cast<uint16_t>(clamp_u64(high - open, 0, 0xFFFF));
+    c.low_d = static_cast<uint16_t>(clamp_u64(open - low, 0, 0xFFFF));
+    c.close_d = static_cast<int16_t>(static_cast<int64_t>(price) - static_cast<int64_t>(open_px));
+    c.volume = static_cast<uint16_t>(volume_1e9 > 0xFFFF ? 0xFFFF : volume_1e9);
+    price = open_px;
+    return c;
+}
+
+inline uint64_t random_amp(Rng& rng) {
+    return clamp_u64(rng.log_uniform(static_cast<double>(MIN_AMP), static_cast<double>(MAX_AMP)), MIN_AMP, MAX_AMP);
+}
+
+inline Pool make_pool(Rng& rng, const UniverseConfig& cfg) {
+    Pool p{};
+    aex402::detail::store_le<uint64_t>(p.disc, account_disc::POOL);
+    p.authority = rng.pubkey();
+    p.mint0 = rng.pubkey();
+    p.mint1 = rng.pubkey();
+    p.vault0 = rng.pubkey();
+    p.vault1 = rng.pubkey();
+    p.lp_mint = rng.pubkey();
+    p.bump = static_cast<uint8_t>(rng.range(240, 256));
+    p.v0_bump = static_cast<uint8_t>(rng.range(240, 256));
+    p.v1_bump = static_cast<uint8_t>(rng.range(240, 256));
+    p.lp_bump = static_cast<uint8_t>(rng.range(240, 256));
+
+    // Amp, with a ramp in progress for a fraction of pools
+    p.amp = p.init_amp = p.target_amp = random_amp(rng);
+    if (rng.chance(cfg.ramping_frac)) {
+        int64_t duration = RAMP_MIN_DURATION * static_cast<int64_t>(rng.range(1, 8));
+        p.ramp_start = cfg.now - static_cast<int64_t>(rng.range(0, static_cast<uint64_t>(duration)));
+        p.ramp_stop = p.ramp_start + duration;
+        p.target_amp = random_amp(rng);
+    }
+    p.fee_bps = rng.range(1, 101);
+    p.admin_fee_pct = ADMIN_FEE_PCT;
+    p.paused = rng.chance(cfg.paused_frac) ? 1 : 0;
+
+    // Heavy-tailed size; mostly near peg, some far off
+    double tvl = rng.log_uniform(cfg.min_tvl, cfg.max_tvl);
+    double ratio = rng.chance(cfg.imbalanced_frac) ? rng.log_uniform(0.05, 20.0) : 0.9 + rng.unit() * 0.2;
+    p.bal0 = clamp_u64(tvl, 1000, UINT64_MAX / 4);
+    p.bal1 = clamp_u64(tvl * ratio, 1000, UINT64_MAX / 4);
+    auto d = math::calc_d(p.bal0, p.bal1, p.amp);
+    p.lp_supply = d ? *d : p.bal0 / 2 + p.bal1 / 2;
+
+    // Activity history
+    p.trade_count = rng.range(0, 1000000);
+    double avg_trade = tvl * rng.log_uniform(1e-5, 1e-2);
+    p.trade_sum = clamp_u64(avg_trade * static_cast<double>(p.trade_count), 0, UINT64_MAX / 4);
+    p.vol0 = p.trade_sum / 2;
+    p.vol1 = clamp_u64(static_cast<double>(p.vol0) * ratio, 0, UINT64_MAX / 4);
+    p.admin_fee0 = p.vol0 / 10000 * p.fee_bps / 2;
+    p.admin_fee1 = p.vol1 / 10000 * p.fee_bps / 2;
+
+    uint32_t price = spot_price(p.bal0, p.bal1);
+    p.max_price = price;
+    p.min_price = price;
+    p.hour_slot = static_cast<uint32_t>(cfg.slot / SLOTS_PER_HOUR);
+    p.day_slot = static_cast<uint32_t>(cfg.slot / SLOTS_PER_DAY);
+    p.hour_idx = static_cast<uint8_t>(p.hour_slot % OHLCV_24H);
+    p.day_idx = static_cast<uint8_t>(p.day_slot % OHLCV_7D);
+
+    // Bloom of recent traders
+    for (size_t i = 0; i < BLOOM_SIZE * 8; i++) {
+        if (rng.chance(cfg.bloom_density)) p.bloom[i / 8] = static_cast<uint8_t>(p.bloom[i / 8] | (1u << (i % 8)));
+    }
+
+    // Candles walk backwards in time from the current price: the newest
+    // candle closes at the spot price and each candle opens at the
+    // previous one's close
+    double vol = ratio > 0.85 && ratio < 1.15 ? 0.002 : 0.02;
+    uint64_t hourly_volume = static_cast<uint64_t>(avg_trade * 50.0 / 1e9);
+    uint32_t walk = price;
+    for (uint8_t h = 0; h < OHLCV_24H; h++) {
+        size_t idx = static_cast<size_t>((p.hour_idx + OHLCV_24H - h) % OHLCV_24H);
+        p.hours[idx] = random_candle(rng, walk, vol, hourly_volume);
+        p.max_price = std::max(p.max_price, p.hours[idx].high());
+        p.min_price = std::min(p.min_price, p.hours[idx].low());
+    }
+    walk = price;
+    for (uint8_t d7 = 0; d7 < OHLCV_7D; d7++) {
+        size_t idx = static_cast<size_t>((p.day_idx + OHLCV_7D - d7) % OHLCV_7D);
+        p.days[idx] = random_candle(rng, walk, vol * 4.0, hourly_volume * 24);
+        p.max_price = std::max(p.max_price, p.days[idx].high());
+        p.min_price = std::min(p.min_price, p.days[idx].low());
+    }
+    return p;
+}
+
+inline NPool make_npool(Rng& rng, const UniverseConfig& cfg) {
+    NPool p{};
+    aex402::detail::store_le<uint64_t>(p.disc, account_disc::NPOOL);
+    p.authority = rng.pubkey();
+    p.n_tokens = static_cast<uint8_t>(rng.range(2, MAX_TOKENS + 1));
+    p.paused = rng.chance(cfg.paused_frac) ? 1 : 0;
+    p.bump = static_cast<uint8_t>(rng.range(240, 256));
+    p.amp = random_amp(rng);
+    p.fee_bps = rng.range(1, 101);
+    p.admin_fee_pct = ADMIN_FEE_PCT;
+
+    double tvl = rng.log_uniform(cfg.min_tvl, cfg.max_tvl);
+    bool imbalanced = rng.chance(cfg.imbalanced_frac);
+    for (uint8_t i = 0; i < p.n_tokens; i++) {
+        double ratio = imbalanced ? rng.log_uniform(0.1, 10.0) : 0.9 + rng.unit() * 0.2;
+        p.mints[i] = rng.pubkey();
+        p.vaults[i] = rng.pubkey();
+        p.balances[i] = clamp_u64(tvl * ratio, 1000, UINT64_MAX / 16);
+    }
+    p.lp_mint = rng.pubkey();
+    auto d = math::calc_d_n(p.balances, p.n_tokens, p.amp);
+    if (d) {
+        p.lp_supply = *d;
+    } else {
+        for (uint8_t i = 0; i < p.n_tokens; i++) p.lp_supply += p.balances[i] / p.n_tokens;
+    }
+
+    p.trade_count = rng.range(0, 1000000);
+    p.total_volume = clamp_u64(tvl * rng.log_uniform(1e-5, 1e-2) * static_cast<double>(p.trade_count),
+                               0, UINT64_MAX / 4);
+    for (uint8_t i = 0; i < p.n_tokens; i++) p.admin_fees[i] = p.total_volume / p.n_tokens / 10000 * p.fee_bps / 2;
+    p.last_trade_slot = cfg.slot - rng.range(0, SLOTS_PER_HOUR);
+    return p;
+}
+
+inline Farm make_farm(Rng& rng, const UniverseConfig& cfg, const Pubkey& pool, uint64_t lp_supply) {
+    Farm f{};
+    aex402::detail::store_le<uint64_t>(f.disc, account_disc::FARM);
+    f.pool = pool;
+    f.reward_mint = rng.pubkey();
+    f.reward_rate = clamp_u64(rng.log_uniform(1e3, 1e9), 1, UINT64_MAX);
+    f.start_time = cfg.now - static_cast<int64_t>(rng.range(0, 90 * 86400));
+    f.end_time = f.start_time + static_cast<int64_t>(rng.range(7, 181)) * 86400;
+    f.total_staked = lp_supply > 0 ? rng.range(0, lp_supply) : 0;
+    f.last_update = cfg.now - static_cast<int64_t>(rng.range(0, 3600));
+    f.acc_reward = clamp_u64(rng.log_uniform(1e9, 1e18), 0, UINT64_MAX);
+    return f;
+}
+
+inline Orderbook make_orderbook(Rng& rng, const UniverseConfig& cfg, const Pubkey& pool, uint32_t price) {
+    Orderbook b{};
+    aex402::detail::store_le<uint64_t>(b.disc, account_disc::BOOK);
+    b.pool = pool;
+    b.authority = rng.pubkey();
+    b.order_count = static_cast<uint8_t>(rng.range(0, MAX_ORDERS + 1));
+    for (size_t i = 0; i < b.order_count; i++) {
+        Order& o = b.orders[i];
+        bool buy = rng.next() & 1;
+        // Bids below spot, asks above, within 2%
+        double offset = 1.0 + (buy ? -1.0 : 1.0) * rng.unit() * 0.02;
+        o.owner = rng.pubkey();
+        o.price = clamp_u64(price * offset, 1, UINT64_MAX);
+        o.amount = clamp_u64(rng.log_uniform(1e6, 1e12), 1, UINT64_MAX);
+        o.expiry = cfg.now + static_cast<int64_t>(rng.range(0, 7 * 86400)) - 3600;
+        o.order_type = static_cast<uint8_t>(buy ? OrderType::Buy : OrderType::Sell);
+        o.active = rng.chance(0.9) ? 1 : 0;
+    }
+    return b;
+}
+
+}  // namespace detail
+
+/**
+ * Generate a universe of accounts. Pools come first, then NPools, farms
+ * and orderbooks; per-type indices are recorded in the Universe.
+ */
+inline Universe generate_universe(const UniverseConfig& cfg) {
+    Rng rng(cfg.seed);
+    Universe u;
+    u.now = cfg.now;
+    u.slot = cfg.slot;
+    u.accounts.reserve(cfg.pools + cfg.npools + cfg.farms + cfg.orderbooks);
+
+    for (size_t i = 0; i < cfg.pools; i++) {
+        u.pools.push_back(u.accounts.size());
+        u.accounts.push_back(detail::make_account(rng.pubkey(), AccountType::Pool,
+                                                  detail::make_pool(rng, cfg), POOL_SIZE));
+    }
+    for (size_t i = 0; i < cfg.npools; i++) {
+        u.npools.push_back(u.accounts.size());
+        u.accounts.push_back(detail::make_account(rng.pubkey(), AccountType::NPool,
+                                                  detail::make_npool(rng, cfg), NPOOL_SIZE));
+    }
+
+    // Farms and orderbooks hang off 2-token pools
+    if (u.pools.empty()) return u;
+    for (size_t i = 0; i < cfg.farms; i++) {
+        const SyntheticAccount& pool = u.accounts[u.pools[rng.range(0, u.pools.size())]];
+        uint64_t lp_supply = layout::pool::lp_supply::read(pool.data.data());
+        u.farms.push_back(u.accounts.size());
+        u.accounts.push_back(detail::make_account(rng.pubkey(), AccountType::Farm,
+                                                  detail::make_farm(rng, cfg, pool.address, lp_supply),
+                                                  sizeof(Farm)));
+    }
+    for (size_t i = 0; i < cfg.orderbooks; i++) {
+        const SyntheticAccount& pool = u.accounts[u.pools[rng.range(0, u.pools.size())]];
+        uint32_t price = detail::spot_price(
+            layout::pool::bal0::read(pool.data.data()), layout::pool::bal1::read(pool.data.data()));
+        u.orderbooks.push_back(u.accounts.size());
+        u.accounts.push_back(detail::make_account(rng.pubkey(), AccountType::Orderbook,
+                                                  detail::make_orderbook(rng, cfg, pool.address, price),
+                                                  sizeof(Orderbook)));
+    }
+    return u;
+}
+
+// ============================================================================
+// Swap Stream
+// ============================================================================
+
+struct SwapEvent {
+    size_t account;         // Index into Universe::accounts (Pool or NPool)
+    uint8_t from;           // Input token index
+    uint8_t to;             // Output token index
+    uint64_t amount_in;
+    int64_t timestamp;      // Unix seconds
+    uint64_t slot;
+    uint64_t trader;        // Synthetic trader id (drives bloom updates)
+};
+
+struct SwapStreamConfig {
+    double rate = 1000.0;           // Mean swaps per second (Poisson arrivals)
+    double hot_skew = 3.0;          // Pool pick is floor(n * u^skew); 1 = uniform
+    double min_frac = 1e-7;         // Trade size as a fraction of the input
+    double max_frac = 1e-2;         // balance, drawn log-uniformly
+    uint64_t traders = 100000;      // Distinct trader ids
+};
+
+/**
+ * Infinite stream of swaps against a universe's Pool and NPool accounts.
+ * Amounts are sized against the balances at the time next() is called, so
+ * interleaving next() with apply_swap() keeps trades proportionate.
+ */
+class SwapStream {
+public:
+    SwapStream(const Universe& u, uint64_t seed, SwapStreamConfig cfg = {})
+        : u_(u), cfg_(cfg), rng_(seed ^ 0x5357415053545245ULL),
+          clock_ns_(static_cast<double>(u.now) * 1e9) {
+        targets_.reserve(u.pools.size() + u.npools.size());
+        targets_.insert(targets_.end(), u.pools.begin(), u.pools.end());
+        targets_.insert(targets_.end(), u.npools.begin(), u.npools.end());
+        // Shuffle so the hot set mixes both pool types
+        for (size_t i = targets_.size(); i > 1; i--) std::swap(targets_[i - 1], targets_[rng_.range(0, i)]);
+    }
+
+    bool empty() const { return targets_.empty(); }
+
+    /**
+     * Next swap event. Must not be called on an empty stream.
+     */
+    SwapEvent next() {
+        clock_ns_ += -std::log(1.0 - rng_.unit()) / cfg_.rate * 1e9;
+        int64_t ts = static_cast<int64_t>(clock_ns_ / 1e9);
+
+        double u = std::pow(rng_.unit(), cfg_.hot_skew);
+        size_t idx = targets_[std::min(targets_.size() - 1, static_cast<size_t>(u * static_cast<double>(targets_.size())))];
+        const SyntheticAccount& a = u_.accounts[idx];
+
+        SwapEvent ev{};
+        ev.account = idx;
+        ev.timestamp = ts;
+        ev.slot = u_.slot + static_cast<uint64_t>(ts > u_.now ? (ts - u_.now) * 5 / 2 : 0);
+        ev.trader = rng_.range(0, cfg_.traders);
+
+        uint64_t bal_in;
+        if (a.type == AccountType::Pool) {
+            ev.from = static_cast<uint8_t>(rng_.next() & 1);
+            ev.to = static_cast<uint8_t>(1 - ev.from);
+            bal_in = ev.from ? layout::pool::bal1::read(a.data.data()) : layout::pool::bal0::read(a.data.data());
+        } else {
+            uint8_t n = layout::npool::n_tokens::read(a.data.data());
+            n = n < 2 ? 2 : (n > MAX_TOKENS ? static_cast<uint8_t>(MAX_TOKENS) : n);
+            ev.from = static_cast<uint8_t>(rng_.range(0, n));
+            ev.to = static_cast<uint8_t>((ev.from + 1 + rng_.range(0, n - 1u)) % n);
+            bal_in = aex402::detail::load_le<uint64_t>(a.data.data() + layout::npool::balances::offset + ev.from * 8u);
+        }
+        double amount = static_cast<double>(bal_in) * rng_.log_uniform(cfg_.min_frac, cfg_.max_frac);
+        ev.amount_in = detail::clamp_u64(amount, MIN_SWAP, UINT64_MAX / 4);
+        return ev;
+    }
+
+    /**
+     * Generate n events without applying them.
+     */
+    std::vector<SwapEvent> take(size_t n) {
+        std::vector<SwapEvent> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; i++) out.push_back(next());
+        return out;
+    }
+
+private:
+    const Universe& u_;
+    SwapStreamConfig cfg_;
+    Rng rng_;
+    std::vector<size_t> targets_;
+    double clock_ns_;
+};
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+/**
+ * Apply a swap to an account's bytes: balances, volume, trade counters,
+ * bloom and the current candle. Returns the output amount, or nullopt if
+ * the pool is paused or the swap is rejected by the math.
+ */
+inline std::optional<uint64_t> apply_swap(SyntheticAccount& a, const SwapEvent& ev) {
+    if (a.type == AccountType::Pool) {
+        auto p = parse_pool(a.data.data(), a.data.size());
+        if (!p || p->is_paused() || ev.from > 1 || ev.to != 1 - ev.from) return std::nullopt;
+        uint64_t& bal_in = ev.from == 0 ? p->bal0 : p->bal1;
+        uint64_t& bal_out = ev.from == 0 ? p->bal1 : p->bal0;
+        auto out = math::simulate_swap(bal_in, bal_out, ev.amount_in, p->get_amp(ev.timestamp), p->fee_bps);
+        if (!out || *out == 0 || *out >= bal_out) return std::nullopt;
+        bal_in += ev.amount_in;
+        bal_out -= *out;
+        (ev.from == 0 ? p->vol0 : p->vol1) += ev.amount_in;
+        p->trade_count++;
+        p->trade_sum += ev.amount_in;
+
+        uint64_t h = ev.trader * 0x9E3779B97F4A7C15ULL;
+        size_t bit = static_cast<size_t>(h >> 54) % (BLOOM_SIZE * 8u);
+        p->bloom[bit / 8] = static_cast<uint8_t>(p->bloom[bit / 8] | (1u << (bit % 8)));
+
+        uint32_t price = detail::spot_price(p->bal0, p->bal1);
+        p->max_price = std::max(p->max_price, price);
+        p->min_price = std::min(p->min_price, price);
+        Candle& c = p->hours[p->hour_idx % OHLCV_24H];
+        int64_t delta = static_cast<int64_t>(price) - static_cast<int64_t>(c.open);
+        if (delta > 0 && delta > c.high_d) c.high_d = static_cast<uint16_t>(std::min<int64_t>(delta, 0xFFFF));
+        if (delta < 0 && -delta > c.low_d) c.low_d = static_cast<uint16_t>(std::min<int64_t>(-delta, 0xFFFF));
+        c.close_d = static_cast<int16_t>(std::max<int64_t>(-32768, std::min<int64_t>(32767, delta)));
+
+        std::memcpy(a.data.data(), &*p, sizeof(Pool));
+        return out;
+    }
+
+    if (a.type == AccountType::NPool) {
+        auto p = parse_npool(a.data.data(), a.data.size());
+        if (!p || p->is_paused() || p->n_tokens < 2 || p->n_tokens > MAX_TOKENS) return std::nullopt;
+        if (ev.from >= p->n_tokens || ev.to >= p->n_tokens || ev.from == ev.to) return std::nullopt;
+        auto out = math::simulate_swap_n(p->balances, p->n_tokens, ev.from, ev.to, ev.amount_in, p->amp, p->fee_bps);
+        if (!out || *out == 0 || *out >= p->balances[ev.to]) return std::nullopt;
+        p->balances[ev.from] += ev.amount_in;
+        p->balances[ev.to] -= *out;
+        p->total_volume += ev.amount_in;
+        p->trade_count++;
+        p->last_trade_slot = ev.slot;
+        std::memcpy(a.data.data(), &*p, sizeof(NPool));
+        return out;
+    }
+
+    return std::nullopt;
+}
+
+}  // namespace synthetic
+}  // namespace aex402
@@ -0,0 +1,186 @@
+/**
+ * AeX402 AMM C++ SDK - Ed25519 Tests
+ *
+ * Known-answer tests from RFC 8032 section 7.1, plus batch signing and
+ * verification checks. Exit status is the number of failed checks.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "aex402.hpp"
+
+using namespace aex402;
+using namespace aex402::ed25519;
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static std::vector<uint8_t> from_hex(const char* hex) {
+    std::vector<uint8_t> out;
+    auto nibble = [](char c) {
+        return static_cast<uint8_t>(c <= '9' ? c - '0' : c - 'a' + 10);
+    };
+    for (size_t i = 0; hex[i] && hex[i + 1]; i += 2) {
+        out.push_back(static_cast<uint8_t>(nibble(hex[i]) << 4 | nibble(hex[i + 1])));
+    }
+    return out;
+}
+
+// ============================================================================
+// RFC 8032 Vectors
+// ============================================================================
+
+struct Vector {
+    const char* name;
+    const char* secret;
+    const char* public_key;
+    const char* message;
+    const char* signature;
+};
+
+static const Vector RFC8032_VECTORS[] = {
+    {"TEST 1",
+     "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "",
+     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+    {"TEST 2",
+     "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+     "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+     "72",
+     "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+    {"TEST 3",
+     "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+     "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+     "af82",
+     "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"},
+    {"TEST SHA(abc)",
+     "833fe62409237b9d62ec77587520911e9a759cec1d19755b7da901b96dca3d42",
+     "ec172b93ad5e563bf4932c70e1245034c35467ef2efd4d64ebf819683467e2bf",
+     "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+     "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+     "dc2a4459e7369633a52b1bf277839a00201009a3efbf3ecb69bea2186c26b589"
+     "09351fc9ac90b3ecfdfbc7c66431e0303dca179c138ac17ad9bef1177331a704"},
+};
+
+/**
+ * Public key and signature bytes must match the RFC, and verify must
+ * accept the RFC signature.
+ */
+static void test_rfc8032_vectors() {
+    for (const auto& v : RFC8032_VECTORS) {
+        auto seed = from_hex(v.secret);
+        auto pk = from_hex(v.public_key);
+        auto msg = from_hex(v.message);
+        auto expected = from_hex(v.signature);
+
+        ExpandedKey key = ExpandedKey::from_seed(seed.data());
+        bool pk_ok = std::memcmp(key.public_key.data(), pk.data(), 32) == 0;
+        Signature sig = sign(key, msg);
+        bool sig_ok = std::memcmp(sig.data(), expected.data(), 64) == 0;
+        if (!pk_ok || !sig_ok) std::fprintf(stderr, "%s: %s mismatch\n", v.name, pk_ok ? "signature" : "public key");
+        CHECK(pk_ok);
+        CHECK(sig_ok);
+        CHECK(verify(key.public_key, msg.data(), msg.size(), sig));
+
+        // A Solana keypair is seed || public key
+        std::vector<uint8_t> keypair = seed;
+        keypair.insert(keypair.end(), pk.begin(), pk.end());
+        CHECK(ExpandedKey::from_keypair(keypair.data()).has_value());
+        keypair[63] ^= 1;
+        CHECK(!ExpandedKey::from_keypair(keypair.data()).has_value());
+    }
+}
+
+// ============================================================================
+// Batch Signing
+// ============================================================================
+
+/**
+ * sign_batch must produce the same bytes as sign, across chunk boundaries.
+ */
+static void test_sign_batch_matches_sign() {
+    auto seed = from_hex(RFC8032_VECTORS[2].secret);
+    ExpandedKey key = ExpandedKey::from_seed(seed.data());
+
+    std::vector<std::vector<uint8_t>> msgs;
+    for (size_t i = 0; i < 75; i++) {
+        std::vector<uint8_t> m(i * 7 % 300);
+        for (size_t j = 0; j < m.size(); j++) m[j] = static_cast<uint8_t>(i * 31 + j);
+        msgs.push_back(std::move(m));
+    }
+
+    auto batch = sign_batch(key, msgs);
+    CHECK(batch.size() == msgs.size());
+    for (size_t i = 0; i < msgs.size() && i < batch.size(); i++) {
+        CHECK(batch[i] == sign(key, msgs[i]));
+    }
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+// Group order L, little-endian
+static const uint8_t ORDER_L[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+/**
+ * verify must reject any flipped bit and a non-canonical S (S + L).
+ */
+static void test_verify_rejects_tampering() {
+    const Vector& v = RFC8032_VECTORS[1];
+    auto seed = from_hex(v.secret);
+    auto msg = from_hex(v.message);
+    ExpandedKey key = ExpandedKey::from_seed(seed.data());
+    Signature sig = sign(key, msg);
+    CHECK(verify(key.public_key, msg.data(), msg.size(), sig));
+
+    for (size_t bit = 0; bit < 512; bit += 37) {
+        Signature bad = sig;
+        bad[bit / 8] = static_cast<uint8_t>(bad[bit / 8] ^ (1u << (bit % 8)));
+        CHECK(!verify(key.public_key, msg.data(), msg.size(), bad));
+    }
+
+    std::vector<uint8_t> bad_msg = msg;
+    bad_msg[0] ^= 0x01;
+    CHECK(!verify(key.public_key, bad_msg.data(), bad_msg.size(), sig));
+
+    Pubkey bad_pk = key.public_key;
+    bad_pk[0] ^= 0x01;
+    CHECK(!verify(bad_pk, msg.data(), msg.size(), sig));
+
+    // S + L is the same scalar mod L but must not be accepted
+    Signature malleable = sig;
+    unsigned carry = 0;
+    for (size_t i = 0; i < 32; i++) {
+        unsigned s = malleable[32 + i] + ORDER_L[i] + carry;
+        malleable[32 + i] = static_cast<uint8_t>(s);
+        carry = s >> 8;
+    }
+    CHECK(carry == 0);
+    CHECK(!verify(key.public_key, msg.data(), msg.size(), malleable));
+}
+
+int main() {
+    test_rfc8032_vectors();
+    test_sign_batch_matches_sign();
+    test_verify_rejects_tampering();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+    } else {
+        std::printf("ed25519 tests passed\n");
+    }
+    return failures;
+}
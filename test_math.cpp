@@ -0,0 +1,189 @@
+/**
+ * AeX402 AMM C++ SDK - Math Tests
+ *
+ * Exit status is the number of failed checks.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "aex402.hpp"
+
+using namespace aex402;
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+// Deterministic xorshift64* so failures reproduce
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+static uint64_t next_u64() {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+static uint64_t next_range(uint64_t lo, uint64_t hi) { return lo + next_u64() % (hi - lo + 1); }
+
+// ============================================================================
+// N-token swaps
+// ============================================================================
+
+/**
+ * A 2-token NPool quote must equal the 2-token Pool quote. calc_y_n used to
+ * truncate its 128-bit c term to 64 bits, which broke every such quote for
+ * realistic balances.
+ */
+static void test_simulate_swap_n_matches_2pool() {
+    for (int i = 0; i < 2000; i++) {
+        uint64_t bal[2] = {next_range(1000000, 10000000000000ULL), 0};
+        bal[1] = next_range(bal[0] / 2, bal[0] * 2);
+        uint64_t amp = next_range(1, 5000);
+        uint64_t fee = next_range(0, 100);
+        uint64_t amount = next_range(1, bal[0] / 10);
+
+        auto a = math::simulate_swap(bal[0], bal[1], amount, amp, fee);
+        auto b = math::simulate_swap_n(bal, 2, 0, 1, amount, amp, fee);
+        CHECK(a.has_value() == b.has_value());
+        if (a && b) CHECK(*a == *b);
+    }
+}
+
+// ============================================================================
+// Fees and slippage limits
+// ============================================================================
+
+static uint64_t ref_mul_div(uint64_t a, uint64_t b, uint64_t d) {
+    __uint128_t q = static_cast<__uint128_t>(a) * b / d;
+    return q > UINT64_MAX ? UINT64_MAX : static_cast<uint64_t>(q);
+}
+
+/**
+ * mul_div must keep the full 128-bit product and saturate only the quotient.
+ */
+static void test_mul_div() {
+    CHECK(math::mul_div(UINT64_MAX, UINT64_MAX, UINT64_MAX) == UINT64_MAX);
+    CHECK(math::mul_div(UINT64_MAX, 9999, 10000) == ref_mul_div(UINT64_MAX, 9999, 10000));
+    CHECK(math::mul_div(UINT64_MAX, 2, 1) == UINT64_MAX);   // Quotient saturates
+    CHECK(math::mul_div(123, 456, 0) == 0);
+    for (int i = 0; i < 2000; i++) {
+        uint64_t a = next_u64(), b = next_u64() >> next_range(0, 63), d = next_range(1, UINT64_MAX);
+        CHECK(math::mul_div(a, b, d) == ref_mul_div(a, b, d));
+    }
+}
+
+/**
+ * Amounts above UINT64_MAX / 10000 used to overflow amount * fee_bps.
+ */
+static void test_calc_fee() {
+    CHECK(math::calc_fee(UINT64_MAX, 30) == ref_mul_div(UINT64_MAX, 30, 10000));
+    CHECK(math::calc_fee(10000000000000000000ULL, 9999) == 9999000000000000000ULL);
+    CHECK(math::calc_fee(1000000, 0) == 0);
+    CHECK(math::calc_fee(1000000, 10000) == 1000000);     // 100% fee
+    CHECK(math::calc_fee(UINT64_MAX, 10000) == UINT64_MAX);
+    CHECK(math::calc_fee(1000000, 20000) == 1000000);     // Above 100% is capped
+    CHECK(math::calc_fee(9999, 1) == 0);                  // Rounds down
+}
+
+static void test_calc_min_output() {
+    CHECK(math::calc_min_output(UINT64_MAX, 50) == ref_mul_div(UINT64_MAX, 9950, 10000));
+    CHECK(math::calc_min_output(10000000000000000000ULL, 100) == 9900000000000000000ULL);
+    CHECK(math::calc_min_output(1000000, 0) == 1000000);
+    CHECK(math::calc_min_output(1000000, 10000) == 0);    // 100% slippage
+    CHECK(math::calc_min_output(1000000, 65535) == 0);
+    CHECK(math::calc_min_output(10001, 1) == 9999);       // Rounds down
+}
+
+// ============================================================================
+// Swap limit patching
+// ============================================================================
+
+/**
+ * swap_limit_offsets must point at the min_out and deadline each
+ * InstructionBuilder encodes, and reject data shorter than min_len.
+ */
+static void test_swap_limit_offsets() {
+    const uint64_t MIN_OUT = 0x1122334455667788ULL;
+    const int64_t DEADLINE = 0x0102030405060708LL;
+    struct Case {
+        const char* name;
+        std::vector<uint8_t> data;
+        bool has_deadline;
+    };
+    const Case cases[] = {
+        {"swap",     InstructionBuilder::swap(0, 1, 1000, MIN_OUT, DEADLINE).build(), true},
+        {"swapt0t1", InstructionBuilder::swapt0t1(1000, MIN_OUT).build(), false},
+        {"swapt1t0", InstructionBuilder::swapt1t0(1000, MIN_OUT).build(), false},
+        {"swapn",    InstructionBuilder::swapn(2, 5, 1000, MIN_OUT).build(), false},
+        {"migt0t1",  InstructionBuilder::migt0t1(1000, MIN_OUT).build(), false},
+        {"migt1t0",  InstructionBuilder::migt1t0(1000, MIN_OUT).build(), false},
+        {"multihop", InstructionBuilder::multihop(1000, MIN_OUT, DEADLINE, {0, 1, 0}).build(), true},
+        {"clswap",   InstructionBuilder::clswap(1000, MIN_OUT, true).build(), false},
+    };
+
+    for (const auto& c : cases) {
+        auto o = swap_limit_offsets(c.data.data(), c.data.size());
+        if (!o) {
+            std::fprintf(stderr, "%s: swap_limit_offsets rejected the encoding\n", c.name);
+            failures++;
+            continue;
+        }
+        CHECK(o->min_len <= c.data.size());
+        CHECK(o->min_out + 8 <= o->min_len);
+        CHECK(aex402::detail::load_le<uint64_t>(c.data.data() + o->min_out) == MIN_OUT);
+        CHECK((o->deadline != 0) == c.has_deadline);
+        if (o->deadline) {
+            CHECK(o->deadline + 8 <= o->min_len);
+            CHECK(aex402::detail::load_le<int64_t>(c.data.data() + o->deadline) == DEADLINE);
+        }
+        CHECK(!swap_limit_offsets(c.data.data(), o->min_len - 1));
+
+        // Only min_out and the deadline change
+        std::vector<uint8_t> expected = c.data;
+        aex402::detail::store_le<uint64_t>(expected.data() + o->min_out, 42);
+        if (o->deadline) aex402::detail::store_le<int64_t>(expected.data() + o->deadline, 7);
+        std::vector<uint8_t> patched = c.data;
+        CHECK(patch_swap_limits(patched.data(), patched.size(), 42, int64_t{7}));
+        CHECK(patched == expected);
+    }
+
+    auto other = InstructionBuilder::flashloan(1, 2).build();
+    CHECK(!swap_limit_offsets(other.data(), other.size()));
+}
+
+/**
+ * Entries whose min_out would be 0 (zero quote, 100% slippage) are skipped.
+ */
+static void test_fill_swap_limits() {
+    std::vector<std::vector<uint8_t>> ixs;
+    for (int i = 0; i < 4; i++) ixs.push_back(InstructionBuilder::swapt0t1(1000, 1).build());
+    std::vector<uint64_t> quotes = {1000000, 0, 1000000, 1000000};
+    std::vector<uint64_t> slippage = {50, 50, 10000, 20000};
+    std::vector<uint8_t> patched;
+
+    CHECK(fill_swap_limits(ixs, quotes, slippage, {}, &patched) == 1);
+    CHECK(patched == std::vector<uint8_t>({1, 0, 0, 0}));
+    CHECK(aex402::detail::load_le<uint64_t>(ixs[0].data() + 16) == 995000);
+    for (size_t i = 1; i < 4; i++) CHECK(aex402::detail::load_le<uint64_t>(ixs[i].data() + 16) == 1);
+}
+
+int main() {
+    test_simulate_swap_n_matches_2pool();
+    test_mul_div();
+    test_calc_fee();
+    test_calc_min_output();
+    test_swap_limit_offsets();
+    test_fill_swap_limits();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+    } else {
+        std::printf("math tests passed\n");
+    }
+    return failures;
+}
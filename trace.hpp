@@ -0,0 +1,380 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Latency Histograms and Tracing Hooks
+ *
+ * - Histogram: log-linear buckets (HDR-style, 16 sub-buckets per power of
+ *   two, <= 6.25% relative error) with per-thread shards. Recording is a
+ *   few relaxed atomic adds on a cache line owned by the calling thread;
+ *   shards are merged only when a snapshot is taken.
+ * - Clock: TSC ticks on x86 (steady_clock nanoseconds elsewhere), with a
+ *   one-time calibration against steady_clock for reporting.
+ * - ScopedTimer / AEX402_TRACE_SCOPE: time a scope into a named histogram
+ *   from the global Registry.
+ *
+ * The SDK's hot paths (parse_*, simulate_swap*, InstructionBuilder
+ * factories, PDA seed builders, Ed25519 signing) carry AEX402_TRACE_SCOPE
+ * hooks. They compile to nothing unless AEX402_ENABLE_TRACING is defined
+ * before the first SDK include (or via -DAEX402_ENABLE_TRACING).
+ *
+ * Stage names are "<stage>.<function>": parse.*, quote.*, encode.*, pda.*,
+ * sign.*.
+ *
+ * Usage:
+ *   trace::Registry::global().for_each([](const std::string& name, const trace::Histogram& h) {
+ *       auto s = trace::summarize(h.snapshot());
+ *       printf("%s n=%llu p99=%.0fns\n", name.c_str(), (unsigned long long)s.count, s.p99_ns);
+ *   });
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AEX402_TRACE_HAVE_TSC 1
+#endif
+
+namespace aex402 {
+namespace trace {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+constexpr unsigned HIST_SUB_BITS = 4;
+constexpr size_t HIST_SUB = size_t(1) << HIST_SUB_BITS;
+constexpr unsigned HIST_MAX_BITS = 48;      // Values >= 2^48 share the last bucket
+constexpr size_t HIST_BUCKETS = (HIST_MAX_BITS - HIST_SUB_BITS + 1) * HIST_SUB;
+constexpr size_t HIST_SHARDS = 16;          // Threads beyond this share shards
+
+// ============================================================================
+// Bucketing
+// ============================================================================
+
+/**
+ * Bucket index for a value. Values below HIST_SUB are exact.
+ */
+inline size_t bucket_of(uint64_t v) {
+    if (v < HIST_SUB) return static_cast<size_t>(v);
+    unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(v));
+    if (msb >= HIST_MAX_BITS) return HIST_BUCKETS - 1;
+    unsigned shift = msb - HIST_SUB_BITS;
+    return (msb - HIST_SUB_BITS + 1) * HIST_SUB + static_cast<size_t>((v >> shift) & (HIST_SUB - 1));
+}
+
+/**
+ * Smallest value mapping to bucket i.
+ */
+inline uint64_t bucket_lower(size_t i) {
+    if (i < HIST_SUB) return i;
+    size_t magnitude = i / HIST_SUB;
+    uint64_t sub = i % HIST_SUB;
+    return (HIST_SUB + sub) << (magnitude - 1);
+}
+
+/**
+ * Largest value mapping to bucket i.
+ */
+inline uint64_t bucket_upper(size_t i) {
+    if (i < HIST_SUB) return i;
+    return bucket_lower(i) + (uint64_t(1) << (i / HIST_SUB - 1)) - 1;
+}
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+class Clock {
+public:
+    /**
+     * Current tick count (TSC on x86, steady_clock nanoseconds otherwise).
+     */
+    static uint64_t now() {
+#if defined(AEX402_TRACE_HAVE_TSC)
+        return __rdtsc();
+#else
+        return steady_ns();
+#endif
+    }
+
+    /**
+     * Nanoseconds per tick, calibrated once on first use.
+     */
+    static double ns_per_tick() {
+        static const double v = calibrate();
+        return v;
+    }
+
+    static double to_ns(uint64_t ticks) { return static_cast<double>(ticks) * ns_per_tick(); }
+
+    /**
+     * Measure ticks against steady_clock over a short busy-wait window.
+     */
+    static double calibrate(std::chrono::microseconds window = std::chrono::microseconds(10000)) {
+#if defined(AEX402_TRACE_HAVE_TSC)
+        uint64_t ns0 = steady_ns();
+        uint64_t t0 = now();
+        uint64_t target = ns0 + static_cast<uint64_t>(window.count()) * 1000;
+        uint64_t ns1 = ns0;
+        while (ns1 < target) ns1 = steady_ns();
+        uint64_t t1 = now();
+        if (t1 <= t0) return 1.0;
+        return static_cast<double>(ns1 - ns0) / static_cast<double>(t1 - t0);
+#else
+        (void)window;
+        return 1.0;
+#endif
+    }
+
+private:
+    static uint64_t steady_ns() {
+        auto d = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+};
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+namespace detail {
+
+// Stable per-thread shard index, assigned round-robin on first use
+inline size_t shard_index() {
+    static std::atomic<size_t> next{0};
+    thread_local size_t idx = next.fetch_add(1, std::memory_order_relaxed) % HIST_SHARDS;
+    return idx;
+}
+
+struct alignas(64) HistShard {
+    std::array<std::atomic<uint64_t>, HIST_BUCKETS> counts;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> min;
+    std::atomic<uint64_t> max;
+
+    HistShard() { reset(); }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        min.store(UINT64_MAX, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * Merged view of a histogram at one point in time.
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts = std::vector<uint64_t>(HIST_BUCKETS, 0);
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+
+    double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+    /**
+     * Value at quantile q in [0, 1]: upper bound of the bucket holding
+     * the ceil(q * count)-th value, clamped to [min, max].
+     */
+    uint64_t percentile(double q) const {
+        if (count == 0) return 0;
+        if (q <= 0.0) return min;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.999999);
+        if (rank > count) rank = count;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < HIST_BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint64_t v = bucket_upper(i);
+                return v < min ? min : (v > max ? max : v);
+            }
+        }
+        return max;
+    }
+};
+
+/**
+ * Concurrent histogram of unsigned values (ticks for timers).
+ * Shards are allocated on first record from their threads.
+ */
+class Histogram {
+public:
+    Histogram() {
+        for (auto& s : shards_) s.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~Histogram() {
+        for (auto& s : shards_) delete s.load(std::memory_order_relaxed);
+    }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t v) {
+        detail::HistShard& s = shard();
+        s.counts[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        s.sum.fetch_add(v, std::memory_order_relaxed);
+        // Plain load/store: only threads sharing a shard can lose an update
+        if (v < s.min.load(std::memory_order_relaxed)) s.min.store(v, std::memory_order_relaxed);
+        if (v > s.max.load(std::memory_order_relaxed)) s.max.store(v, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot out;
+        uint64_t lo = UINT64_MAX;
+        for (const auto& p : shards_) {
+            const detail::HistShard* s = p.load(std::memory_order_acquire);
+            if (!s) continue;
+            for (size_t i = 0; i < HIST_BUCKETS; i++) {
+                uint64_t c = s->counts[i].load(std::memory_order_relaxed);
+                out.counts[i] += c;
+                out.count += c;
+            }
+            out.sum += s->sum.load(std::memory_order_relaxed);
+            lo = std::min(lo, s->min.load(std::memory_order_relaxed));
+            out.max = std::max(out.max, s->max.load(std::memory_order_relaxed));
+        }
+        out.min = out.count ? lo : 0;
+        return out;
+    }
+
+    /**
+     * Clear all shards. Records racing with reset may survive it.
+     */
+    void reset() {
+        for (auto& p : shards_) {
+            if (detail::HistShard* s = p.load(std::memory_order_acquire)) s->reset();
+        }
+    }
+
+private:
+    std::array<std::atomic<detail::HistShard*>, HIST_SHARDS> shards_;
+
+    detail::HistShard& shard() {
+        auto& slot = shards_[detail::shard_index()];
+        detail::HistShard* s = slot.load(std::memory_order_acquire);
+        if (s) return *s;
+        auto* fresh = new detail::HistShard();
+        if (slot.compare_exchange_strong(s, fresh, std::memory_order_acq_rel)) return *fresh;
+        delete fresh;
+        return *s;
+    }
+};
+
+/**
+ * Latency summary of a tick histogram, in nanoseconds.
+ */
+struct LatencySummary {
+    uint64_t count;
+    double mean_ns;
+    double min_ns;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
+inline LatencySummary summarize(const HistogramSnapshot& s) {
+    return LatencySummary{
+        s.count,
+        s.mean() * Clock::ns_per_tick(),
+        Clock::to_ns(s.min),
+        Clock::to_ns(s.percentile(0.50)),
+        Clock::to_ns(s.percentile(0.90)),
+        Clock::to_ns(s.percentile(0.99)),
+        Clock::to_ns(s.percentile(0.999)),
+        Clock::to_ns(s.max),
+    };
+}
+
+// ============================================================================
+// Registry and Scoped Timers
+// ============================================================================
+
+/**
+ * Named histograms. Lookups lock; hook sites cache the reference in a
+ * function-local static so the lock is only taken once per site.
+ */
+class Registry {
+public:
+    static Registry& global() {
+        static Registry r;
+        return r;
+    }
+
+    Histogram& get(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto& h = map_[name];
+        if (!h) h = std::make_unique<Histogram>();
+        return *h;
+    }
+
+    /**
+     * Visit every histogram in name order: fn(const std::string&, const Histogram&).
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const auto& [name, h] : map_) fn(name, *h);
+    }
+
+    void reset_all() {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (auto& entry : map_) entry.second->reset();
+    }
+
+private:
+    mutable std::mutex mu_;
+    std::map<std::string, std::unique_ptr<Histogram>> map_;
+};
+
+inline Histogram& histogram(const char* name) { return Registry::global().get(name); }
+
+/**
+ * Records the ticks spent in its scope.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& h) : h_(h), start_(Clock::now()) {}
+    ~ScopedTimer() { h_.record(Clock::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& h_;
+    uint64_t start_;
+};
+
+}  // namespace trace
+}  // namespace aex402
+
+// ============================================================================
+// Hook Macro
+// ============================================================================
+
+#if defined(AEX402_ENABLE_TRACING)
+#define AEX402_TRACE_CONCAT_(a, b) a##b
+#define AEX402_TRACE_CONCAT(a, b) AEX402_TRACE_CONCAT_(a, b)
+#define AEX402_TRACE_SCOPE(name)                                                          \
+    static ::aex402::trace::Histogram& AEX402_TRACE_CONCAT(aex402_trace_hist_, __LINE__) = \
+        ::aex402::trace::histogram(name);                                                 \
+    ::aex402::trace::ScopedTimer AEX402_TRACE_CONCAT(aex402_trace_timer_, __LINE__)(      \
+        AEX402_TRACE_CONCAT(aex402_trace_hist_, __LINE__))
+#else
+#define AEX402_TRACE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,373 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Transaction Sizing and Packing
+ *
+ * Legacy message layout (what the sizer counts):
+ *   header[3]
+ *   compact-u16 key_count, key_count * 32-byte keys
+ *   recent_blockhash[32]
+ *   compact-u16 ix_count, per instruction:
+ *     program_id_index u8, compact-u16 n, n * u8 account indices,
+ *     compact-u16 len, len data bytes
+ * Transaction = compact-u16 sig_count, sig_count * 64-byte signatures, message.
+ *
+ * MessageSizer tracks the exact serialized size as instructions are
+ * added, deduplicating keys and merging signer/writable flags.
+ * pack_instructions splits an ordered instruction list into the fewest
+ * transactions under the packet size limit and a CU budget.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <optional>
+#include <vector>
+#include "constants.hpp"
+#include "types.hpp"
+#include "pubkey_map.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+constexpr size_t PACKET_DATA_SIZE = 1232;      // Max serialized transaction bytes
+constexpr size_t MAX_TX_ACCOUNT_LOCKS = 64;    // Runtime account lock limit
+constexpr size_t MAX_MESSAGE_KEYS = 256;       // u8 account indices
+constexpr size_t SIGNATURE_SIZE = 64;
+
+// ============================================================================
+// Instruction Types
+// ============================================================================
+
+/**
+ * Account reference for an instruction.
+ */
+struct AccountMeta {
+    Pubkey pubkey;
+    bool is_signer;
+    bool is_writable;
+
+    static AccountMeta writable(const Pubkey& key, bool signer = false) {
+        return AccountMeta{key, signer, true};
+    }
+
+    static AccountMeta readonly(const Pubkey& key, bool signer = false) {
+        return AccountMeta{key, signer, false};
+    }
+};
+
+/**
+ * Instruction ready to be placed in a message.
+ */
+struct Instruction {
+    Pubkey program_id;
+    std::vector<AccountMeta> accounts;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Encoded length of a compact-u16 (1-3 bytes).
+ */
+inline constexpr size_t compact_u16_len(size_t v) {
+    return v < 0x80 ? 1 : (v < 0x4000 ? 2 : 3);
+}
+
+inline void write_compact_u16(std::vector<uint8_t>& out, size_t v) {
+    uint32_t rem = static_cast<uint32_t>(v);
+    while (true) {
+        uint8_t byte = static_cast<uint8_t>(rem & 0x7F);
+        rem >>= 7;
+        if (rem == 0) {
+            out.push_back(byte);
+            return;
+        }
+        out.push_back(static_cast<uint8_t>(byte | 0x80));
+    }
+}
+
+/**
+ * Serialized size of one compiled instruction inside a message.
+ */
+inline size_t compiled_instruction_size(const Instruction& ix) {
+    return 1
+        + compact_u16_len(ix.accounts.size()) + ix.accounts.size()
+        + compact_u16_len(ix.data.size()) + ix.data.size();
+}
+
+// ============================================================================
+// MessageSizer
+// ============================================================================
+
+/**
+ * Incremental exact size of a legacy transaction.
+ * The fee payer is always the first key (writable signer).
+ */
+class MessageSizer {
+public:
+    explicit MessageSizer(const Pubkey& fee_payer, size_t max_keys = MAX_TX_ACCOUNT_LOCKS)
+        : max_keys_(std::min(max_keys, MAX_MESSAGE_KEYS)) {
+        keys_.reserve(32);
+        keys_.insert_or_assign(fee_payer, FLAG_SIGNER | FLAG_WRITABLE);
+        num_signers_ = 1;
+    }
+
+    size_t num_keys() const { return keys_.size(); }
+    size_t num_signers() const { return num_signers_; }
+    size_t num_instructions() const { return num_instructions_; }
+
+    size_t message_size() const {
+        return message_size_for(keys_.size(), num_instructions_, instruction_bytes_);
+    }
+
+    size_t transaction_size() const {
+        return transaction_size_for(num_signers_, message_size());
+    }
+
+    /**
+     * Transaction size if ix were added (nullopt if it would exceed max_keys).
+     */
+    std::optional<size_t> size_with(const Instruction& ix) const {
+        Delta d = delta(ix);
+        if (keys_.size() + d.new_keys > max_keys_) return std::nullopt;
+        return transaction_size_for(
+            num_signers_ + d.new_signers,
+            message_size_for(keys_.size() + d.new_keys, num_instructions_ + 1,
+                             instruction_bytes_ + compiled_instruction_size(ix)));
+    }
+
+    /**
+     * Add ix if the transaction stays within max_bytes. Returns true if added.
+     */
+    bool try_add(const Instruction& ix, size_t max_bytes = PACKET_DATA_SIZE) {
+        auto size = size_with(ix);
+        if (!size || *size > max_bytes) return false;
+        add(ix);
+        return true;
+    }
+
+    /**
+     * Add ix unconditionally.
+     */
+    void add(const Instruction& ix) {
+        merge(ix.program_id, 0);
+        for (const auto& meta : ix.accounts) {
+            merge(meta.pubkey, static_cast<uint8_t>((meta.is_signer ? FLAG_SIGNER : 0) |
+                                                    (meta.is_writable ? FLAG_WRITABLE : 0)));
+        }
+        instruction_bytes_ += compiled_instruction_size(ix);
+        num_instructions_++;
+    }
+
+private:
+    static constexpr uint8_t FLAG_SIGNER = 1;
+    static constexpr uint8_t FLAG_WRITABLE = 2;
+
+    struct Delta {
+        size_t new_keys;
+        size_t new_signers;
+    };
+
+    struct SeenKey {
+        Pubkey key;
+        bool   signer;
+    };
+
+    PubkeyMap<uint8_t> keys_;
+    // Scratch for delta(), reused so sizing does not put 8 KiB on the stack
+    // per call; a sizer is not shared between threads.
+    mutable std::vector<SeenKey> seen_;
+    size_t max_keys_;
+    size_t num_signers_ = 0;
+    size_t num_instructions_ = 0;
+    size_t instruction_bytes_ = 0;
+
+    static size_t message_size_for(size_t keys, size_t ixs, size_t ix_bytes) {
+        return 3 + compact_u16_len(keys) + keys * 32 + 32 + compact_u16_len(ixs) + ix_bytes;
+    }
+
+    static size_t transaction_size_for(size_t signers, size_t message) {
+        return compact_u16_len(signers) + signers * SIGNATURE_SIZE + message;
+    }
+
+    void merge(const Pubkey& key, uint8_t flags) {
+        auto [slot, inserted] = keys_.try_emplace(key, flags);
+        if (inserted) {
+            if (flags & FLAG_SIGNER) num_signers_++;
+            return;
+        }
+        if ((flags & FLAG_SIGNER) && !(*slot & FLAG_SIGNER)) num_signers_++;
+        *slot = static_cast<uint8_t>(*slot | flags);
+    }
+
+    Delta delta(const Instruction& ix) const {
+        // Keys first seen in this instruction; instructions reference few
+        // accounts, so a linear scan beats a second hash set.
+        std::vector<SeenKey>& seen = seen_;
+        seen.clear();
+        Delta d{0, 0};
+
+        auto visit = [&](const Pubkey& key, bool signer) {
+            const uint8_t* existing = keys_.find(key);
+            if (existing) {
+                if (signer && !(*existing & FLAG_SIGNER)) {
+                    for (const auto& s : seen) {
+                        if (s.signer && pubkey_eq(s.key, key)) return;
+                    }
+                    seen.push_back({key, true});
+                    d.new_signers++;
+                }
+                return;
+            }
+            for (auto& s : seen) {
+                if (pubkey_eq(s.key, key)) {
+                    if (signer && !s.signer) {
+                        s.signer = true;
+                        d.new_signers++;
+                    }
+                    return;
+                }
+            }
+            seen.push_back({key, signer});
+            d.new_keys++;
+            if (signer) d.new_signers++;
+        };
+
+        visit(ix.program_id, false);
+        for (const auto& meta : ix.accounts) visit(meta.pubkey, meta.is_signer);
+        return d;
+    }
+};
+
+// ============================================================================
+// Message Compilation
+// ============================================================================
+
+/**
+ * Serialize a legacy message.
+ * Key order: fee payer, writable signers, readonly signers, writable
+ * non-signers, readonly non-signers; sorted by key within each group.
+ * Returns nullopt if the message references more than 256 keys.
+ */
+inline std::optional<std::vector<uint8_t>> compile_message(
+    const Pubkey& fee_payer, const std::vector<Instruction>& ixs, const Pubkey& recent_blockhash) {
+    struct Entry {
+        Pubkey key;
+        uint8_t flags;  // bit 0 signer, bit 1 writable
+    };
+
+    PubkeyMap<uint8_t> flags;
+    flags.insert_or_assign(fee_payer, 3);
+    for (const auto& ix : ixs) {
+        flags.try_emplace(ix.program_id, 0);
+        for (const auto& meta : ix.accounts) {
+            uint8_t& f = flags[meta.pubkey];
+            f = static_cast<uint8_t>(f | (meta.is_signer ? 1 : 0) | (meta.is_writable ? 2 : 0));
+        }
+    }
+    if (flags.size() > MAX_MESSAGE_KEYS) return std::nullopt;
+
+    std::vector<Entry> entries;
+    entries.reserve(flags.size());
+    flags.for_each([&](const Pubkey& k, uint8_t f) {
+        if (!pubkey_eq(k, fee_payer)) entries.push_back(Entry{k, f});
+    });
+    // Group rank: 0 writable signer, 1 readonly signer, 2 writable, 3 readonly
+    auto rank = [](uint8_t f) { return (f & 1 ? 0 : 2) + (f & 2 ? 0 : 1); };
+    std::sort(entries.begin(), entries.end(), [&](const Entry& a, const Entry& b) {
+        int ra = rank(a.flags), rb = rank(b.flags);
+        return ra != rb ? ra < rb : a.key < b.key;
+    });
+    entries.insert(entries.begin(), Entry{fee_payer, 3});
+
+    uint8_t header[3] = {0, 0, 0};
+    PubkeyMap<uint8_t> index;
+    index.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        uint8_t f = entries[i].flags;
+        if (f & 1) {
+            header[0]++;
+            if (!(f & 2)) header[1]++;
+        } else if (!(f & 2)) {
+            header[2]++;
+        }
+        index.insert_or_assign(entries[i].key, static_cast<uint8_t>(i));
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(PACKET_DATA_SIZE);
+    out.insert(out.end(), header, header + 3);
+    write_compact_u16(out, entries.size());
+    for (const auto& e : entries) out.insert(out.end(), e.key.begin(), e.key.end());
+    out.insert(out.end(), recent_blockhash.begin(), recent_blockhash.end());
+
+    write_compact_u16(out, ixs.size());
+    for (const auto& ix : ixs) {
+        out.push_back(*index.find(ix.program_id));
+        write_compact_u16(out, ix.accounts.size());
+        for (const auto& meta : ix.accounts) out.push_back(*index.find(meta.pubkey));
+        write_compact_u16(out, ix.data.size());
+        out.insert(out.end(), ix.data.begin(), ix.data.end());
+    }
+    return out;
+}
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+/**
+ * Limits and per-transaction overhead for pack_instructions.
+ */
+struct PackOptions {
+    size_t max_bytes = PACKET_DATA_SIZE;
+    size_t max_keys = MAX_TX_ACCOUNT_LOCKS;
+    uint32_t max_cu = MAX_COMPUTE_UNIT_LIMIT;
+    std::vector<Instruction> prefix;   // Added to every transaction (e.g. compute budget)
+    uint32_t prefix_cu = 0;            // CU consumed by the prefix instructions
+};
+
+/**
+ * Split an ordered instruction list into consecutive groups, each fitting
+ * in one transaction. Returns [begin, end) index ranges.
+ *
+ * Size, key count and CU only grow as instructions are appended, so
+ * filling each transaction greedily before starting the next yields the
+ * minimum number of transactions for an order-preserving split.
+ *
+ * cu may be empty (no CU limit) or hold one estimate per instruction.
+ * Returns nullopt if some instruction does not fit in a transaction alone.
+ */
+inline std::optional<std::vector<std::pair<size_t, size_t>>> pack_instructions(
+    const Pubkey& fee_payer, const std::vector<Instruction>& ixs,
+    const std::vector<uint32_t>& cu = {}, const PackOptions& opts = {}) {
+    std::vector<std::pair<size_t, size_t>> groups;
+    bool use_cu = !cu.empty();
+    if (use_cu && cu.size() != ixs.size()) return std::nullopt;
+
+    auto fresh = [&]() {
+        MessageSizer sizer(fee_payer, opts.max_keys);
+        for (const auto& ix : opts.prefix) sizer.add(ix);
+        return sizer;
+    };
+
+    size_t begin = 0;
+    while (begin < ixs.size()) {
+        MessageSizer sizer = fresh();
+        uint64_t used_cu = opts.prefix_cu;
+        size_t end = begin;
+        while (end < ixs.size()) {
+            if (use_cu && used_cu + cu[end] > opts.max_cu) break;
+            if (!sizer.try_add(ixs[end], opts.max_bytes)) break;
+            if (use_cu) used_cu += cu[end];
+            end++;
+        }
+        if (end == begin) return std::nullopt;
+        groups.emplace_back(begin, end);
+        begin = end;
+    }
+    return groups;
+}
+
+}  // namespace aex402
@@ -10,8 +10,14 @@
 #include <array>
 #include <vector>
 #include <cstring>
+#include <cstddef>
+#include <type_traits>
 #include "constants.hpp"
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 namespace aex402 {
 
 // ============================================================================
@@ -45,6 +51,53 @@ struct U128 {
     bool is_zero() const { return lo == 0 && hi == 0; }
 };
 
+// ============================================================================
+// Alignment-Safe Little-Endian Loads
+// ============================================================================
+
+namespace detail {
+
+/**
+ * Load a trivially-copyable value from possibly unaligned memory.
+ * Integers are stored little-endian on-chain and byte-swapped on
+ * big-endian hosts. Compiles to a single move on x86-64/AArch64.
+ */
+template <typename T>
+inline T load_le(const void* p) {
+    static_assert(std::is_trivially_copyable_v<T>, "load_le requires a trivially copyable type");
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if constexpr (std::is_integral_v<T> && sizeof(T) > 1) {
+        uint8_t b[sizeof(T)];
+        std::memcpy(b, &v, sizeof(T));
+        for (size_t i = 0; i < sizeof(T) / 2; i++) {
+            uint8_t t = b[i];
+            b[i] = b[sizeof(T) - 1 - i];
+            b[sizeof(T) - 1 - i] = t;
+        }
+        std::memcpy(&v, b, sizeof(T));
+    }
+#endif
+    return v;
+}
+
+/**
+ * Store a value to possibly unaligned memory in little-endian order.
+ */
+template <typename T>
+inline void store_le(void* p, T v) {
+    static_assert(std::is_trivially_copyable_v<T>, "store_le requires a trivially copyable type");
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if constexpr (std::is_integral_v<T> && sizeof(T) > 1) {
+        v = load_le<T>(&v);
+    }
+#endif
+    std::memcpy(p, &v, sizeof(T));
+}
+
+}  // namespace detail
+
 // ============================================================================
 // Delta-encoded OHLCV Candle (12 bytes)
 // ============================================================================
@@ -149,7 +202,7 @@ struct Pool {
 
     // Validation
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::POOL;
+        return detail::load_le<uint64_t>(disc) == account_disc::POOL;
     }
 
     bool is_paused() const { return paused != 0; }
@@ -171,7 +224,7 @@ struct Pool {
 
     // Get discriminator as u64
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -202,13 +255,13 @@ struct NPool {
     uint64_t last_trade_slot;       // Slot of last trade
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::NPOOL;
+        return detail::load_le<uint64_t>(disc) == account_disc::NPOOL;
     }
 
     bool is_paused() const { return paused != 0; }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -230,7 +283,7 @@ struct Farm {
     int64_t  last_update;       // Last update timestamp
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::FARM;
+        return detail::load_le<uint64_t>(disc) == account_disc::FARM;
     }
 
     bool is_active(int64_t now) const {
@@ -238,7 +291,7 @@ struct Farm {
     }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -257,7 +310,7 @@ struct UserFarm {
     int64_t  lock_end;          // Lock expiration timestamp
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::UFARM;
+        return detail::load_le<uint64_t>(disc) == account_disc::UFARM;
     }
 
     bool is_locked(int64_t now) const {
@@ -265,7 +318,7 @@ struct UserFarm {
     }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -290,7 +343,7 @@ struct Lottery {
     uint8_t  _pad[6];           // Alignment
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::LOTTERY;
+        return detail::load_le<uint64_t>(disc) == account_disc::LOTTERY;
     }
 
     bool is_drawn() const { return drawn != 0; }
@@ -298,7 +351,7 @@ struct Lottery {
     bool is_ended(int64_t now) const { return now >= end_time; }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -316,7 +369,7 @@ struct LotteryEntry {
     uint64_t ticket_count;      // Number of tickets
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::LOTENTRY;
+        return detail::load_le<uint64_t>(disc) == account_disc::LOTENTRY;
     }
 
     bool is_winner(uint64_t winning_ticket) const {
@@ -325,7 +378,7 @@ struct LotteryEntry {
     }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -345,11 +398,11 @@ struct Registry {
     // Pools array follows (variable length)
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::REGISTRY;
+        return detail::load_le<uint64_t>(disc) == account_disc::REGISTRY;
     }
 
     uint64_t discriminator() const {
-        return *reinterpret_cast<const uint64_t*>(disc);
+        return detail::load_le<uint64_t>(disc);
     }
 };
 #pragma pack(pop)
@@ -376,7 +429,7 @@ struct GovProposal {
     uint8_t  description[64];   // Short description
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::GOVPROP;
+        return detail::load_le<uint64_t>(disc) == account_disc::GOVPROP;
     }
 
     bool can_execute(int64_t now_slot) const {
@@ -411,7 +464,7 @@ struct GovVote {
     uint8_t  _pad[7];           // Alignment
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::GOVVOTE;
+        return detail::load_le<uint64_t>(disc) == account_disc::GOVVOTE;
     }
 
     bool voted_for() const { return vote_for != 0; }
@@ -440,7 +493,7 @@ struct CLPool {
     uint8_t  reserved[256];     // Reserved for future use
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::CLPOOL;
+        return detail::load_le<uint64_t>(disc) == account_disc::CLPOOL;
     }
 
     bool is_initialized() const { return initialized != 0; }
@@ -467,7 +520,7 @@ struct CLPosition {
     int64_t  created_at;        // Creation timestamp (for JIT protection)
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::CLPOS;
+        return detail::load_le<uint64_t>(disc) == account_disc::CLPOS;
     }
 
     // Check if position meets minimum duration for fee collection
@@ -514,7 +567,7 @@ struct Orderbook {
     Order    orders[MAX_ORDERS]; // Order array
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::BOOK;
+        return detail::load_le<uint64_t>(disc) == account_disc::BOOK;
     }
 };
 #pragma pack(pop)
@@ -587,7 +640,7 @@ struct MLBrain {
     // Observation buffer follows
 
     bool is_valid() const {
-        return *reinterpret_cast<const uint64_t*>(disc) == account_disc::MLBRAIN;
+        return detail::load_le<uint64_t>(disc) == account_disc::MLBRAIN;
     }
 
     bool is_enabled() const { return enabled != 0; }
@@ -621,10 +674,26 @@ struct TwapResult {
 // ============================================================================
 
 /**
- * Compare two pubkeys for equality
+ * Compare two pubkeys for equality.
+ * Uses a single 256-bit (AVX2) or two 128-bit (SSE2) compares when available.
  */
 inline bool pubkey_eq(const Pubkey& a, const Pubkey& b) {
-    return std::memcmp(a.data(), b.data(), 32) == 0;
+#if defined(__AVX2__)
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data()));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data()));
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)) == -1;
+#elif defined(__SSE2__)
+    __m128i lo = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data())),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data())));
+    __m128i hi = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + 16)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + 16)));
+    return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xFFFF;
+#else
+    uint64_t wa[4], wb[4];
+    std::memcpy(wa, a.data(), 32);
+    std::memcpy(wb, b.data(), 32);
+    return ((wa[0] ^ wb[0]) | (wa[1] ^ wb[1]) | (wa[2] ^ wb[2]) | (wa[3] ^ wb[3])) == 0;
+#endif
 }
 
 /**
@@ -639,12 +708,42 @@ inline Pubkey pubkey_zero() {
  * Check if pubkey is zero
  */
 inline bool pubkey_is_zero(const Pubkey& pk) {
-    for (auto b : pk) {
-        if (b != 0) return false;
-    }
-    return true;
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pk.data()));
+    return _mm256_testz_si256(v, v) != 0;
+#elif defined(__SSE2__)
+    __m128i v = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pk.data())),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(pk.data() + 16)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF;
+#else
+    uint64_t w[4];
+    std::memcpy(w, pk.data(), 32);
+    return (w[0] | w[1] | w[2] | w[3]) == 0;
+#endif
 }
 
+/**
+ * Hash functor for Pubkey.
+ * Pubkeys are SHA256 outputs or Ed25519 points and already uniformly
+ * distributed, so the first 8 bytes are used directly.
+ */
+struct PubkeyHash {
+    size_t operator()(const Pubkey& pk) const {
+        uint64_t h;
+        std::memcpy(&h, pk.data(), sizeof(h));
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * Equality functor for Pubkey (for use with hashed containers).
+ */
+struct PubkeyEq {
+    bool operator()(const Pubkey& a, const Pubkey& b) const {
+        return pubkey_eq(a, b);
+    }
+};
+
 /**
  * Copy pubkey
  */
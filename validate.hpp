@@ -0,0 +1,335 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Snapshot Validation
+ *
+ * Integrity checks over a bulk-loaded set of raw accounts.
+ * Accounts are inspected in place through the zero-copy views, and large
+ * snapshots are split across worker threads.
+ *
+ * Example:
+ *   std::vector<AccountData> accounts = ...;  // from getProgramAccounts
+ *   auto report = validate_snapshot(accounts.data(), accounts.size());
+ *   for (const auto& issue : report.issues) {
+ *       if (issue.has(Anomaly::ZeroBalance)) { ... }
+ *   }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "types.hpp"
+#include "constants.hpp"
+#include "accounts.hpp"
+#include "math.hpp"
+
+namespace aex402 {
+
+// ============================================================================
+// Anomaly Categories
+// ============================================================================
+
+/**
+ * Anomaly categories reported per account (bit flags).
+ */
+enum class Anomaly : uint32_t {
+    None           = 0,
+    Truncated      = 1u << 0,  // Buffer shorter than the account layout
+    UnknownType    = 1u << 1,  // Discriminator not recognized
+    TokenCount     = 1u << 2,  // NPool n_tokens outside 2..MAX_TOKENS
+    AmpRange       = 1u << 3,  // amp or target_amp outside MIN_AMP..MAX_AMP
+    ZeroBalance    = 1u << 4,  // Active pool holding a zero balance
+    PubkeyMismatch = 1u << 5,  // Zero, duplicate or aliased mint/vault keys
+    FeeRange       = 1u << 6,  // fee_bps or admin_fee_pct out of range
+    LpSupply       = 1u << 7,  // Balances without LP supply
+    RampWindow     = 1u << 8,  // ramp_stop before ramp_start
+    TimeWindow     = 1u << 9,  // Farm end_time before start_time
+};
+
+constexpr size_t ANOMALY_CATEGORIES = 10;
+
+inline constexpr uint32_t operator|(Anomaly a, Anomaly b) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b);
+}
+
+inline constexpr uint32_t operator|(uint32_t a, Anomaly b) {
+    return a | static_cast<uint32_t>(b);
+}
+
+/**
+ * Get anomaly category name as string.
+ */
+inline const char* anomaly_name(Anomaly a) {
+    switch (a) {
+        case Anomaly::None:           return "None";
+        case Anomaly::Truncated:      return "Truncated";
+        case Anomaly::UnknownType:    return "UnknownType";
+        case Anomaly::TokenCount:     return "TokenCount";
+        case Anomaly::AmpRange:       return "AmpRange";
+        case Anomaly::ZeroBalance:    return "ZeroBalance";
+        case Anomaly::PubkeyMismatch: return "PubkeyMismatch";
+        case Anomaly::FeeRange:       return "FeeRange";
+        case Anomaly::LpSupply:       return "LpSupply";
+        case Anomaly::RampWindow:     return "RampWindow";
+        case Anomaly::TimeWindow:     return "TimeWindow";
+        default:                      return "Unknown";
+    }
+}
+
+// ============================================================================
+// Report Types
+// ============================================================================
+
+/**
+ * Anomalies found in a single account.
+ */
+struct ValidationIssue {
+    size_t index;           // Index into the input account array
+    AccountType type;       // Detected account type
+    uint32_t anomalies;     // Bitwise OR of Anomaly flags
+
+    bool has(Anomaly a) const { return (anomalies & static_cast<uint32_t>(a)) != 0; }
+};
+
+/**
+ * Result of validating a snapshot.
+ */
+struct ValidationReport {
+    size_t accounts_checked = 0;
+    std::vector<ValidationIssue> issues;               // Sorted by index
+    std::array<size_t, ANOMALY_CATEGORIES> counts{};   // Per category, by bit position
+
+    bool ok() const { return issues.empty(); }
+
+    size_t count(Anomaly a) const {
+        uint32_t bits = static_cast<uint32_t>(a);
+        for (size_t i = 0; i < ANOMALY_CATEGORIES; i++) {
+            if (bits == (1u << i)) return counts[i];
+        }
+        return 0;
+    }
+};
+
+// ============================================================================
+// Per-Account Checks
+// ============================================================================
+
+namespace detail {
+
+inline uint32_t validate_pool(const PoolView& v) {
+    uint32_t out = 0;
+
+    if (!math::check_amp(v.amp()) || !math::check_amp(v.target_amp())) out = out | Anomaly::AmpRange;
+    if (v.fee_bps() >= math::FEE_DENOMINATOR || v.admin_fee_pct() > MAX_ADMIN_FEE_PCT) out = out | Anomaly::FeeRange;
+    if (v.ramp_stop() < v.ramp_start()) out = out | Anomaly::RampWindow;
+
+    uint64_t bal0 = v.bal0();
+    uint64_t bal1 = v.bal1();
+    uint64_t lp = v.lp_supply();
+    if (!v.is_paused() && lp > 0 && (bal0 == 0 || bal1 == 0)) out = out | Anomaly::ZeroBalance;
+    if (lp == 0 && (bal0 > 0 || bal1 > 0)) out = out | Anomaly::LpSupply;
+
+    Pubkey mint0 = v.mint0();
+    Pubkey mint1 = v.mint1();
+    Pubkey vault0 = v.vault0();
+    Pubkey vault1 = v.vault1();
+    Pubkey lp_mint = v.lp_mint();
+    const Pubkey* keys[5] = {&mint0, &mint1, &vault0, &vault1, &lp_mint};
+
+    bool bad = false;
+    for (size_t i = 0; i < 5 && !bad; i++) {
+        if (pubkey_is_zero(*keys[i])) bad = true;
+        for (size_t j = i + 1; j < 5 && !bad; j++) {
+            if (pubkey_eq(*keys[i], *keys[j])) bad = true;
+        }
+    }
+    if (bad) out = out | Anomaly::PubkeyMismatch;
+
+    return out;
+}
+
+inline uint32_t validate_npool(const NPoolView& v) {
+    uint32_t out = 0;
+
+    uint8_t n = v.n_tokens();
+    if (n < 2 || n > MAX_TOKENS) {
+        // Remaining checks index by n_tokens; stop here
+        return out | Anomaly::TokenCount;
+    }
+
+    if (!math::check_amp(v.amp())) out = out | Anomaly::AmpRange;
+    if (v.fee_bps() >= math::FEE_DENOMINATOR || v.admin_fee_pct() > MAX_ADMIN_FEE_PCT) out = out | Anomaly::FeeRange;
+
+    uint64_t lp = v.lp_supply();
+    bool any_zero = false;
+    bool any_nonzero = false;
+    for (uint8_t i = 0; i < n; i++) {
+        if (v.balance(i) == 0) any_zero = true;
+        else any_nonzero = true;
+    }
+    if (!v.is_paused() && lp > 0 && any_zero) out = out | Anomaly::ZeroBalance;
+    if (lp == 0 && any_nonzero) out = out | Anomaly::LpSupply;
+
+    Pubkey keys[2 * MAX_TOKENS + 1];
+    size_t count = 0;
+    for (uint8_t i = 0; i < n; i++) keys[count++] = v.mint(i);
+    for (uint8_t i = 0; i < n; i++) keys[count++] = v.vault(i);
+    keys[count++] = v.lp_mint();
+
+    bool bad = false;
+    for (size_t i = 0; i < count && !bad; i++) {
+        if (pubkey_is_zero(keys[i])) bad = true;
+        for (size_t j = i + 1; j < count && !bad; j++) {
+            if (pubkey_eq(keys[i], keys[j])) bad = true;
+        }
+    }
+    if (bad) out = out | Anomaly::PubkeyMismatch;
+
+    return out;
+}
+
+inline uint32_t validate_farm(const uint8_t* data) {
+    uint32_t out = 0;
+    if (layout::farm::end_time::read(data) < layout::farm::start_time::read(data)) {
+        out = out | Anomaly::TimeWindow;
+    }
+    if (pubkey_is_zero(layout::farm::pool::read(data)) ||
+        pubkey_is_zero(layout::farm::reward_mint::read(data))) {
+        out = out | Anomaly::PubkeyMismatch;
+    }
+    return out;
+}
+
+// Minimum buffer length for each account type
+inline size_t min_account_len(AccountType type) {
+    switch (type) {
+        case AccountType::Pool:         return layout::pool::SIZE;
+        case AccountType::NPool:        return layout::npool::SIZE;
+        case AccountType::Farm:         return layout::farm::SIZE;
+        case AccountType::UserFarm:     return layout::user_farm::SIZE;
+        case AccountType::Lottery:      return layout::lottery::SIZE;
+        case AccountType::LotteryEntry: return layout::lottery_entry::SIZE;
+        case AccountType::Registry:     return layout::registry::SIZE;
+        case AccountType::MLBrain:      return sizeof(MLBrain);
+        case AccountType::CLPool:       return sizeof(CLPool);
+        case AccountType::CLPosition:   return sizeof(CLPosition);
+        case AccountType::Orderbook:    return sizeof(Orderbook);
+        case AccountType::GovProposal:  return sizeof(GovProposal);
+        case AccountType::GovVote:      return sizeof(GovVote);
+        case AccountType::GlobalVPools:
+        case AccountType::VPoolClaim:
+        case AccountType::FarmState:
+        case AccountType::ProgramConfig:
+        case AccountType::AIFee:
+        case AccountType::TransferHookMeta:
+                                        return 8;  // Layout not defined yet: discriminator only
+        default:                        return 8;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Validate a single raw account.
+ * Returns the bitwise OR of Anomaly flags (0 if the account looks sane).
+ */
+inline uint32_t validate_account(const uint8_t* data, size_t len, AccountType* type_out = nullptr) {
+    AccountType type = detect_account_type(data, len);
+    if (type_out) *type_out = type;
+
+    if (type == AccountType::Unknown) {
+        return static_cast<uint32_t>(len < 8 ? Anomaly::Truncated : Anomaly::UnknownType);
+    }
+    if (len < detail::min_account_len(type)) return static_cast<uint32_t>(Anomaly::Truncated);
+
+    switch (type) {
+        case AccountType::Pool:  return detail::validate_pool(PoolView{data});
+        case AccountType::NPool: return detail::validate_npool(NPoolView{data});
+        case AccountType::Farm:  return detail::validate_farm(data);
+        default:                 return 0;
+    }
+}
+
+// ============================================================================
+// Bulk Validation
+// ============================================================================
+
+/**
+ * Validate every account in a snapshot.
+ *
+ * Work is handed out in fixed-size blocks from a shared counter so threads
+ * stay balanced when account sizes are mixed. Each thread collects its own
+ * issues; they are merged and sorted by index at the end.
+ *
+ * @param accounts Array of raw account buffers
+ * @param n Number of accounts
+ * @param threads Worker count (0 = hardware concurrency)
+ * @return Report listing every account with at least one anomaly
+ */
+inline ValidationReport validate_snapshot(const AccountData* accounts, size_t n, unsigned threads = 0) {
+    constexpr size_t BLOCK = 1024;
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (n + BLOCK - 1) / BLOCK;
+    if (threads > blocks) threads = static_cast<unsigned>(blocks > 0 ? blocks : 1);
+
+    std::vector<std::vector<ValidationIssue>> partial(threads);
+    std::atomic<size_t> next_block{0};
+
+    auto worker = [&](unsigned t) {
+        auto& out = partial[t];
+        for (;;) {
+            size_t b = next_block.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks) break;
+
+            size_t end = std::min(n, (b + 1) * BLOCK);
+            for (size_t i = b * BLOCK; i < end; i++) {
+                AccountType type;
+                uint32_t flags = validate_account(accounts[i].data, accounts[i].len, &type);
+                if (flags != 0) out.push_back({i, type, flags});
+            }
+        }
+    };
+
+    if (threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+    }
+
+    ValidationReport report;
+    report.accounts_checked = n;
+
+    size_t total = 0;
+    for (const auto& p : partial) total += p.size();
+    report.issues.reserve(total);
+    for (auto& p : partial) {
+        report.issues.insert(report.issues.end(), p.begin(), p.end());
+    }
+    std::sort(report.issues.begin(), report.issues.end(),
+              [](const ValidationIssue& a, const ValidationIssue& b) { return a.index < b.index; });
+
+    for (const auto& issue : report.issues) {
+        for (size_t bit = 0; bit < ANOMALY_CATEGORIES; bit++) {
+            if (issue.anomalies & (1u << bit)) report.counts[bit]++;
+        }
+    }
+
+    return report;
+}
+
+/**
+ * Validate a snapshot held as a vector of account buffers.
+ */
+inline ValidationReport validate_snapshot(const std::vector<AccountData>& accounts, unsigned threads = 0) {
+    return validate_snapshot(accounts.data(), accounts.size(), threads);
+}
+
+}  // namespace aex402
@@ -0,0 +1,451 @@
+#pragma once
+/**
+ * AeX402 AMM C++ SDK - Realized Volatility and Fee Recommendation
+ *
+ * Volatility estimators over the candle ring buffers stored in each Pool
+ * (24 hourly and 7 daily candles), and a fee model that turns volatility
+ * and volume into a suggested updfee value.
+ *
+ * Estimators (per-period sigma of log price, not annualized):
+ * - Close-to-close: sample standard deviation of ln(C_t / C_t-1) over
+ *   consecutive candles in the ring.
+ * - Parkinson: sqrt(sum ln(H/L)^2 / (4 ln 2 * n)). Uses the range, so it
+ *   needs no candle ordering and is ~5x as efficient as close-to-close.
+ * - Garman-Klass: sqrt(sum [0.5 ln(H/L)^2 - (2 ln 2 - 1) ln(C/O)^2] / n).
+ * Candles with a zero open or a non-positive low/close are skipped.
+ *
+ * Batching: estimate_batch() decodes 32 pools at a time into candle-major
+ * float arrays, so the log and accumulation loops run across pools with a
+ * fixed trip count and vectorize. ln(1 + x) uses a branch-free polynomial
+ * on the float's exponent and mantissa (libm's log does not vectorize
+ * without -ffast-math); relative error is below 1e-6.
+ *
+ * Fee model: LPs lose about lvr_scale * sigma^2 of pool value per period
+ * to arbitrage (loss-versus-rebalancing; 1/8 for a constant-product
+ * curve), so the fee that breaks even against it is
+ *     fee = lvr_scale * sigma^2 * tvl / volume
+ * with volume and sigma over the same period. The result is clamped to
+ * the model bounds and only reported as a change when it moves by at
+ * least deadband_bps, so callers do not churn updfee transactions.
+ *
+ * Usage:
+ *   volatility::VolBatch vb;
+ *   volatility::estimate_batch(accounts.data(), accounts.size(), volatility::Window::Hours, vb);
+ *   std::vector<volatility::FeeRecommendation> recs;
+ *   volatility::recommend_fees(vb, model, recs);
+ *   for (size_t i = 0; i < recs.size(); i++) {
+ *       if (recs[i].change) send(InstructionBuilder::updfee(recs[i].fee_bps));
+ *   }
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "types.hpp"
+#include "constants.hpp"
+#include "accounts.hpp"
+
+namespace aex402 {
+namespace volatility {
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * Which candle ring buffer to read.
+ */
+enum class Window : uint8_t {
+    Hours,  // 24 hourly candles
+    Days,   // 7 daily candles
+};
+
+enum class Estimator : uint8_t {
+    CloseToClose,
+    Parkinson,
+    GarmanKlass,
+};
+
+/**
+ * Per-period volatility of one pool.
+ */
+struct VolEstimate {
+    double close_to_close = 0;
+    double parkinson = 0;
+    double garman_klass = 0;
+    uint32_t samples = 0;       // Candles used
+    double volume = 0;          // Average volume per candle (token units)
+
+    double sigma(Estimator e) const {
+        switch (e) {
+            case Estimator::CloseToClose: return close_to_close;
+            case Estimator::Parkinson:    return parkinson;
+            default:                      return garman_klass;
+        }
+    }
+};
+
+/**
+ * Column-wise estimates for a batch of accounts, indexed like the input.
+ * Rows for accounts that are not Pools have samples == 0.
+ */
+struct VolBatch {
+    std::vector<float> close_to_close;
+    std::vector<float> parkinson;
+    std::vector<float> garman_klass;
+    std::vector<uint32_t> samples;
+    std::vector<float> volume;      // Average volume per candle
+    std::vector<float> tvl;         // bal0 + bal1
+    std::vector<uint64_t> fee_bps;  // Current pool fee
+
+    size_t size() const { return samples.size(); }
+
+    void resize(size_t n) {
+        close_to_close.resize(n);
+        parkinson.resize(n);
+        garman_klass.resize(n);
+        samples.resize(n);
+        volume.resize(n);
+        tvl.resize(n);
+        fee_bps.resize(n);
+    }
+
+    const std::vector<float>& sigma(Estimator e) const {
+        switch (e) {
+            case Estimator::CloseToClose: return close_to_close;
+            case Estimator::Parkinson:    return parkinson;
+            default:                      return garman_klass;
+        }
+    }
+
+    VolEstimate at(size_t i) const {
+        return VolEstimate{close_to_close[i], parkinson[i], garman_klass[i], samples[i], volume[i]};
+    }
+};
+
+/**
+ * Scale a per-period sigma to one year.
+ */
+inline double annualize(double sigma, Window w) {
+    return sigma * std::sqrt(w == Window::Hours ? 24.0 * 365.0 : 365.0);
+}
+
+// ============================================================================
+// Estimation Kernel
+// ============================================================================
+
+namespace detail {
+
+constexpr size_t LANES = 32;
+constexpr size_t MAX_CANDLES = OHLCV_24H;
+constexpr float LN2 = 0.693147180559945f;
+
+/**
+ * ln(1 + x) for x > -1, branch-free so loops over it vectorize.
+ * Cephes logf polynomial on the mantissa in [sqrt(1/2), sqrt(2)), plus
+ * the usual correction for the rounding of 1 + x. The range reduction is
+ * done on the integer bits: with -ftrapping-math GCC will not if-convert
+ * a select between float products.
+ */
+inline float log1p_fast(float x) {
+    // The tiny bias only matters if 1 + x rounds to 0 (a ~100% drop)
+    const float u = (1.0f + x) + 1e-30f;
+
+    uint32_t bits;
+    std::memcpy(&bits, &u, 4);
+    const uint32_t mant = bits & 0x007fffffu;
+    const uint32_t hi = mant > 0x3504f3u ? 1u : 0u;  // mantissa > sqrt(2)
+    const int32_t e = static_cast<int32_t>(bits >> 23) - 127 + static_cast<int32_t>(hi);
+    bits = mant | (0x3f800000u - (hi << 23));
+    float m;
+    std::memcpy(&m, &bits, 4);
+
+    const float f = m - 1.0f;
+    const float z = f * f;
+    float p = 7.0376836292e-2f;
+    p = p * f - 1.1514610310e-1f;
+    p = p * f + 1.1676998740e-1f;
+    p = p * f - 1.2420140846e-1f;
+    p = p * f + 1.4249322787e-1f;
+    p = p * f - 1.6668057665e-1f;
+    p = p * f + 2.0000714765e-1f;
+    p = p * f - 2.4999993993e-1f;
+    p = p * f + 3.3333331174e-1f;
+    const float fe = static_cast<float>(e);
+    const float r = f + (f * z * p - 0.5f * z) + fe * -2.12194440e-4f + fe * 0.693359375f;
+
+    // (u - 1) - x is the rounding of 1 + x; dividing it by u as well
+    // would move the result by less than an ulp
+    return r - ((u - 1.0f) - x);
+}
+
+struct Lanes {
+    // Candle-major: [candle][lane]. Invalid entries hold 0 / 1 so the
+    // logs come out as 0.
+    float hl_num[MAX_CANDLES][LANES];  // H - L
+    float hl_den[MAX_CANDLES][LANES];  // L
+    float co_num[MAX_CANDLES][LANES];  // C - O
+    float co_den[MAX_CANDLES][LANES];  // O
+    float cc_num[MAX_CANDLES][LANES];  // C_t - C_t-1
+    float cc_den[MAX_CANDLES][LANES];  // C_t-1
+    float valid[MAX_CANDLES][LANES];
+    float pair[MAX_CANDLES][LANES];
+};
+
+// Decode one pool's ring (oldest first) into lane p
+inline void load_lane(Lanes& ln, size_t p, const uint8_t* pool, Window w, size_t k_count,
+                      double& volume, float& tvl, uint64_t& fee_bps) {
+    uint64_t vol_sum = 0;
+    if (!pool) {
+        for (size_t k = 0; k < k_count; k++) {
+            ln.hl_num[k][p] = ln.co_num[k][p] = ln.cc_num[k][p] = 0.0f;
+            ln.hl_den[k][p] = ln.co_den[k][p] = ln.cc_den[k][p] = 1.0f;
+            ln.valid[k][p] = ln.pair[k][p] = 0.0f;
+        }
+        volume = 0;
+        tvl = 0;
+        fee_bps = 0;
+        return;
+    }
+
+    // Oldest candle sits just after the newest in the ring
+    const size_t newest = w == Window::Hours ? layout::pool::hour_idx::read(pool) : layout::pool::day_idx::read(pool);
+    size_t idx = newest + 1 < k_count ? newest + 1 : 0;
+    int64_t prev_close = 0;
+    for (size_t k = 0; k < k_count; k++, idx = idx + 1 < k_count ? idx + 1 : 0) {
+        const Candle c = w == Window::Hours ? layout::pool::hours::read_at(pool, idx)
+                                            : layout::pool::days::read_at(pool, idx);
+        const int64_t open = c.open;
+        const int64_t low = open - c.low_d;
+        const int64_t close = open + c.close_d;
+        const bool ok = open > 0 && low > 0 && close > 0;
+        const bool pair_ok = ok && prev_close > 0;
+
+        ln.hl_num[k][p] = ok ? static_cast<float>(c.high_d + c.low_d) : 0.0f;
+        ln.hl_den[k][p] = ok ? static_cast<float>(low) : 1.0f;
+        ln.co_num[k][p] = ok ? static_cast<float>(c.close_d) : 0.0f;
+        ln.co_den[k][p] = ok ? static_cast<float>(open) : 1.0f;
+        ln.cc_num[k][p] = pair_ok ? static_cast<float>(close - prev_close) : 0.0f;
+        ln.cc_den[k][p] = pair_ok ? static_cast<float>(prev_close) : 1.0f;
+        ln.valid[k][p] = ok ? 1.0f : 0.0f;
+        ln.pair[k][p] = pair_ok ? 1.0f : 0.0f;
+
+        vol_sum += ok ? c.volume : 0u;
+        prev_close = ok ? close : 0;
+    }
+
+    volume = static_cast<double>(vol_sum) * 1e9;
+    tvl = static_cast<float>(static_cast<double>(layout::pool::bal0::read(pool)) +
+                             static_cast<double>(layout::pool::bal1::read(pool)));
+    fee_bps = layout::pool::fee_bps::read(pool);
+}
+
+/**
+ * Estimate up to LANES pools (nullptr = not a pool) into rows
+ * [base, base + count) of out.
+ */
+inline void estimate_block(const uint8_t* const* pools, size_t count, Window w, VolBatch& out, size_t base) {
+    const size_t k_count = w == Window::Hours ? OHLCV_24H : OHLCV_7D;
+    Lanes ln;
+    double volume[LANES];
+
+    for (size_t p = 0; p < LANES; p++) {
+        float tvl = 0;
+        uint64_t fee = 0;
+        load_lane(ln, p, p < count ? pools[p] : nullptr, w, k_count, volume[p], tvl, fee);
+        if (p < count) {
+            out.tvl[base + p] = tvl;
+            out.fee_bps[base + p] = fee;
+        }
+    }
+
+    float n[LANES] = {}, np[LANES] = {};
+    float s_hl2[LANES] = {}, s_co2[LANES] = {}, s_cc[LANES] = {}, s_cc2[LANES] = {};
+
+    for (size_t k = 0; k < k_count; k++) {
+        for (size_t p = 0; p < LANES; p++) {
+            const float x = log1p_fast(ln.hl_num[k][p] / ln.hl_den[k][p]);
+            const float y = log1p_fast(ln.co_num[k][p] / ln.co_den[k][p]);
+            const float z = log1p_fast(ln.cc_num[k][p] / ln.cc_den[k][p]);
+            n[p] += ln.valid[k][p];
+            np[p] += ln.pair[k][p];
+            s_hl2[p] += x * x;
+            s_co2[p] += y * y;
+            s_cc[p] += z;
+            s_cc2[p] += z * z;
+        }
+    }
+
+    float cc[LANES], pk[LANES], gk[LANES];
+    constexpr float GK_CO = 2.0f * LN2 - 1.0f;
+    for (size_t p = 0; p < LANES; p++) {
+        // Empty lanes have all sums zero, so dividing by max(count, 1) is safe
+        const float inv_n = 1.0f / (n[p] > 1.0f ? n[p] : 1.0f);
+        const float inv_np = 1.0f / (np[p] > 1.0f ? np[p] : 1.0f);
+        const float inv_dof = 1.0f / (np[p] > 2.0f ? np[p] - 1.0f : 1.0f);
+        const float var_cc = (s_cc2[p] - s_cc[p] * s_cc[p] * inv_np) * inv_dof;
+        const float var_gk = (0.5f * s_hl2[p] - GK_CO * s_co2[p]) * inv_n;
+        cc[p] = np[p] > 1.0f && var_cc > 0.0f ? std::sqrt(var_cc) : 0.0f;
+        pk[p] = std::sqrt(s_hl2[p] * inv_n * (0.25f / LN2));
+        gk[p] = var_gk > 0.0f ? std::sqrt(var_gk) : 0.0f;
+    }
+
+    for (size_t p = 0; p < count; p++) {
+        out.close_to_close[base + p] = cc[p];
+        out.parkinson[base + p] = pk[p];
+        out.garman_klass[base + p] = gk[p];
+        out.samples[base + p] = static_cast<uint32_t>(n[p]);
+        out.volume[base + p] = n[p] > 0.0f ? static_cast<float>(volume[p] / static_cast<double>(n[p])) : 0.0f;
+    }
+}
+
+}  // namespace detail
+
+// ============================================================================
+// Estimation
+// ============================================================================
+
+/**
+ * Estimate volatility for every Pool in a bulk load.
+ *
+ * Estimates depend only on each account's bytes, so a per-slot job only
+ * needs to pass the accounts that changed since the last run. Large loads
+ * are split across threads in fixed-size blocks; rows are disjoint, so
+ * threads write straight into out.
+ *
+ * @param accounts Array of raw account buffers
+ * @param n Number of accounts
+ * @param out Resized to n; rows for other account types have samples == 0
+ * @param threads Worker count (0 = hardware concurrency)
+ */
+inline void estimate_batch(const AccountData* accounts, size_t n, Window w, VolBatch& out, unsigned threads = 1) {
+    constexpr size_t BLOCK = 1024;
+    static_assert(BLOCK % detail::LANES == 0, "blocks must hold whole lane groups");
+
+    out.resize(n);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (n + BLOCK - 1) / BLOCK;
+    if (threads > blocks) threads = static_cast<unsigned>(blocks > 0 ? blocks : 1);
+
+    std::atomic<size_t> next_block{0};
+    auto worker = [&]() {
+        const uint8_t* pools[detail::LANES];
+        for (;;) {
+            size_t b = next_block.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks) break;
+
+            size_t end = std::min(n, (b + 1) * BLOCK);
+            for (size_t base = b * BLOCK; base < end; base += detail::LANES) {
+                const size_t count = std::min(end - base, detail::LANES);
+                for (size_t p = 0; p < count; p++) {
+                    const AccountData& a = accounts[base + p];
+                    pools[p] = view_pool(a.data, a.len) ? a.data : nullptr;
+                }
+                detail::estimate_block(pools, count, w, out, base);
+            }
+        }
+    };
+
+    if (threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+    }
+}
+
+inline void estimate_batch(const std::vector<AccountData>& accounts, Window w, VolBatch& out, unsigned threads = 1) {
+    estimate_batch(accounts.data(), accounts.size(), w, out, threads);
+}
+
+/**
+ * Estimate volatility for a single pool.
+ */
+inline VolEstimate estimate(const PoolView& pool, Window w) {
+    VolBatch out;
+    out.resize(1);
+    const uint8_t* data = pool.data;
+    detail::estimate_block(&data, 1, w, out, 0);
+    return out.at(0);
+}
+
+inline VolEstimate estimate(const Pool& pool, Window w) {
+    return estimate(PoolView{reinterpret_cast<const uint8_t*>(&pool)}, w);
+}
+
+// ============================================================================
+// Fee Recommendation
+// ============================================================================
+
+/**
+ * Bounds and coefficients for the fee model.
+ */
+struct FeeModel {
+    Estimator estimator = Estimator::GarmanKlass;
+    double lvr_scale = 0.125;       // LVR per sigma^2 of pool value (1/8: constant product)
+    uint64_t min_fee_bps = 1;
+    uint64_t max_fee_bps = 100;
+    uint64_t deadband_bps = 2;      // Smallest change worth an updfee
+    uint32_t min_samples = 4;       // Candles needed before recommending
+};
+
+struct FeeRecommendation {
+    uint64_t fee_bps;   // Suggested fee (the current fee when change is false)
+    bool change;        // Worth submitting as updfee
+};
+
+/**
+ * Map per-period volatility and volume to a fee.
+ *
+ * @param sigma   Per-period volatility
+ * @param volume  Volume per period (same units as tvl)
+ * @param tvl     Pool value in token units
+ * @param current_fee_bps Fee the pool charges now
+ */
+inline FeeRecommendation recommend_fee(double sigma, double volume, double tvl, uint64_t current_fee_bps,
+                                       const FeeModel& model) {
+    if (!(volume > 0.0) || !(tvl > 0.0) || !(sigma >= 0.0)) return {current_fee_bps, false};
+
+    const double lo = static_cast<double>(model.min_fee_bps);
+    const double hi = static_cast<double>(model.max_fee_bps);
+    double bps = model.lvr_scale * sigma * sigma * tvl / volume * 10000.0;
+    bps = bps < lo ? lo : (bps > hi ? hi : bps);
+
+    const uint64_t fee = static_cast<uint64_t>(std::llround(bps));
+    const uint64_t diff = fee > current_fee_bps ? fee - current_fee_bps : current_fee_bps - fee;
+    const bool out_of_bounds = current_fee_bps < model.min_fee_bps || current_fee_bps > model.max_fee_bps;
+    if (diff == 0 || (diff < model.deadband_bps && !out_of_bounds)) return {current_fee_bps, false};
+    return {fee, true};
+}
+
+inline FeeRecommendation recommend_fee(const VolEstimate& est, double tvl, uint64_t current_fee_bps,
+                                       const FeeModel& model) {
+    if (est.samples < model.min_samples) return {current_fee_bps, false};
+    return recommend_fee(est.sigma(model.estimator), est.volume, tvl, current_fee_bps, model);
+}
+
+/**
+ * Recommend a fee for every row of a batch. out is indexed like the batch;
+ * rows without enough candles keep their current fee.
+ */
+inline void recommend_fees(const VolBatch& batch, const FeeModel& model, std::vector<FeeRecommendation>& out) {
+    const size_t n = batch.size();
+    const std::vector<float>& sigma = batch.sigma(model.estimator);
+    out.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = batch.samples[i] < model.min_samples
+                     ? FeeRecommendation{batch.fee_bps[i], false}
+                     : recommend_fee(sigma[i], batch.volume[i], batch.tvl[i], batch.fee_bps[i], model);
+    }
+}
+
+}  // namespace volatility
+}  // namespace aex402